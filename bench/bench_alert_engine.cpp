@@ -0,0 +1,132 @@
+#include "AlertEngine.h"
+#include "TestSupport.h"
+
+// Per-tick cost with 100,000 active alerts, against a scan that checks
+// every alert of the ticking symbol. Once spread over 100 symbols (1,000
+// alerts each) and once all on one symbol. Most alerts are cross alerts,
+// which re-arm after firing; alerts that retire are replaced, so the
+// active count holds at 100k throughout.
+
+namespace {
+
+constexpr int ActiveAlerts = 100000;
+constexpr int ScanTicks = 2000;   // the scan is timed over the first ticks only
+
+struct Scan {
+    AlertEngine::Kind kind;
+    double level;
+    double reference;
+};
+
+AlertEngine::Kind kindFor(std::mt19937 &rng)
+{
+    const int roll = static_cast<int>(rng() % 10);
+    if (roll < 4)
+        return AlertEngine::Kind::CrossAbove;
+    if (roll < 8)
+        return AlertEngine::Kind::CrossBelow;
+    if (roll == 8)
+        return rng() % 2 ? AlertEngine::Kind::Above : AlertEngine::Kind::Below;
+    return AlertEngine::Kind::PercentMove;
+}
+
+double levelFor(AlertEngine::Kind kind, double price, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> spread(0.8, 1.2);
+    if (kind == AlertEngine::Kind::PercentMove)
+        return 5.0 + rng() % 10;
+    if (kind == AlertEngine::Kind::Above)
+        return price * (1.0 + (spread(rng) - 0.8));
+    if (kind == AlertEngine::Kind::Below)
+        return price * (1.0 - (spread(rng) - 0.8));
+    return price * spread(rng);
+}
+
+void run(quint32 firstSymbol, int symbols, int ticks)
+{
+    AlertEngine &engine = AlertEngine::instance();
+    const int alreadyActive = engine.activeCount();
+    std::mt19937 rng(21 + firstSymbol);
+    std::normal_distribution<double> move(0.0, 0.002);
+
+    QVector<double> price(symbols, 1000.0);
+    QVector<QVector<Scan>> scans(symbols);
+    for (int s = 0; s < symbols; ++s) {
+        Quote quote;
+        quote.symbolId = firstSymbol + s;
+        quote.price = price[s];
+        engine.evaluate(quote);
+    }
+    for (int i = 0; i < ActiveAlerts; ++i) {
+        const int s = i % symbols;
+        const AlertEngine::Kind kind = kindFor(rng);
+        const double level = levelFor(kind, price[s], rng);
+        engine.add(firstSymbol + s, kind, level);
+        scans[s].append(Scan{kind, level, price[s]});
+    }
+    while (engine.hasFired())
+        engine.takeFired();
+
+    QVector<Quote> stream(ticks);
+    for (Quote &quote : stream) {
+        const int s = static_cast<int>(rng() % symbols);
+        price[s] *= std::exp(move(rng));
+        quote.symbolId = firstSymbol + s;
+        quote.price = price[s];
+    }
+
+    // Retired alerts are replaced as they go, keeping the active count level
+    qint64 fired = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (const Quote &quote : stream) {
+        const int count = engine.evaluate(quote);
+        fired += count;
+        while (engine.hasFired()) {
+            const AlertEngine::Fired hit = engine.takeFired();
+            if (hit.kind != AlertEngine::Kind::CrossAbove && hit.kind != AlertEngine::Kind::CrossBelow)
+                engine.add(quote.symbolId, hit.kind, levelFor(hit.kind, quote.price, rng));
+        }
+    }
+    const qint64 engineNs = timer.nsecsElapsed();
+    const int active = engine.activeCount() - alreadyActive;
+
+    // Baseline: every alert of the symbol checked on every tick
+    QVector<double> previous(symbols, 1000.0);
+    qint64 scanned = 0;
+    timer.start();
+    for (int t = 0; t < ScanTicks; ++t) {
+        const Quote &quote = stream[t];
+        const int s = static_cast<int>(quote.symbolId - firstSymbol);
+        const double was = previous[s];
+        const double now = quote.price;
+        for (const Scan &scan : scans[s]) {
+            switch (scan.kind) {
+            case AlertEngine::Kind::Above: scanned += now >= scan.level; break;
+            case AlertEngine::Kind::Below: scanned += now <= scan.level; break;
+            case AlertEngine::Kind::CrossAbove: scanned += was < scan.level && now >= scan.level; break;
+            case AlertEngine::Kind::CrossBelow: scanned += was > scan.level && now <= scan.level; break;
+            case AlertEngine::Kind::PercentMove:
+                scanned += std::abs(now - scan.reference) >= scan.reference * scan.level / 100.0;
+                break;
+            }
+        }
+        previous[s] = now;
+    }
+    const qint64 scanNs = timer.nsecsElapsed();
+
+    qDebug() << "🔔" << active << "active alerts on" << symbols << "symbols," << ticks << "ticks,"
+             << static_cast<double>(fired) / ticks << "fired per tick";
+    qDebug() << "   heaps:" << static_cast<double>(engineNs) / ticks << "ns per tick | scan:"
+             << static_cast<double>(scanNs) / ScanTicks << "ns per tick (" << scanned << "hits )";
+}
+
+} // namespace
+
+int main()
+{
+    run(0, 100, 200000);
+    // About fifty levels sit within one tick's move here, so firing dominates
+    run(1000, 1, 20000);
+    return 0;
+}
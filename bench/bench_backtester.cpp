@@ -0,0 +1,50 @@
+#include "Backtester.h"
+#include "TestSupport.h"
+#include <QThread>
+#include <QThreadPool>
+
+// Backtester::sweep() over synthetic daily histories with the default
+// parameter grid, from one thread up to every core, reported as bar
+// evaluations (bars x grid points) per second. A single run() gives the
+// per-thread inner-loop rate.
+
+int main()
+{
+    constexpr int Symbols = 200;
+    constexpr int Bars = 1000;   // about four years of daily closes
+
+    QVector<Backtester::History> histories;
+    histories.reserve(Symbols);
+    for (int i = 0; i < Symbols; ++i) {
+        Backtester::History history;
+        history.symbolId = static_cast<quint32>(i);
+        history.closes = TestSupport::randomWalk(i + 1, Bars, 1000.0, 0.015);
+        histories.append(history);
+    }
+    const Backtester::Grid grid = Backtester::defaultGrid();
+    const Backtester::Costs costs;
+    const double evaluations = static_cast<double>(Symbols) * Bars * grid.size();
+
+    SmaRsiStrategy strategy;
+    const PriceSpan closes{histories.first().closes.constData(), Bars};
+    volatile double sink = 0.0;
+    const qint64 runNs = TestSupport::bestOf(20, [&]() {
+        sink = sink + Backtester::run(closes, strategy, strategy.indicatorConfig(), costs).totalReturn;
+    });
+    qDebug() << "🧪 Single run:" << Bars << "bars in" << runNs / 1000.0 << "µs |" << Bars * 1e3 / runNs
+             << "M bar evaluations/s";
+
+    const int cores = qMax(1, QThread::idealThreadCount());
+    QThreadPool *pool = QThreadPool::globalInstance();
+    qDebug() << "🧪 Sweep:" << Symbols << "symbols x" << Bars << "bars x" << grid.size() << "grid points";
+    for (int threads = 1; threads <= cores; threads = threads < cores ? qMin(threads * 2, cores) : cores + 1) {
+        pool->setMaxThreadCount(threads);
+        const qint64 ns = TestSupport::bestOf(3, [&]() {
+            sink = sink + Backtester::sweep(histories, grid, costs).size();
+        });
+        qDebug() << "  " << threads << "threads:" << ns / 1e6 << "ms |" << evaluations * 1e3 / ns
+                 << "M bar evaluations/s";
+    }
+    pool->setMaxThreadCount(cores);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "CorrelationEngine.h"
+#include "TestSupport.h"
+#include <QCoreApplication>
+#include <QEventLoop>
+
+// The interactive target: 500 symbols x 250-bar windows. Times a full
+// tiled rebuild, one live quote's incremental update and a mostSimilar()
+// read on the adopted matrix.
+
+namespace {
+
+constexpr int Symbols = 500;
+constexpr int Bars = 251;   // 250 returns
+constexpr qint64 DayNs = 86400LL * 1000000000LL;
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    QVector<CorrelationEngine::Input> inputs;
+    for (int i = 0; i < Symbols; ++i) {
+        CorrelationEngine::Input input;
+        input.symbolId = static_cast<quint32>(i + 1);
+        input.closes = TestSupport::randomWalk(19 + i, Bars, 1000.0, 0.015);
+        for (int t = 0; t < Bars; ++t)
+            input.timestampNs.append((20000 + t) * DayNs);
+        inputs.append(input);
+    }
+
+    const qint64 buildNs = TestSupport::bestOf(5, [&]() { CorrelationEngine::compute(inputs); });
+
+    // Adopt one build so the live paths have a matrix to work on
+    CorrelationEngine *engine = CorrelationEngine::instance();
+    QEventLoop loop;
+    QObject::connect(engine, &CorrelationEngine::matrixReady, &loop, &QEventLoop::quit);
+    engine->rebuild(inputs);
+    if (engine->size() == 0)
+        loop.exec();
+
+    std::mt19937 rng(19);
+    std::normal_distribution<double> move(0.0, 0.002);
+    constexpr int Ticks = 100000;
+    QVector<Quote> ticks(Ticks);
+    for (Quote &quote : ticks) {
+        const int i = static_cast<int>(rng() % Symbols);
+        quote.symbolId = inputs[i].symbolId;
+        quote.price = inputs[i].closes.last() * std::exp(move(rng));
+    }
+    QElapsedTimer timer;
+    timer.start();
+    for (const Quote &quote : ticks)
+        engine->update(quote);
+    const qint64 updateNs = timer.nsecsElapsed();
+
+    volatile double sink = 0.0;
+    const qint64 similarNs = TestSupport::bestOf(1000, [&]() {
+        sink = sink + engine->mostSimilar(inputs[static_cast<int>(rng() % Symbols)].symbolId, 5).first().correlation;
+    });
+
+    qDebug() << "🔗" << engine->size() << "symbols x" << engine->window() << "returns";
+    qDebug() << "   full tiled rebuild:" << buildNs / 1e6 << "ms | update per tick:"
+             << static_cast<double>(updateNs) / Ticks / 1000.0 << "µs | mostSimilar(5):" << similarNs / 1000.0 << "µs";
+    return 0;
+}
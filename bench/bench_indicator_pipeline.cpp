@@ -0,0 +1,54 @@
+#include "IndicatorPipeline.h"
+#include "TestSupport.h"
+
+// SMA 20, EMA 12, RSI 14 and Bollinger 20 over 1,000 series of 2,500
+// closes: one fused pass against four separate passes, each with the
+// windows fixed at compile time and as runtime ints.
+
+namespace {
+
+constexpr int Series = 1000;
+constexpr int Bars = 2500;
+
+template <typename Fn>
+void report(const char *label, const QVector<QVector<double>> &series, Fn &&pass)
+{
+    volatile double sink = 0.0;
+    const qint64 ns = TestSupport::bestOf(5, [&]() {
+        double sum = 0.0;
+        for (const QVector<double> &closes : series)
+            sum += pass(closes.constData(), closes.size());
+        sink = sink + sum;
+    });
+    qDebug() << "  " << label << static_cast<double>(ns) / (static_cast<double>(Series) * Bars) << "ns per bar";
+}
+
+} // namespace
+
+int main()
+{
+    using namespace IndicatorPipeline;
+
+    QVector<QVector<double>> series;
+    for (int i = 0; i < Series; ++i)
+        series.append(TestSupport::randomWalk(23 + i, Bars));
+
+    qDebug() << "📈" << Series << "series x" << Bars << "bars, SMA 20 + EMA 12 + RSI 14 + Bollinger 20";
+    report("fused, compile-time windows:   ", series, [](const double *closes, int n) {
+        const State s = fused(closes, n, FixedWindows<20, 12, 14, 20>());
+        return s.smaSum + s.ema + s.avgGain + s.bollingerM2;
+    });
+    report("fused, runtime windows:        ", series, [](const double *closes, int n) {
+        const State s = fused(closes, n, RuntimeWindows{{20}, {12}, {14}, {20}});
+        return s.smaSum + s.ema + s.avgGain + s.bollingerM2;
+    });
+    report("separate, compile-time windows:", series, [](const double *closes, int n) {
+        return sma(closes, n, Window<20>()) + ema(closes, n, Window<12>()) + rsi(closes, n, Window<14>())
+               + bollinger(closes, n, Window<20>()).stdDev;
+    });
+    report("separate, runtime windows:     ", series, [](const double *closes, int n) {
+        return sma(closes, n, DynamicWindow{20}) + ema(closes, n, DynamicWindow{12}) + rsi(closes, n, DynamicWindow{14})
+               + bollinger(closes, n, DynamicWindow{20}).stdDev;
+    });
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "IndicatorSync.h"
+#include "TestSupport.h"
+
+// Cold indicator sync (first sight of a series, or a reload) over 1k, 10k
+// and 50k closes, with the range spanning the whole series as on the
+// chart: load() against the same steps run as separate passes (indicators,
+// range, pivots, trend line), and against replaying push() bar by bar.
+
+namespace {
+
+double consume(const IndicatorEngine &engine, const RollingExtrema &range, const PivotDetector &pivots,
+               const StreamingRegression &trend)
+{
+    return engine.rsi() + range.max() + pivots.support().size() + trend.fit().slope;
+}
+
+double consume(const IndicatorSync &sync)
+{
+    return consume(sync.engine(), sync.range(), sync.pivots(), sync.trend());
+}
+
+} // namespace
+
+int main()
+{
+    volatile double sink = 0.0;
+
+    for (int bars : {1000, 10000, 50000}) {
+        const QVector<double> closes = TestSupport::randomWalk(29, bars);
+        const PriceSpan prices{closes.constData(), closes.size()};
+        IndicatorSync::Config config;
+        config.rangeWindow = bars;
+        const int runs = bars >= 50000 ? 10 : 50;
+
+        IndicatorSync fused(config);
+        const qint64 fusedNs = TestSupport::bestOf(runs, [&]() {
+            fused.load(prices);
+            sink = sink + consume(fused);
+        });
+
+        RollingExtrema range(config.rangeWindow);
+        PivotDetector pivots(config.pivotStrength, config.pivotLevels);
+        StreamingRegression trend(config.trendWindow);
+        const qint64 separateNs = TestSupport::bestOf(runs, [&]() {
+            const IndicatorEngine engine = IndicatorEngine::compute(prices, config.indicators);
+            range.assign(closes.constData(), bars);
+            pivots.reset();
+            for (int i = pivots.replayStart(closes.constData(), bars); i < bars; ++i)
+                pivots.push(closes[i]);
+            trend.reset();
+            for (int i = qMax(0, bars - trend.window()); i < bars; ++i)
+                trend.push(closes[i]);
+            sink = sink + consume(engine, range, pivots, trend);
+        });
+
+        const qint64 replayNs = TestSupport::bestOf(runs, [&]() {
+            IndicatorSync replayed(config);
+            for (double price : closes)
+                replayed.push(price);
+            sink = sink + consume(replayed);
+        });
+
+        qDebug() << "📈" << bars << "bars: fused load" << fusedNs / 1000.0 << "µs, separate passes"
+                 << separateNs / 1000.0 << "µs, push replay" << replayNs / 1000.0 << "µs";
+    }
+    return 0;
+}
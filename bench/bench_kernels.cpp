@@ -0,0 +1,123 @@
+#include "Kernels.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <cmath>
+
+// The kernels against the code they replaced, on 1k, 100k and 10M closes:
+// volatility (a returns vector, then two scalar passes), the least-squares
+// fit with its second pass for R², the y-range over a copied series and a
+// scalar EMA. Reported in ns per element.
+
+namespace
+{
+    double legacyVolatility(const QVector<double> &prices)
+    {
+        QVector<double> returns;
+        for (int i = 1; i < prices.size(); ++i)
+            returns.append((prices[i] - prices[i - 1]) / prices[i - 1]);
+
+        double sum = 0.0;
+        for (double r : returns) sum += r;
+        const double mean = sum / returns.size();
+        double variance = 0.0;
+        for (double r : returns) variance += (r - mean) * (r - mean);
+        return std::sqrt(variance / returns.size());
+    }
+
+    double legacyRSquared(const QVector<double> &y)
+    {
+        const int n = y.size();
+        double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+        for (int i = 0; i < n; ++i) {
+            sumX += i;
+            sumY += y[i];
+            sumXY += i * y[i];
+            sumXX += static_cast<double>(i) * i;
+        }
+        const double slope = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+        const double intercept = (sumY - slope * sumX) / n;
+        const double meanY = sumY / n;
+        double ssTotal = 0, ssRes = 0;
+        for (int i = 0; i < n; ++i) {
+            const double predicted = intercept + slope * i;
+            ssTotal += (y[i] - meanY) * (y[i] - meanY);
+            ssRes += (y[i] - predicted) * (y[i] - predicted);
+        }
+        return ssTotal > 0 ? 1.0 - ssRes / ssTotal : 0.0;
+    }
+
+    double legacyRange(const QVector<double> &prices, const QVector<double> &forecast)
+    {
+        const QVector<double> all = prices + forecast;
+        const auto range = std::minmax_element(all.begin(), all.end());
+        return *range.second - *range.first;
+    }
+
+    double legacyEma(const QVector<double> &prices, double alpha, QVector<double> &out)
+    {
+        double value = prices[0];
+        for (int i = 0; i < prices.size(); ++i) {
+            value = alpha * prices[i] + (1 - alpha) * value;
+            out[i] = value;
+        }
+        return value;
+    }
+
+    double kernelRSquared(const double *y, int n)
+    {
+        const Kernels::LinearSums sums = Kernels::linearSums(y, n);
+        const double sumX = n * (n - 1) / 2.0;
+        const double sumXX = (n - 1.0) * n * (2.0 * n - 1.0) / 6.0;
+        const double slope = (n * sums.sumXY - sumX * sums.sumY) / (n * sumXX - sumX * sumX);
+        const double ssTotal = sums.sumYY - sums.sumY * sums.sumY / n;
+        const double ssRes = ssTotal - slope * (sums.sumXY - sumX * sums.sumY / n);
+        return ssTotal > 0 ? 1.0 - ssRes / ssTotal : 0.0;
+    }
+
+    void report(const char *name, int n, qint64 legacyNs, qint64 kernelNs)
+    {
+        qDebug() << "  " << name << ": legacy" << static_cast<double>(legacyNs) / n << "ns/elem | kernel"
+                 << static_cast<double>(kernelNs) / n << "ns/elem |" << static_cast<double>(legacyNs) / kernelNs << "x";
+    }
+}
+
+int main()
+{
+    const QVector<double> forecast(7, 1500.0);
+    volatile double sink = 0.0;
+
+    for (int n : {1000, 100000, 10000000}) {
+        const QVector<double> prices = TestSupport::randomWalk(13, n);
+        QVector<double> out(n);
+        const int runs = n >= 10000000 ? 3 : 20;
+
+        const qint64 legacyVol = TestSupport::bestOf(runs, [&]() { sink = sink + legacyVolatility(prices); });
+        const qint64 legacyFit = TestSupport::bestOf(runs, [&]() { sink = sink + legacyRSquared(prices); });
+        const qint64 legacyMinMax = TestSupport::bestOf(runs, [&]() { sink = sink + legacyRange(prices, forecast); });
+        const qint64 legacyScan = TestSupport::bestOf(runs, [&]() { sink = sink + legacyEma(prices, 2.0 / 13, out); });
+
+        for (Kernels::Isa isa : {Kernels::Isa::Scalar, Kernels::Isa::Sse2, Kernels::Isa::Avx2}) {
+            if (isa > Kernels::bestIsa()) continue;
+            Kernels::setIsa(isa);
+            qDebug() << "🧮" << n << "closes," << Kernels::isaName(isa);
+
+            report("volatility", n, legacyVol, TestSupport::bestOf(runs, [&]() {
+                sink = sink + std::sqrt(Kernels::returnMoments(prices.constData(), n).variance);
+            }));
+            report("regression", n, legacyFit, TestSupport::bestOf(runs, [&]() {
+                sink = sink + kernelRSquared(prices.constData(), n);
+            }));
+            report("min/max   ", n, legacyMinMax, TestSupport::bestOf(runs, [&]() {
+                double low, high, forecastLow, forecastHigh;
+                Kernels::minMax(prices.constData(), n, &low, &high);
+                Kernels::minMax(forecast.constData(), forecast.size(), &forecastLow, &forecastHigh);
+                sink = sink + qMax(high, forecastHigh) - qMin(low, forecastLow);
+            }));
+            report("ema scan  ", n, legacyScan, TestSupport::bestOf(runs, [&]() {
+                Kernels::emaScan(prices.constData(), n, 2.0 / 13, prices[0], out.data());
+                sink = sink + out[n - 1];
+            }));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include "MonteCarloForecaster.h"
+#include "TestSupport.h"
+#include <QThread>
+#include <QThreadPool>
+
+// 100k GBM paths x 30 steps from one thread up to every core; the target
+// is under 50 ms on 8 cores, and the verdict is only printed on a machine
+// that has them.
+
+int main()
+{
+    const QVector<double> history = TestSupport::randomWalk(17, 250, 1000.0, 0.015);
+    const PriceSpan span{history.constData(), static_cast<int>(history.size())};
+    MonteCarloForecaster::Config config;   // 100k paths, 30 steps
+
+    const int cores = qMax(1, QThread::idealThreadCount());
+    QThreadPool *pool = QThreadPool::globalInstance();
+    qDebug() << "🎲 Monte Carlo:" << config.paths << "paths x" << config.steps << "steps, up to" << cores << "threads";
+
+    qint64 gbmOnEight = -1;
+    for (MonteCarloForecaster::Model model : {MonteCarloForecaster::Model::Gbm, MonteCarloForecaster::Model::Bootstrap}) {
+        config.model = model;
+        qint64 single = 0;
+        for (int threads = 1; threads <= cores; threads = threads < cores ? qMin(threads * 2, cores) : cores + 1) {
+            pool->setMaxThreadCount(threads);
+            const qint64 ns = TestSupport::bestOf(5, [&]() { MonteCarloForecaster::simulate(span, config); });
+            if (threads == 1) single = ns;
+            if (threads == 8 && model == MonteCarloForecaster::Model::Gbm) gbmOnEight = ns;
+            qDebug() << "  " << (model == MonteCarloForecaster::Model::Gbm ? "GBM      " : "bootstrap")
+                     << threads << "threads:" << ns / 1e6 << "ms |" << static_cast<double>(single) / ns << "x";
+        }
+    }
+    pool->setMaxThreadCount(cores);
+
+    if (gbmOnEight < 0)
+        qDebug() << "⚠️ Fewer than 8 cores: the 50 ms target is not checked on this machine";
+    else
+        qDebug() << (gbmOnEight < 50000000 ? "✅" : "❌") << "GBM on 8 threads:" << gbmOnEight / 1e6 << "ms against the 50 ms target";
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "PatternIndex.h"
+#include "TestSupport.h"
+#include "PatternBruteForce.h"
+
+// 10,000 series x 1,000 bars (10M windows): index build, then K = 5
+// searches for the newest window of a few series, each against the
+// PatternBruteForce scan, with the pruning counts per query.
+
+namespace {
+
+constexpr int Series = 10000;
+constexpr int Bars = 1000;
+constexpr int Queries = 3;
+constexpr int K = 5;
+
+} // namespace
+
+int main()
+{
+    QVector<PatternIndex::Input> inputs;
+    inputs.reserve(Series);
+    for (int i = 0; i < Series; ++i)
+        inputs.append(PatternIndex::Input{static_cast<quint32>(i), TestSupport::randomWalk(20 + i, Bars, 100.0 + i % 500)});
+
+    const PatternIndex::Config config;
+    QElapsedTimer timer;
+    timer.start();
+    const PatternIndex::Index index = PatternIndex::build(inputs, config);
+    const qint64 buildNs = timer.nsecsElapsed();
+    qDebug() << "🔍" << Series << "series x" << Bars << "bars:" << index.windows() << "windows in" << index.buckets()
+             << "buckets, built in" << buildNs / 1e6 << "ms";
+
+    for (int q = 0; q < Queries; ++q) {
+        const quint32 symbol = static_cast<quint32>(q * Series / Queries);
+        const PriceSpan query{inputs[symbol].closes.constData(), Bars};
+
+        PatternIndex::Stats stats;
+        QVector<PatternIndex::Match> found;
+        const qint64 indexNs = TestSupport::bestOf(3, [&]() { found = PatternIndex::search(index, query, K, symbol, &stats); });
+
+        QVector<PatternIndex::Match> expected;
+        timer.start();
+        expected = PatternBruteForce::search(inputs, query, K, symbol, config);
+        const qint64 bruteNs = timer.nsecsElapsed();
+
+        bool same = found.size() == expected.size();
+        for (int i = 0; same && i < found.size(); ++i)
+            same = found[i].symbolId == expected[i].symbolId && found[i].offset == expected[i].offset;
+
+        qDebug() << "   query" << symbol << ": index" << indexNs / 1e6 << "ms | brute force" << bruteNs / 1e6 << "ms |"
+                 << (same ? "same top" : "❌ different top") << K;
+        qDebug() << "     buckets visited" << stats.bucketsVisited << "| pruned by PAA" << stats.prunedByPaa
+                 << "| by LB_Keogh" << stats.prunedByKeogh << "| DTW computed" << stats.dtwComputed << "of" << stats.windows;
+    }
+    return 0;
+}
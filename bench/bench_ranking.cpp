@@ -0,0 +1,86 @@
+#include "RankingService.h"
+#include "TestSupport.h"
+#include <algorithm>
+
+// One simulated second of a 5,000-symbol universe at 10 ticks per symbol,
+// with the dashboard reading the top 5 of every list ten times. The
+// tournament trees are compared with re-sorting the universe on each read.
+
+int main()
+{
+    constexpr int Symbols = 5000;
+    constexpr int TicksPerSymbol = 10;
+    constexpr int Reads = 10;
+    constexpr int K = 5;
+
+    std::mt19937 rng(14);
+    std::normal_distribution<double> move(0.0, 1.5);
+    QVector<Quote> ticks;
+    ticks.reserve(Symbols * TicksPerSymbol);
+    for (int t = 0; t < TicksPerSymbol; ++t) {
+        for (int i = 0; i < Symbols; ++i) {
+            Quote quote;
+            quote.symbolId = static_cast<quint32>(rng() % Symbols);
+            quote.changePercent = move(rng);
+            quote.price = 1000.0 * (1.0 + quote.changePercent / 100.0);
+            quote.change = quote.price - 1000.0;
+            ticks.append(quote);
+        }
+    }
+
+    RankingService &ranking = RankingService::instance();
+    for (int i = 0; i < Symbols; ++i) {
+        ranking.updateDaily(static_cast<quint32>(i), 1000.0, 0.0, 0.0, 0.01 + (rng() % 1000) / 1e5);
+    }
+
+    volatile quint32 sink = 0;
+    const int readEvery = ticks.size() / Reads;
+    const qint64 treeNs = TestSupport::bestOf(5, [&]() {
+        for (int i = 0; i < ticks.size(); ++i) {
+            ranking.update(ticks[i]);
+            if (i % readEvery == 0) {
+                for (RankingService::Metric metric : {RankingService::Metric::Gainers, RankingService::Metric::Losers,
+                                                      RankingService::Metric::Volatile}) {
+                    sink = sink + ranking.top(metric, K).first().symbolId;
+                }
+            }
+        }
+    });
+    const qint64 treeReadNs = TestSupport::bestOf(50, [&]() {
+        for (RankingService::Metric metric : {RankingService::Metric::Gainers, RankingService::Metric::Losers,
+                                              RankingService::Metric::Volatile}) {
+            sink = sink + ranking.top(metric, K).first().symbolId;
+        }
+    });
+
+    // Baseline: a flat table, sorted by change% and by volatility on every read
+    QVector<RankingService::Entry> rows(Symbols);
+    auto sortRead = [&]() {
+        QVector<RankingService::Entry> sorted = rows;
+        std::sort(sorted.begin(), sorted.end(), [](const RankingService::Entry &a, const RankingService::Entry &b) {
+            return a.changePercent > b.changePercent;
+        });
+        sink = sink + sorted.first().symbolId + sorted.last().symbolId;
+        std::sort(sorted.begin(), sorted.end(), [](const RankingService::Entry &a, const RankingService::Entry &b) {
+            return a.volatility > b.volatility;
+        });
+        sink = sink + sorted.first().symbolId;
+    };
+    const qint64 sortNs = TestSupport::bestOf(5, [&]() {
+        for (int i = 0; i < ticks.size(); ++i) {
+            RankingService::Entry &row = rows[static_cast<int>(ticks[i].symbolId)];
+            row.symbolId = ticks[i].symbolId;
+            row.changePercent = ticks[i].changePercent;
+            if (i % readEvery == 0) sortRead();
+        }
+    });
+    const qint64 sortReadNs = TestSupport::bestOf(50, sortRead);
+
+    qDebug() << "🏆" << Symbols << "symbols x" << TicksPerSymbol << "ticks/s," << Reads << "reads/s of the top" << K;
+    qDebug() << "   tournament trees:" << treeNs / 1000 << "µs per simulated second |"
+             << static_cast<double>(treeNs - Reads * treeReadNs) / ticks.size() << "ns per tick |"
+             << treeReadNs / 1000.0 << "µs per read";
+    qDebug() << "   re-sort per read:" << sortNs / 1000 << "µs per simulated second |"
+             << sortReadNs / 1000.0 << "µs per read";
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "SeriesLod.h"
+#include "TestSupport.h"
+#include <algorithm>
+
+// The chart's repaint path from 1k to 10M ticks: follow the new tick,
+// take the visible range's extremes for the axis, decimate to 1,200 pixel
+// columns and map what is left to screen coordinates. Against mapping
+// every point, as the chart did before the pyramid. Rasterising is left
+// out; it scales with the points handed to QPainter.
+
+namespace {
+
+constexpr int Columns = 1200;
+constexpr int Frames = 200;
+
+struct Point {
+    double x;
+    double y;
+};
+
+} // namespace
+
+int main()
+{
+    qDebug() << "🖼️ Repaint path at" << Columns << "columns, one new tick per frame";
+    for (int n : {1000, 10000, 100000, 1000000, 10000000}) {
+        QVector<double> prices = TestSupport::randomWalk(25, n + Frames, 1500.0, 0.001);
+
+        TickStore::Series series;
+        series.generation = 1;
+        auto at = [&](int size) {
+            series.price = PriceSpan{prices.constData(), size};
+            series.appended = static_cast<quint64>(size);
+        };
+
+        SeriesLod lod;
+        at(n);
+        QElapsedTimer timer;
+        timer.start();
+        lod.sync(series);
+        const qint64 buildNs = timer.nsecsElapsed();
+
+        QVector<int> visible;
+        QVector<Point> points;
+        auto map = [&](const PriceSpan &values, int index, double low, double high) {
+            const double x = static_cast<double>(Columns) * index / (values.size() - 1);
+            const double y = 600.0 - (values[index] - low) / (high - low) * 600.0;
+            points.append(Point{x, y});
+        };
+
+        timer.start();
+        for (int frame = 1; frame <= Frames; ++frame) {
+            at(n + frame);
+            lod.sync(series);
+            const SeriesLod::Extremes range = lod.extremes(series.price, 0, series.size());
+            lod.decimate(series.price, 0, series.size(), Columns, &visible);
+            points.clear();
+            for (int i : visible)
+                map(series.price, i, range.min, range.max);
+        }
+        const qint64 lodNs = timer.nsecsElapsed() / Frames;
+        const int drawn = points.size();
+
+        // Baseline: scan for the extremes and map every point, on fewer frames at the top end
+        const int fullFrames = qMax(1, qMin(Frames, 20000000 / n));
+        timer.start();
+        for (int frame = 0; frame < fullFrames; ++frame) {
+            const PriceSpan values = series.price;
+            const auto bounds = std::minmax_element(values.begin(), values.end());
+            points.clear();
+            points.reserve(values.size());
+            for (int i = 0; i < values.size(); ++i)
+                map(values, i, *bounds.first, *bounds.second);
+        }
+        const qint64 fullNs = timer.nsecsElapsed() / fullFrames;
+
+        qDebug() << "  " << n << "ticks:" << lodNs / 1000.0 << "µs per frame," << drawn << "points drawn | every point:"
+                 << fullNs / 1000.0 << "µs | pyramid build" << buildNs / 1000000.0 << "ms," << lod.levels() << "levels";
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include "UniverseAnalytics.h"
+#include "TestSupport.h"
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+// One universe pass (the per-symbol analysis UniverseAnalytics maps over
+// the pool) on 1000 synthetic symbols, from one thread up to every core.
+
+int main()
+{
+    constexpr int Symbols = 1000;
+    constexpr int Bars = 250;   // about a year of daily closes
+
+    QVector<UniverseAnalytics::Input> inputs;
+    inputs.reserve(Symbols);
+    for (int i = 0; i < Symbols; ++i) {
+        inputs.append(UniverseAnalytics::Input{static_cast<quint32>(i), TestSupport::randomWalk(i + 1, Bars)});
+    }
+
+    const int cores = qMax(1, QThread::idealThreadCount());
+    qDebug() << "🧮 Universe pass:" << Symbols << "symbols x" << Bars << "bars, up to" << cores << "threads";
+
+    qint64 single = 0;
+    for (int threads = 1; threads <= cores; threads = threads < cores ? qMin(threads * 2, cores) : cores + 1) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+        const qint64 ns = TestSupport::bestOf(5, [&]() {
+            const QVector<UniverseAnalytics::SymbolAnalytics> rows =
+                QtConcurrent::blockingMapped<QVector<UniverseAnalytics::SymbolAnalytics>>(
+                    &pool, inputs, &UniverseAnalytics::analyze);
+            if (rows.size() != Symbols) qWarning() << "❌ lost rows:" << rows.size();
+        });
+        if (threads == 1) single = ns;
+        qDebug() << "  " << threads << "threads:" << ns / 1000 << "µs |"
+                 << static_cast<double>(single) / ns << "x of one thread";
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#ifndef ALERTENGINE_H
+#define ALERTENGINE_H
+
+#include <QVector>
+#include <QString>
+#include <QtGlobal>
+#include <queue>
+#include <vector>
+#include "Quote.h"
+#include "SymbolRegistry.h"
+
+// Price alerts evaluated on every live quote. Each symbol keeps two heaps
+// of trigger levels: a min-heap of levels that fire when the price rises
+// to them and a max-heap of levels that fire when it falls to them. A
+// quote only looks at the heap tops, so evaluation is O(1) when nothing
+// triggers and O(log n) per alert that does, however many are active.
+//
+// Cross alerts are edge-triggered: one that is already on the far side of
+// its level waits in the opposite heap, just past the level, until the
+// price comes back, and re-arms the same way after every crossing.
+// A percent move becomes two levels around the first price it sees;
+// whichever fires first retires the other. Entries of retired alerts are
+// dropped lazily and compacted when they pile up.
+//
+// Fired alerts queue by priority, then by firing order. GUI-thread only,
+// like TickStore.
+class AlertEngine
+{
+public:
+    enum class Kind { Above, Below, CrossAbove, CrossBelow, PercentMove };
+    enum class Priority { Low, Normal, High };
+
+    struct Alert {
+        quint32 id = 0;
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        Kind kind = Kind::Above;
+        Priority priority = Priority::Normal;
+        double level = 0.0;       // price, or percent for PercentMove
+        double reference = 0.0;   // PercentMove: price the move is measured from
+        bool active = false;
+        bool placed = false;      // has entries in the heaps (not pending)
+        quint32 fired = 0;
+    };
+
+    struct Fired {
+        quint32 alertId = 0;
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        Kind kind = Kind::Above;
+        Priority priority = Priority::Normal;
+        double level = 0.0;
+        double reference = 0.0;
+        double price = 0.0;
+        qint64 timestampNs = 0;
+        quint64 sequence = 0;
+    };
+
+    static AlertEngine &instance();
+
+    // Returns the alert id. Alerts on a symbol without a quote yet are
+    // placed when its first quote arrives.
+    quint32 add(quint32 symbolId, Kind kind, double level, Priority priority = Priority::Normal);
+    bool remove(quint32 alertId);
+    const Alert *alert(quint32 alertId) const;
+    int activeCount() const { return m_active; }
+
+    // Returns how many alerts fired
+    int evaluate(const Quote &quote);
+
+    bool hasFired() const { return !m_fired.empty(); }
+    int firedCount() const { return static_cast<int>(m_fired.size()); }
+    Fired takeFired();   // highest priority, then oldest
+
+    static QString describe(const Fired &fired);
+
+private:
+    AlertEngine() = default;
+
+    struct Entry {
+        double key;
+        quint32 alertId;
+        bool arming;   // moves a cross alert to its firing side instead of firing
+    };
+
+    struct RisingFirst {   // min-heap on key
+        bool operator()(const Entry &a, const Entry &b) const { return a.key > b.key; }
+    };
+    struct FallingFirst {  // max-heap on key
+        bool operator()(const Entry &a, const Entry &b) const { return a.key < b.key; }
+    };
+    struct FiredOrder {
+        bool operator()(const Fired &a, const Fired &b) const
+        {
+            return a.priority != b.priority ? a.priority < b.priority : a.sequence > b.sequence;
+        }
+    };
+
+    struct Book {
+        QVector<Entry> rising;    // fire when price >= key
+        QVector<Entry> falling;   // fire when price <= key
+        QVector<quint32> pending; // added before the symbol's first quote
+        int stale = 0;            // superseded entries still in the heaps
+    };
+
+    void place(Book &book, Alert &alert, double price);
+    void pushRising(Book &book, const Entry &entry);
+    void pushFalling(Book &book, const Entry &entry);
+    bool isLive(const Entry &entry) const { return m_alerts[entry.alertId].active; }
+    void fire(Alert &alert, double price, qint64 timestampNs);
+    void compact(Book &book);
+
+    QVector<Alert> m_alerts;   // by id; id 0 is never handed out
+    SymbolArray<Book> m_books;
+    SymbolArray<double> m_lastPrice;
+    std::priority_queue<Fired, std::vector<Fired>, FiredOrder> m_fired;
+    quint64 m_sequence = 0;
+    int m_active = 0;
+};
+
+#endif // ALERTENGINE_H
@@ -0,0 +1,104 @@
+#ifndef BACKTESTER_H
+#define BACKTESTER_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "SymbolRegistry.h"
+#include "TickStore.h"
+#include "IndicatorEngine.h"
+
+// A trading rule evaluated bar by bar. onBar() sees the indicator engine
+// after the bar's close has been appended and returns the position to
+// hold into the next bar: 1 long, 0 flat, -1 short.
+class Strategy
+{
+public:
+    virtual ~Strategy() = default;
+    virtual void reset() {}
+    virtual int onBar(const IndicatorEngine &engine, double close) = 0;
+};
+
+// Trend filter plus RSI: go long when the close crosses above the SMA
+// (unless RSI is already overbought) or when RSI drops below `oversold`;
+// go flat when RSI rises above `overbought` or the close crosses below
+// the SMA.
+class SmaRsiStrategy : public Strategy
+{
+public:
+    struct Params {
+        int smaWindow = 20;
+        int rsiWindow = 14;
+        double oversold = 30.0;
+        double overbought = 70.0;
+    };
+
+    SmaRsiStrategy();
+    explicit SmaRsiStrategy(const Params &params);
+
+    void reset() override;
+    int onBar(const IndicatorEngine &engine, double close) override;
+    const Params &params() const { return m_params; }
+    IndicatorEngine::Config indicatorConfig() const;   // SMA/RSI windows for the engine it reads
+
+private:
+    Params m_params;
+    int m_position = 0;
+    bool m_primed = false;      // m_wasAbove holds a real previous bar
+    bool m_wasAbove = false;
+};
+
+// Replays closes through IndicatorEngine and a Strategy, trading at the
+// close of the signal bar. The inner loop does not allocate; the engine's
+// window buffer is sized once per run.
+class Backtester
+{
+public:
+    struct Result {
+        double totalReturn = 0.0;   // final equity / initial - 1, after costs
+        double maxDrawdown = 0.0;   // largest peak-to-trough equity drop, as a fraction
+        int trades = 0;             // closed round trips
+        int winners = 0;
+        double exposure = 0.0;      // fraction of bars with a position
+        int bars = 0;
+
+        double hitRate() const { return trades > 0 ? static_cast<double>(winners) / trades : 0.0; }
+    };
+
+    struct Costs {
+        double perTrade = 0.0005;   // fraction of notional per position change (5 bps)
+    };
+
+    // Bars before `scoreFrom` only warm up the indicators and the strategy;
+    // positions and P&L are counted from there on, so a run can be scored
+    // on data its parameters were not chosen on. `signalsOut`, when given,
+    // receives one entry per bar: +1 position raised, -1 lowered, 0 held.
+    static Result run(const PriceSpan &closes, Strategy &strategy, const IndicatorEngine::Config &config,
+                      const Costs &costs, int scoreFrom = 0, QVector<int> *signalsOut = nullptr);
+
+    struct History {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        QVector<double> closes;
+    };
+
+    struct Grid {
+        QVector<int> smaWindows;
+        QVector<int> rsiWindows;
+        QVector<double> oversold;
+        QVector<double> overbought;
+
+        int size() const { return smaWindows.size() * rsiWindows.size() * oversold.size() * overbought.size(); }
+    };
+
+    struct SweepResult {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        SmaRsiStrategy::Params params;
+        Result result;
+    };
+
+    // Every symbol x every grid point, in parallel on the global QThreadPool.
+    // Blocking; results are in symbol-major, grid order.
+    static QVector<SweepResult> sweep(const QVector<History> &histories, const Grid &grid, const Costs &costs);
+    static Grid defaultGrid();
+};
+
+#endif // BACKTESTER_H
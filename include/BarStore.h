@@ -0,0 +1,82 @@
+#ifndef BARSTORE_H
+#define BARSTORE_H
+
+#include <QString>
+#include <QJsonObject>
+#include <QtGlobal>
+#include "SymbolRegistry.h"
+#include "TickStore.h"
+
+// Persistent daily bars: one append-only file per symbol under
+// AppDataLocation/bars, read through a memory map. Layout is a fixed
+// 32-byte header followed by 40-byte records in native byte order:
+//
+//   header: magic "SSBR", version, record size, count, first/last timestamp
+//   record: timestampNs, close, volume, high, low
+//
+// Records are only ever appended, except the newest one, which is rewritten
+// while its trading day is still open. The header is written last so a torn
+// append leaves the previous count intact. GUI-thread only.
+class BarStore
+{
+public:
+    static BarStore &instance();
+
+    QString directory() const { return m_directory; }
+
+    // Maps the symbol's file once per session and seeds TickStore's daily
+    // series from it. Returns the number of bars now held for the symbol.
+    int load(quint32 symbolId);
+
+    // Persists only bars newer than the last stored one (a bar on the same
+    // trading day replaces it unless identical) and applies the same change
+    // to TickStore. Returns the number of bars appended or replaced, so 0
+    // means the series did not change.
+    int merge(quint32 symbolId, const BarSeries &bars);
+
+    qint64 lastTimestamp(quint32 symbolId);   // 0 when nothing is stored
+    int count(quint32 symbolId);
+
+    static qint64 tradingDayOf(qint64 timestampNs);   // day number in exchange time (IST)
+
+    // Daily bars from a Yahoo v8 chart payload; pure, runs on the data-plane thread
+    static BarSeries parseYahooChart(const QJsonObject &response);
+
+private:
+    BarStore();
+
+    struct Header {
+        quint32 magic;
+        quint16 version;
+        quint16 recordSize;
+        quint32 count;
+        quint32 reserved;
+        qint64 firstTimestampNs;
+        qint64 lastTimestampNs;
+    };
+
+    struct Record {
+        qint64 timestampNs;
+        double close;
+        double volume;
+        double high;
+        double low;
+    };
+
+    struct Index {
+        bool loaded = false;
+        quint32 count = 0;
+        qint64 firstTimestampNs = 0;
+        qint64 lastTimestampNs = 0;
+    };
+
+    static constexpr quint32 Magic = 0x52425353;   // "SSBR"
+    static constexpr quint16 Version = 1;
+
+    QString pathFor(quint32 symbolId) const;
+
+    QString m_directory;
+    SymbolArray<Index> m_index;
+};
+
+#endif // BARSTORE_H
@@ -0,0 +1,92 @@
+#ifndef CORRELATIONENGINE_H
+#define CORRELATIONENGINE_H
+
+#include <QObject>
+#include <QVector>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include "Quote.h"
+#include "SymbolRegistry.h"
+
+// Rolling Pearson correlation of daily log-returns across the universe.
+// The matrix is kept as sufficient statistics over the last `window`
+// returns (per-symbol sums, all pairwise cross sums), so a correlation is
+// O(1) to read and a live quote, which moves only its symbol's newest
+// return, updates one row and column in O(N).
+//
+// Full recomputes are a blocked R^T R over the returns matrix: symbol
+// tiles against symbol tiles, bar-chunked so both tiles stay in cache,
+// one task per tile pair on the global QThreadPool. UniverseAnalytics
+// starts one with every pass; the result replaces whatever drift the
+// per-tick updates accumulated. Series are aligned on trading day, and
+// only those whose newest bar is in the current session are kept, so the
+// newest bar is the same day for every row and is the one live quotes
+// move. GUI-thread only apart from compute().
+class CorrelationEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Input {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        QVector<double> closes;
+        QVector<qint64> timestampNs;   // one per close, ascending
+    };
+
+    struct Matrix {
+        QVector<quint32> symbolIds;   // row order
+        int window = 0;               // returns per symbol
+        QVector<double> base;         // per row: close before the newest bar
+        QVector<double> last;         // per row: newest return
+        QVector<double> sums;         // per row: sum of returns
+        QVector<double> cross;        // rows x rows: sum of return products, symmetric
+
+        int size() const { return symbolIds.size(); }
+    };
+
+    struct Similar {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        double correlation = 0.0;
+    };
+
+    static constexpr int Window = 250;      // at most one trading year
+    static constexpr int MinWindow = 20;
+    static constexpr int TileSymbols = 32;
+    static constexpr int TileBars = 128;
+
+    static CorrelationEngine *instance();
+
+    // Starts a background recompute unless one is running
+    bool rebuild(const QVector<Input> &inputs);
+    bool isRunning() const { return m_watcher.isRunning(); }
+
+    void update(const Quote &quote);
+
+    bool contains(quint32 symbolId) const;
+    double correlation(quint32 a, quint32 b) const;   // 0 when either is not in the matrix
+    QVector<Similar> mostSimilar(quint32 symbolId, int k) const;   // highest correlation first
+    int size() const { return m_matrix.size(); }
+    int window() const { return m_matrix.window; }
+
+    // Blocking and thread-safe. Drops series that are not in the newest
+    // session, picks the window so that at least three quarters of the rest
+    // cover it, and drops the series that do not.
+    static Matrix compute(const QVector<Input> &inputs);
+
+signals:
+    void matrixReady();
+
+private:
+    explicit CorrelationEngine(QObject *parent = nullptr);
+
+    void adopt();
+    double rowCorrelation(int a, int b) const;
+
+    QFutureWatcher<Matrix> m_watcher;
+    QElapsedTimer m_buildTimer;
+    Matrix m_matrix;
+    SymbolArray<int> m_rowOf;   // row + 1 in m_matrix, 0 when absent
+    SymbolArray<double> m_livePrice;   // newest quote per symbol, reapplied after a rebuild
+};
+
+#endif // CORRELATIONENGINE_H
@@ -19,6 +19,9 @@
 #include <QColor>
 #include <QDebug>
 #include <algorithm>
+#include "Quote.h"
+#include "TickStore.h"
+#include "SeriesLod.h"
 
 class CustomChartWidget : public QWidget
 {
@@ -27,7 +30,7 @@ class CustomChartWidget : public QWidget
 public:
     CustomChartWidget(QWidget *parent = nullptr);
     void setTimeframe(const QString &timeframe);
-    void updateWithLiveData(const QString &symbol, const QJsonObject &data);
+    void updateWithLiveData(const Quote &quote);
     void setSymbol(const QString &symbol);
 
 protected:
@@ -39,12 +42,21 @@ private slots:
 private:
     void generateRealisticData();
     void updateMinMax();
+    TickStore::Series displayedSeries();   // ticks for 1D, daily bars for longer timeframes
+    int firstVisible(const TickStore::Series &series) const;   // first value inside the timeframe
 
-    QVector<double> m_dataPoints;
+    static constexpr int MaxPlaceholderPoints = 50;
+
+    QVector<double> m_placeholder;   // synthetic series shown until two live ticks exist
+    SeriesLod m_lod;                 // min/max pyramid over the displayed series
+    TickStore::Resolution m_lodResolution = TickStore::Resolution::Tick;
+    QVector<int> m_visible;          // decimated indices, reused across repaints
+    QPolygonF m_points;
     double m_minPrice = 1400;
     double m_maxPrice = 1600;
     QString m_timeframe = "1M";
     QString m_symbol;
+    quint32 m_symbolId;
     QTimer *m_animationTimer;
 };
 
@@ -0,0 +1,100 @@
+#ifndef DATAPLANE_H
+#define DATAPLANE_H
+
+#include <QObject>
+#include <QThread>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QUrl>
+#include <QByteArray>
+#include <QString>
+#include <QAtomicInteger>
+#include <QPointer>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+class DataPlaneWorker;
+
+// Network I/O and payload decoding on a dedicated thread.
+// Callers hand over a decoder that runs off the GUI thread; only its
+// already-decoded result is queued back to the caller's thread.
+//
+// All HTTP traffic of the app goes through here: a small fixed pool of
+// QNetworkAccessManagers (each host sticks to one manager so its kept-alive
+// and HTTP/2 connections are reused), with at most maxPerHost requests in
+// flight per host and the rest queued in order.
+class DataPlane : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Delivery = std::function<void()>;
+    using Decoder = std::function<Delivery(const QByteArray &data)>;
+    using ErrorHandler = std::function<void(const QString &error)>;
+
+    struct Stats {
+        quint64 deliveries = 0;
+        quint64 guiNanos = 0;     // time spent in deliveries on the receiving thread
+        quint64 decodeNanos = 0;  // time spent decoding on the data-plane thread
+        quint64 issued = 0;       // requests handed to a network manager
+        quint64 queued = 0;       // requests that waited for a per-host slot
+        quint64 http2 = 0;        // replies that were served over HTTP/2
+    };
+
+    static constexpr int PoolSize = 2;
+    static constexpr int DefaultMaxPerHost = 6;
+
+    static DataPlane *instance();
+
+    // decode runs on the data-plane thread; the Delivery it returns and onError
+    // run on the GUI thread, where context must live. Nothing is delivered
+    // once context is destroyed.
+    void get(const QNetworkRequest &request, QObject *context,
+             Decoder decode, ErrorHandler onError = ErrorHandler());
+
+    // Convenience form: decode(data) -> T off-thread, deliver(const T &) on context's thread
+    template <typename Decode, typename Deliver>
+    void fetch(const QNetworkRequest &request, QObject *context,
+               Decode decode, Deliver deliver, ErrorHandler onError = ErrorHandler())
+    {
+        using Result = std::decay_t<std::invoke_result_t<Decode, const QByteArray &>>;
+        get(request, context, [decode, deliver](const QByteArray &data) -> Delivery {
+            auto result = std::make_shared<Result>(decode(data));
+            return [deliver, result]() { deliver(*result); };
+        }, onError);
+    }
+
+    // Opens (TLS) connections ahead of the first request to url's host
+    void preconnect(const QUrl &url);
+
+    // Upper bound on concurrent requests per host; takes effect for new requests
+    void setMaxPerHost(int maxPerHost);
+
+    // Returns the counters accumulated since the previous call and resets them
+    Stats takeStats();
+
+private:
+    explicit DataPlane(QObject *parent = nullptr);
+    ~DataPlane() override;
+    void shutdown();
+
+    // Queues fn to this object's (the GUI) thread and runs it there only if
+    // guard is still alive. QPointer is only reliable on the thread that owns
+    // its object, so the check never happens on the data-plane thread.
+    void relay(const QPointer<QObject> &guard, std::function<void()> fn);
+
+    QThread *m_thread;
+    DataPlaneWorker *m_worker;
+    QAtomicInteger<quint64> m_deliveries;
+    QAtomicInteger<quint64> m_guiNanos;
+    QAtomicInteger<quint64> m_decodeNanos;
+    QAtomicInteger<quint64> m_issued;
+    QAtomicInteger<quint64> m_queued;
+    QAtomicInteger<quint64> m_http2;
+
+    friend class DataPlaneWorker;
+};
+
+#endif // DATAPLANE_H
@@ -0,0 +1,117 @@
+#ifndef EXTREMA_H
+#define EXTREMA_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// Minimum and maximum of the last `window` values, via two monotonic
+// deques (entries whose values are strictly decreasing / increasing from
+// the front). Entries carry their value, so push() compares without going
+// back to the value ring; it is amortised O(1) and never allocates; the
+// deques and the value ring are sized once by the constructor.
+//
+// replaceLast() rewrites the newest value (a still-forming bar). It is O(1)
+// unless the old value had displaced deque entries and the new one is less
+// extreme; then the displaced stretch is replayed from the value ring.
+//
+// assign() loads a whole series in the state push() would leave. It reads
+// only the last `window` values and builds both deques in one backward
+// scan: an entry survives exactly when every later value is less extreme,
+// so the deques are the strict suffix minima and maxima. New suffix
+// extremes are rare, so the scan barely branches, where building the
+// deques forwards mispredicts on nearly every push.
+class RollingExtrema
+{
+public:
+    explicit RollingExtrema(int window = 1);
+
+    void reset();
+    void push(double value);
+    void replaceLast(double value);
+    void assign(const double *values, int n);
+
+    int window() const { return m_window; }
+    quint64 count() const { return m_count; }
+    bool isEmpty() const { return m_min.size == 0; }
+    double min() const { return m_min.front().value; }   // not valid while empty
+    double max() const { return m_max.front().value; }
+
+private:
+    struct Entry {
+        quint64 index;
+        double value;
+    };
+
+    // Ring-buffer deque of entries; never holds more than `window`
+    struct Deque {
+        QVector<Entry> slots;
+        int head = 0;
+        int size = 0;
+
+        int wrap(int slot) const { return slot >= slots.size() ? slot - slots.size() : slot; }
+        const Entry &front() const { return slots[head]; }
+        const Entry &back() const { return slots[wrap(head + size - 1)]; }
+        void popFront() { head = wrap(head + 1); --size; }
+        void popBack() { --size; }
+        void pushBack(const Entry &entry) { slots[wrap(head + size)] = entry; ++size; }
+    };
+
+    // Appends an entry to one deque; returns how many entries it displaced
+    int admit(Deque &deque, const Entry &entry, bool keepLarger);
+    int rewrite(Deque &deque, const Entry &entry, double oldValue, int displaced, bool keepLarger);
+
+    int m_window;
+    quint64 m_count = 0;
+    int m_next = 0;               // value ring slot of the next push
+    QVector<double> m_values;
+    Deque m_min;
+    Deque m_max;
+    int m_minDisplaced = 0;   // entries the newest push removed from each deque
+    int m_maxDisplaced = 0;
+};
+
+// Incremental swing-point detector for support and resistance. A value is
+// a pivot high (resistance) when it is strictly above the `strength`
+// values on each side, and a pivot low (support) when strictly below;
+// a pivot is confirmed `strength` values after it. Keeps the most recent
+// `keep` levels of each kind, newest first. push() is O(strength).
+// replayStart() finds where replaying a series must begin to end in the
+// state a full replay would, by scanning back from its end.
+class PivotDetector
+{
+public:
+    explicit PivotDetector(int strength = 1, int keep = 3);
+
+    void reset();
+    void push(double value);
+    void replaceLast(double value);
+    int replayStart(const double *values, int n) const;
+
+    const QVector<double> &support() const { return m_support; }
+    const QVector<double> &resistance() const { return m_resistance; }
+
+private:
+    enum class Pivot { None, High, Low };
+
+    // The newest 2 * strength + 1 values, oldest first
+    const double *newest() const { return m_recent.constData() + m_next; }
+    Pivot classify() const;   // the centre of newest()
+    void confirm();
+    void undoConfirm();
+
+    int m_strength;
+    int m_keep;
+    int m_span;                 // 2 * strength + 1
+    quint64 m_count = 0;
+    int m_next = 0;             // ring slot of the next push
+    QVector<double> m_recent;   // ring of the last m_span values, each written twice (slot and slot + m_span)
+    QVector<double> m_support;
+    QVector<double> m_resistance;
+
+    // What the newest push changed, so replaceLast() can take it back
+    Pivot m_lastPivot = Pivot::None;
+    bool m_lastDropped = false;
+    double m_dropped = 0.0;
+};
+
+#endif // EXTREMA_H
@@ -0,0 +1,50 @@
+#ifndef INDEXFEED_H
+#define INDEXFEED_H
+
+#include <QObject>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+#include <QJsonObject>
+#include "Quote.h"
+#include "SymbolRegistry.h"
+
+class MarketStatusChecker;
+
+// Single source of index levels (NIFTY 50, SENSEX, ...). Each subscribed
+// index is refreshed once per interval with a meta-only chart request
+// (range=1d, interval=1d), which needs no crumb or cookie, and every
+// consumer listens to indexUpdated.
+class IndexFeed : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit IndexFeed(MarketStatusChecker *marketChecker, QObject *parent = nullptr);
+
+    void subscribe(const QString &yahooSymbol);   // e.g. "^NSEI"; no-op if already subscribed
+    const Quote *latest(quint32 symbolId) const { return m_latest.find(symbolId); }
+
+    // Base URL the Yahoo symbol is appended to
+    void setChartEndpoint(const QUrl &endpoint);
+    QUrl chartEndpoint() const { return m_chartEndpoint; }
+
+public slots:
+    void refresh();
+
+signals:
+    void indexUpdated(const Quote &quote);
+
+private:
+    void adjustInterval();
+    static Quote parseIndexQuote(const QJsonObject &response, quint32 symbolId, bool marketOpen);   // data-plane thread
+
+    MarketStatusChecker *m_marketChecker;
+    QTimer *m_timer;
+    QUrl m_chartEndpoint;
+    QVector<quint32> m_indexIds;
+    SymbolArray<Quote> m_latest;
+    int m_inFlight = 0;   // replies still pending from the last refresh
+};
+
+#endif // INDEXFEED_H
@@ -0,0 +1,90 @@
+#ifndef INDICATORENGINE_H
+#define INDICATORENGINE_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "TickStore.h"
+#include "IndicatorPipeline.h"
+
+// Rolling SMA / EMA / RSI / Bollinger state for one price series.
+// append() is O(1): running window sum for the SMA, EMA recurrence,
+// Wilder-smoothed average gain/loss for the RSI and a windowed Welford
+// mean/M2 for the Bollinger bands. replaceLast() rewinds the previous
+// append and applies the new price, for bars that are still forming.
+//
+// The batch form, compute(), gives the same result as replaying append()
+// over the series, bit for bit. It runs one fused pass of the same
+// recurrences (IndicatorPipeline) with runtime windows; compile-time
+// presets were no faster there, as the pass is bound by the RSI and
+// Bollinger divisions, which a constant divisor does not remove.
+class IndicatorEngine
+{
+public:
+    struct Config {
+        int smaWindow = 20;
+        int emaWindow = 12;
+        int rsiWindow = 14;
+        int bollingerWindow = 20;
+        double bollingerWidth = 2.0;
+    };
+
+    IndicatorEngine();
+    explicit IndicatorEngine(const Config &config);
+
+    void reset();
+    void append(double price);
+    void replaceLast(double price);
+
+    static IndicatorEngine compute(const PriceSpan &prices);
+    static IndicatorEngine compute(const PriceSpan &prices, const Config &config);
+    // compute(), also handing each close from index `from` on to
+    // visit(i, close), in order and within the same pass
+    template <typename Visit>
+    static IndicatorEngine compute(const PriceSpan &prices, const Config &config, int from, Visit &&visit);
+
+    quint64 count() const { return m_state.count; }
+    double last() const { return m_state.last; }
+    double sma() const;
+    double ema() const { return m_state.ema; }
+    double rsi() const;
+    double bollingerMean() const { return m_state.bollingerMean; }
+    double stdDev() const;
+    double bollingerUpper() const { return m_state.bollingerMean + m_config.bollingerWidth * stdDev(); }
+    double bollingerLower() const { return m_state.bollingerMean - m_config.bollingerWidth * stdDev(); }
+    const Config &config() const { return m_config; }
+
+private:
+    // Everything append() mutates apart from the window buffer
+    using State = IndicatorPipeline::State;
+
+    IndicatorPipeline::RuntimeWindows windows() const;
+    void fillWindow(const PriceSpan &prices, int end);   // the window buffer as of prices[0, end)
+
+    double windowValue(quint64 index) const { return m_window[static_cast<int>(index % m_window.size())]; }
+
+    Config m_config;
+    State m_state;
+    State m_previous;            // state before the latest append, for replaceLast()
+    double m_overwritten = 0.0;  // window slot value the latest append replaced
+    QVector<double> m_window;    // last max(smaWindow, bollingerWindow) prices
+};
+
+template <typename Visit>
+IndicatorEngine IndicatorEngine::compute(const PriceSpan &prices, const Config &config, int from, Visit &&visit)
+{
+    IndicatorEngine engine(config);
+    const int n = prices.size();
+    if (n == 0)
+        return engine;
+
+    // Everything but the newest close in one fused pass. The newest goes
+    // through append() so that replaceLast() can rewind it.
+    engine.m_state = IndicatorPipeline::fused(prices.begin(), n - 1, engine.windows(), from, visit);
+    engine.fillWindow(prices, n - 1);
+    engine.append(prices.last());
+    if (from < n)
+        visit(n - 1, prices.last());
+    return engine;
+}
+
+#endif // INDICATORENGINE_H
@@ -0,0 +1,245 @@
+#ifndef INDICATORPIPELINE_H
+#define INDICATORPIPELINE_H
+
+#include <QtGlobal>
+#include <cmath>
+
+// The recurrences behind IndicatorEngine, written as templates over their
+// window sizes. A Window<N> makes a size a compile-time constant, so the
+// EMA multiplier and the warm-up bounds fold into the loop; divisions by
+// the window stay divisions, since rounding rules out a reciprocal. A DynamicWindow carries the same size as an int. Both run the
+// same arithmetic in the same order, so the results agree to the last
+// bit.
+//
+// Every pass splits into a warm-up loop, where the windows are still
+// filling, and a steady loop with no branches. fused() advances SMA, EMA,
+// RSI and Bollinger together in one pass over the closes. The
+// single-indicator functions are the separate passes it replaces.
+namespace IndicatorPipeline
+{
+    template <int N>
+    struct Window {
+        static_assert(N > 0, "indicator windows must be positive");
+        static constexpr int size() { return N; }
+    };
+
+    struct DynamicWindow {
+        int n = 1;
+        int size() const { return n; }
+    };
+
+    template <int Sma, int Ema, int Rsi, int Bollinger>
+    struct FixedWindows {
+        Window<Sma> sma;
+        Window<Ema> ema;
+        Window<Rsi> rsi;
+        Window<Bollinger> bollinger;
+    };
+
+    struct RuntimeWindows {
+        DynamicWindow sma;
+        DynamicWindow ema;
+        DynamicWindow rsi;
+        DynamicWindow bollinger;
+    };
+
+    // Everything one bar mutates, apart from the closes still inside a window
+    struct State {
+        quint64 count = 0;
+        double last = 0.0;
+        double smaSum = 0.0;
+        double ema = 0.0;
+        double avgGain = 0.0;
+        double avgLoss = 0.0;
+        double bollingerMean = 0.0;
+        double bollingerM2 = 0.0;
+    };
+
+    struct Bands {
+        double mean = 0.0;
+        double stdDev = 0.0;
+    };
+
+    inline double smaFrom(const State &s, int window)
+    {
+        if (s.count == 0) return 0.0;
+        return s.smaSum / static_cast<double>(qMin<quint64>(s.count, window));
+    }
+
+    inline double rsiFrom(double avgGain, double avgLoss, quint64 count)
+    {
+        if (count < 2) return 50.0;
+        if (avgLoss == 0.0) return avgGain == 0.0 ? 50.0 : 100.0;
+        const double rs = avgGain / avgLoss;
+        return 100 - (100 / (1 + rs));
+    }
+
+    inline double stdDevFrom(const State &s, int window)
+    {
+        const quint64 n = qMin<quint64>(s.count, window);
+        return n == 0 ? 0.0 : std::sqrt(s.bollingerM2 / static_cast<double>(n));
+    }
+
+    // One bar. The evicted closes are the ones leaving the SMA and Bollinger
+    // windows, read only once those windows are full. Steady promises that
+    // every window is already full, which removes all the branches.
+    template <bool Steady, typename Windows>
+    inline void step(State &s, const Windows &w, double price, double smaEvicted, double bollingerEvicted)
+    {
+        const quint64 n = s.count;
+
+        // SMA: running sum over the last sma prices
+        s.smaSum += price;
+        if (Steady || n >= static_cast<quint64>(w.sma.size()))
+            s.smaSum -= smaEvicted;
+
+        // EMA seeded with the first price
+        const double multiplier = 2.0 / (w.ema.size() + 1.0);
+        s.ema = (!Steady && n == 0) ? price : (price * multiplier) + (s.ema * (1 - multiplier));
+
+        // RSI: simple mean of the first rsi changes, Wilder smoothing after
+        if (Steady || n > 0) {
+            const double change = price - s.last;
+            const double gain = change > 0 ? change : 0.0;
+            const double loss = change < 0 ? -change : 0.0;
+            const double period = Steady ? static_cast<double>(w.rsi.size())
+                                         : static_cast<double>(qMin<quint64>(n, w.rsi.size()));
+            s.avgGain += (gain - s.avgGain) / period;
+            s.avgLoss += (loss - s.avgLoss) / period;
+        }
+
+        // Bollinger: Welford mean/M2, sliding once the window is full
+        const quint64 bbWindow = static_cast<quint64>(w.bollinger.size());
+        if (!Steady && n < bbWindow) {
+            const double delta = price - s.bollingerMean;
+            s.bollingerMean += delta / static_cast<double>(n + 1);
+            s.bollingerM2 += delta * (price - s.bollingerMean);
+        } else {
+            const double oldMean = s.bollingerMean;
+            s.bollingerMean += (price - bollingerEvicted) / static_cast<double>(bbWindow);
+            s.bollingerM2 += (price - bollingerEvicted) * (price - s.bollingerMean + bollingerEvicted - oldMean);
+            if (s.bollingerM2 < 0.0) s.bollingerM2 = 0.0;
+        }
+
+        s.last = price;
+        ++s.count;
+    }
+
+    // All four indicators in one pass over closes[0, n), from an empty state.
+    // Every close from index `from` on is also handed to visit(i, close) in
+    // the same loop, for state that needs only the tail of the series.
+    template <typename Windows, typename Visit>
+    State fused(const double *closes, int n, const Windows &w, int from, Visit &&visit)
+    {
+        const int sma = w.sma.size();
+        const int bb = w.bollinger.size();
+        const int warm = qMin(n, qMax(qMax(sma, bb), w.rsi.size()));
+        const int tail = qBound(warm, from, qMax(warm, n));
+
+        State s;
+        int i = 0;
+        for (; i < warm; ++i) {
+            step<false>(s, w, closes[i], i >= sma ? closes[i - sma] : 0.0, i >= bb ? closes[i - bb] : 0.0);
+            if (i >= from)
+                visit(i, closes[i]);
+        }
+        for (; i < tail; ++i)
+            step<true>(s, w, closes[i], closes[i - sma], closes[i - bb]);
+        for (; i < n; ++i) {
+            step<true>(s, w, closes[i], closes[i - sma], closes[i - bb]);
+            visit(i, closes[i]);
+        }
+        return s;
+    }
+
+    template <typename Windows>
+    State fused(const double *closes, int n, const Windows &w)
+    {
+        return fused(closes, n, w, n, [](int, double) {});
+    }
+
+    // Separate passes, one indicator each; same values as fused()
+
+    template <typename W>
+    double sma(const double *closes, int n, W window)
+    {
+        const int size = window.size();
+        const int warm = qMin(n, size);
+        State s;
+        int i = 0;
+        for (; i < warm; ++i)
+            s.smaSum += closes[i];
+        for (; i < n; ++i) {
+            s.smaSum += closes[i];
+            s.smaSum -= closes[i - size];
+        }
+        s.count = static_cast<quint64>(n);
+        return smaFrom(s, size);
+    }
+
+    template <typename W>
+    double ema(const double *closes, int n, W window)
+    {
+        if (n <= 0) return 0.0;
+        const double multiplier = 2.0 / (window.size() + 1.0);
+        double value = closes[0];
+        for (int i = 1; i < n; ++i)
+            value = (closes[i] * multiplier) + (value * (1 - multiplier));
+        return value;
+    }
+
+    template <typename W>
+    double rsi(const double *closes, int n, W window)
+    {
+        const int size = window.size();
+        const int warm = qMin(n, size + 1);
+        double avgGain = 0.0;
+        double avgLoss = 0.0;
+        auto fold = [&](int i, double period) {
+            const double change = closes[i] - closes[i - 1];
+            const double gain = change > 0 ? change : 0.0;
+            const double loss = change < 0 ? -change : 0.0;
+            avgGain += (gain - avgGain) / period;
+            avgLoss += (loss - avgLoss) / period;
+        };
+        int i = 1;
+        for (; i < warm; ++i)
+            fold(i, static_cast<double>(i));
+        for (; i < n; ++i)
+            fold(i, static_cast<double>(size));
+        return rsiFrom(avgGain, avgLoss, static_cast<quint64>(qMax(n, 0)));
+    }
+
+    template <typename W>
+    Bands bollinger(const double *closes, int n, W window)
+    {
+        const int size = window.size();
+        const int warm = qMin(n, size);
+        State s;
+        int i = 0;
+        for (; i < warm; ++i) {
+            const double delta = closes[i] - s.bollingerMean;
+            s.bollingerMean += delta / static_cast<double>(i + 1);
+            s.bollingerM2 += delta * (closes[i] - s.bollingerMean);
+        }
+        for (; i < n; ++i) {
+            const double price = closes[i];
+            const double evicted = closes[i - size];
+            const double oldMean = s.bollingerMean;
+            s.bollingerMean += (price - evicted) / static_cast<double>(size);
+            s.bollingerM2 += (price - evicted) * (price - s.bollingerMean + evicted - oldMean);
+            if (s.bollingerM2 < 0.0) s.bollingerM2 = 0.0;
+        }
+        s.count = static_cast<quint64>(qMax(n, 0));
+        return Bands{s.bollingerMean, stdDevFrom(s, size)};
+    }
+
+    // Runtime windows: common sizes dispatch to a compile-time instantiation,
+    // anything else runs the DynamicWindow form
+    double sma(const double *closes, int n, int window);
+    double ema(const double *closes, int n, int window);
+    double rsi(const double *closes, int n, int window);
+    Bands bollinger(const double *closes, int n, int window);
+}
+
+#endif // INDICATORPIPELINE_H
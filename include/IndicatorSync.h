@@ -0,0 +1,62 @@
+#ifndef INDICATORSYNC_H
+#define INDICATORSYNC_H
+
+#include <QtGlobal>
+#include "TickStore.h"
+#include "IndicatorEngine.h"
+#include "Extrema.h"
+#include "StreamingRegression.h"
+
+// Everything the prediction chart derives from one price series, kept
+// current bar by bar: the SMA/EMA/RSI/Bollinger engine, the range of the
+// last `rangeWindow` values, the newest swing pivots and the trend line
+// over the last `trendWindow` values.
+//
+// sync() follows a TickStore series by its absolute position
+// (Series::appended): new values are pushed, a rewritten newest value goes
+// through replaceLast(), both O(1) per bar. On first sight, on reload, or
+// when more was evicted than is still held, load() rebuilds the lot with
+// one pass over the closes: it advances the indicator recurrences and, in
+// the same loop, replays the pivots and the trend line over the tail they
+// depend on. Only the range is built apart, by its backward scan over its
+// window (RollingExtrema::assign). load() leaves what a push() replay of
+// the same closes would.
+class IndicatorSync
+{
+public:
+    struct Config {
+        IndicatorEngine::Config indicators;
+        int rangeWindow = 20;
+        int trendWindow = 20;
+        int pivotStrength = 1;
+        int pivotLevels = 3;
+    };
+
+    IndicatorSync();
+    explicit IndicatorSync(const Config &config);
+
+    void sync(const TickStore::Series &series);
+    void load(const PriceSpan &prices);
+    void push(double price);
+    void replaceLast(double price);
+
+    const Config &config() const { return m_config; }
+    const IndicatorEngine &engine() const { return m_engine; }
+    const RollingExtrema &range() const { return m_range; }
+    const PivotDetector &pivots() const { return m_pivots; }
+    const StreamingRegression &trend() const { return m_trend; }
+
+private:
+    Config m_config;
+    IndicatorEngine m_engine;
+    RollingExtrema m_range;
+    PivotDetector m_pivots;
+    StreamingRegression m_trend;
+
+    // Position in the followed series after the last sync()
+    quint64 m_generation = 0;
+    quint64 m_appended = 0;
+    double m_lastPrice = 0.0;
+};
+
+#endif // INDICATORSYNC_H
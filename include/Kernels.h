@@ -0,0 +1,48 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <QtGlobal>
+
+// Numeric kernels over contiguous double columns (PriceSpan data, TickStore
+// columns). Each entry point goes through a table chosen once at first use:
+// AVX2 when the CPU has it, else SSE2, else portable scalar code. Nothing
+// here allocates. Vector paths sum in a different order than the scalar
+// reference, so results agree to rounding, not bit for bit.
+namespace Kernels
+{
+    enum class Isa { Scalar, Sse2, Avx2 };
+
+    Isa isa();                    // implementation in use
+    Isa bestIsa();                // widest implementation this CPU supports
+    void setIsa(Isa isa);         // clamped to bestIsa(); for comparisons and debugging
+    const char *isaName(Isa isa);
+
+    struct Moments {
+        double mean = 0.0;
+        double variance = 0.0;    // population
+    };
+
+    struct LinearSums {           // x runs 0..n-1
+        double sumY = 0.0;
+        double sumXY = 0.0;
+        double sumYY = 0.0;
+    };
+
+    double sum(const double *x, int n);
+    double dot(const double *a, const double *b, int n);
+    void minMax(const double *x, int n, double *min, double *max);   // n > 0
+    Moments moments(const double *x, int n);
+    void returns(const double *prices, int n, double *out);          // n - 1 simple returns
+    Moments returnMoments(const double *prices, int n);              // moments of those returns
+    LinearSums linearSums(const double *y, int n);
+
+    // out[i] = alpha * x[i] + (1 - alpha) * out[i - 1], with out[-1] = seed
+    void emaScan(const double *x, int n, double alpha, double seed, double *out);
+
+    // Sliding-window statistics, n - window + 1 outputs. These are O(1) per
+    // element already and inherently sequential, so they are not dispatched.
+    void rollingMean(const double *x, int n, int window, double *out);
+    void rollingVariance(const double *x, int n, int window, double *out);
+}
+
+#endif // KERNELS_H
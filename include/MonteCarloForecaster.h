@@ -0,0 +1,57 @@
+#ifndef MONTECARLOFORECASTER_H
+#define MONTECARLOFORECASTER_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "TickStore.h"
+
+// Philox4x32-10 counter-based generator (Salmon et al., SC'11): the output
+// is a pure function of (key, counter), so every path/step draws from its
+// own stream and results do not depend on how work is split across threads.
+struct Philox4x32
+{
+    quint32 key[2];
+
+    void generate(const quint32 counter[4], quint32 out[4]) const;
+};
+
+// Monte Carlo price paths from daily closes. Geometric Brownian motion
+// with drift and volatility estimated over the last `lookback` returns,
+// or a bootstrap that resamples those returns. Paths are stepped in
+// blocks of BlockPaths (structure of arrays, so the update loops
+// vectorise), each block binning log-returns into a per-step histogram;
+// blocks run in parallel on the global QThreadPool and their histograms
+// are summed. The sum is integer, so the bands are bit-identical for a
+// given seed whatever the thread count.
+class MonteCarloForecaster
+{
+public:
+    enum class Model { Gbm, Bootstrap };
+
+    struct Config {
+        int paths = 100000;
+        int steps = 30;
+        int lookback = 20;        // returns used to estimate drift/volatility
+        Model model = Model::Gbm;
+        quint64 seed = 0x5eed5eedULL;
+        int bins = 512;           // histogram resolution per step
+    };
+
+    struct Band {                 // price percentiles at one step ahead
+        double p5 = 0.0;
+        double p25 = 0.0;
+        double p50 = 0.0;
+        double p75 = 0.0;
+        double p95 = 0.0;
+    };
+
+    static constexpr int BlockPaths = 64;
+
+    // Blocking; spreads the work over the global pool and helps from the
+    // calling thread, so it may itself be run from a pool thread.
+    // Returns one band per step, or nothing when the history is too short.
+    static QVector<Band> simulate(const PriceSpan &history, const Config &config);
+    static QVector<Band> simulate(const PriceSpan &history);
+};
+
+#endif // MONTECARLOFORECASTER_H
@@ -0,0 +1,108 @@
+#ifndef PATTERNINDEX_H
+#define PATTERNINDEX_H
+
+#include <QObject>
+#include <QVector>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include "SymbolRegistry.h"
+#include "TickStore.h"
+
+// "Find similar price patterns": the K windows of `length` daily closes,
+// across every stored series, closest in shape to a query window. Shape
+// means z-normalised closes compared under banded dynamic time warping.
+//
+// Every window is reduced to a PAA vector (segment means, from prefix
+// sums, so O(segments) per window) and filed under its SAX word (each
+// segment quantised to Cardinality levels). A bucket keeps the bounding
+// box of its members' PAA vectors. A query visits buckets in order of
+// the box lower bound and stops when the next bound cannot beat the
+// threshold; inside a bucket each window goes through the PAA bound,
+// LB_Keogh against the query's warping envelope and DTW with early
+// abandoning, cheapest first. All three are lower bounds of the DTW
+// distance. The result is the greedy non-overlapping selection, best
+// first, over every window; since a window not yet seen can displace at
+// most two picks, the threshold is the (2K - 1)-th pick over the windows
+// seen so far, and nothing that could make the top K is pruned.
+class PatternIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Config {
+        int length = 30;       // closes per window
+        int segments = 6;      // PAA resolution
+        int band = 3;          // Sakoe-Chiba warping band, in bars
+    };
+
+    struct Input {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        QVector<double> closes;
+    };
+
+    struct Match {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        int offset = 0;          // first close of the window in the indexed series
+        int barsAgo = 0;         // bars between the window's last close and the series' newest
+        double distance = 0.0;   // DTW over z-normalised closes
+    };
+
+    struct Stats {
+        qint64 windows = 0;
+        qint64 bucketsVisited = 0;
+        qint64 prunedByPaa = 0;
+        qint64 prunedByKeogh = 0;
+        qint64 dtwComputed = 0;
+    };
+
+    static constexpr int Cardinality = 8;   // SAX levels per segment
+
+    struct Index {
+        Config config;
+        QVector<quint32> symbolIds;         // per series
+        QVector<QVector<double>> closes;    // per series
+        QVector<int> series;                // per window, grouped by bucket
+        QVector<int> offset;                // per window
+        QVector<double> mean;               // per window: z = (close - mean) * scale
+        QVector<double> scale;
+        QVector<float> paa;                 // per window x segments
+        QVector<int> bucketBegin;           // bucket b holds windows [begin[b], begin[b + 1])
+        QVector<float> boxLow;              // per bucket x segments
+        QVector<float> boxHigh;
+
+        int windows() const { return series.size(); }
+        int buckets() const { return qMax(0, static_cast<int>(bucketBegin.size()) - 1); }
+    };
+
+    static PatternIndex *instance();
+
+    // Starts a background rebuild unless one is running
+    bool rebuild(const QVector<Input> &inputs);
+    bool isRunning() const { return m_watcher.isRunning(); }
+    const Config &config() const { return m_index.config; }
+    int windows() const { return m_index.windows(); }
+
+    // K best non-overlapping matches for the newest `length` closes of
+    // `query`, best first. Windows of `querySymbolId` that overlap the
+    // query itself are skipped.
+    QVector<Match> search(const PriceSpan &query, int k, quint32 querySymbolId, Stats *stats = nullptr) const;
+
+    // Blocking and thread-safe
+    static Index build(const QVector<Input> &inputs, const Config &config);
+    static QVector<Match> search(const Index &index, const PriceSpan &query, int k, quint32 querySymbolId,
+                                 Stats *stats = nullptr);
+
+signals:
+    void indexReady();
+
+private:
+    explicit PatternIndex(QObject *parent = nullptr);
+
+    void adopt();
+
+    QFutureWatcher<Index> m_watcher;
+    QElapsedTimer m_buildTimer;
+    Index m_index;
+};
+
+#endif // PATTERNINDEX_H
@@ -8,10 +8,19 @@
 #include <QJsonObject>
 #include <QTimer>
 #include <QHash>
-#include <QQueue>
-#include <QStack>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
 #include <queue>
 #include <cmath>
+#include "SymbolRegistry.h"
+#include "TickStore.h"
+#include "IndicatorEngine.h"
+#include "IndicatorSync.h"
+#include "RankingService.h"
+#include "MonteCarloForecaster.h"
+#include "Backtester.h"
+#include "CorrelationEngine.h"
+#include "PatternIndex.h"
 
 class PredictionChartWidget : public QWidget
 {
@@ -20,9 +29,10 @@ class PredictionChartWidget : public QWidget
 public:
     explicit PredictionChartWidget(QWidget *parent = nullptr);
     
-    void updateWithLiveData(const QString &symbol, const QVector<double> &prices);
     void setCurrentStock(const QString &symbol);
     QString getCurrentStock() const { return m_currentSymbol; }
+    void setForecastWindow(int bars);    // closes the trend line is fitted over
+    void setForecastHorizon(int days);
 
 protected:
     void paintEvent(QPaintEvent *event) override;
@@ -33,19 +43,20 @@ private slots:
 
 private:
     void requestHistoricalData(const QString &symbol);
-    QVector<double> parseYahooData(const QJsonObject &response);
     void analyzeWithAllDSA();
     
-    void cacheStock(const QString &symbol, const QVector<double> &prices);
-    QVector<double> getCachedStock(const QString &symbol);
-    void updateCache(const QString &symbol, double price);
+    int cacheStock(const QString &symbol, const BarSeries &bars);   // returns bars changed
+    PriceSpan getCachedStock(const QString &symbol);
     
     void calculateSlidingWindowIndicators();
+    const IndicatorEngine &syncIndicators(quint32 symbolId);
     void detectTrendWithStack();
     void findTopPerformers();
     void generateLinearForecast();
+    void startMonteCarlo();
+    void onMonteCarloFinished();
     
-    double calculateVolatility(const QVector<double> &prices, int period = 10);
+    double calculateVolatility(const PriceSpan &prices, int period = 10);
     void updateChartBounds();
     void drawDSALegend(QPainter &painter, int startY);
     
@@ -67,6 +78,7 @@ private:
         double rSquared = 0.0;
     };
     
+    QVector<StockPerformance> topFrom(RankingService::Metric metric, int count);
     QVector<StockPerformance> getTopGainers(int count = 3);
     QVector<StockPerformance> getTopLosers(int count = 3);
     QVector<StockPerformance> getMostVolatile(int count = 3);
@@ -74,6 +86,7 @@ private:
     QString analyzeTrend(const QVector<double> &prices);
     QVector<double> findSupportResistance(const QVector<double> &prices);
     void generateTradingSignals();
+    void findSimilarPatterns();
     void drawEnhancedLegend(QPainter &painter, int startY, int startX);
     double calculateSMA(const QVector<double> &prices, int window = 20);
     double calculateEMA(const QVector<double> &prices, int window = 12);
@@ -87,17 +100,20 @@ private:
     void generateHistoricalFromCurrentPrice(const QString &symbol, double currentPrice);
     void showNoDataError(const QString &symbol);
     
-    QVector<double> m_historicalData;
+    PriceSpan m_historicalData;   // daily closes of the current stock, viewed in TickStore
     QVector<double> m_predictedData;
     QVector<double> m_confidenceIntervals;
-    QVector<int> m_tradingSignals;
+    QVector<int> m_tradingSignals;   // per bar of m_historicalData: +1 buy, -1 sell, 0 hold
     QString m_currentSymbol;
+    quint32 m_currentSymbolId = SymbolRegistry::InvalidId;
     
     double m_minPrice, m_maxPrice;
     QTimer *m_updateTimer;
     
-    QHash<QString, QVector<double>> m_stockCache;
     QVector<StockPerformance> m_stockPerformances;
+    QVector<StockPerformance> m_topGainers, m_topLosers, m_mostVolatile;
+    QVector<CorrelationEngine::Similar> m_similarStocks;   // by return correlation with the current stock
+    QVector<PatternIndex::Match> m_similarPatterns;        // closest in shape to its latest closes
     QVector<double> m_supportLevels, m_resistanceLevels;
     
     double m_smaValue, m_emaValue, m_rsiValue;
@@ -106,6 +122,24 @@ private:
     double m_forecastAccuracy;
      double m_lastFetchedPrice = 0.0;
     int m_cacheHits, m_cacheMisses;
+    // Indicator and extrema state per symbol, advanced only by the bars added since the last sync
+    SymbolArray<IndicatorSync> m_indicators;
+    int m_forecastWindow = 20;
+    int m_forecastHorizon = 7;
+
+    // Percentile bands of simulated paths, one per forecast step
+    QFutureWatcher<QVector<MonteCarloForecaster::Band>> m_monteCarloWatcher;
+    QVector<MonteCarloForecaster::Band> m_monteCarloBands;
+    quint32 m_monteCarloSymbolId = SymbolRegistry::InvalidId;
+    bool m_monteCarloPending = false;   // history changed while a run was in flight
+    QElapsedTimer m_monteCarloTimer;
+    // Default SMA/RSI strategy over the whole history, and a walk-forward
+    // check: grid chosen on the first two thirds, scored on the rest
+    Backtester::Result m_backtest;
+    Backtester::Result m_walkForward;
+    SmaRsiStrategy::Params m_walkForwardParams;
+    SymbolArray<bool> m_historyInFlight;   // one outstanding history request per symbol
+    quint64 m_historyBytes = 0;            // payload bytes received for history
 };
 
 #endif
@@ -0,0 +1,44 @@
+#ifndef QUOTE_H
+#define QUOTE_H
+
+#include <QMetaType>
+#include <QString>
+#include <QDateTime>
+#include <QtGlobal>
+#include <type_traits>
+
+// Fixed-layout live quote passed from the data plane to the UI.
+// The symbol is an interned id (see SymbolRegistry), never a string.
+struct Quote
+{
+    enum class Source : quint8 {
+        Unknown,
+        LiveNse,
+        NseLastClose,
+        LiveYahoo,
+        YahooLastClose,
+        NseOfficial,
+        FallbackRealistic
+    };
+
+    qint64 timestampNs = 0;     // epoch nanoseconds
+    double price = 0.0;
+    double change = 0.0;
+    double changePercent = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    qint64 volume = 0;
+    quint32 symbolId = 0;
+    Source source = Source::Unknown;
+
+    bool isValid() const { return price > 0; }
+
+    static qint64 nowNs() { return QDateTime::currentMSecsSinceEpoch() * 1000000LL; }
+    static QString sourceName(Source source);
+};
+
+static_assert(std::is_trivially_copyable<Quote>::value, "Quote must stay a plain value type");
+
+Q_DECLARE_METATYPE(Quote)
+
+#endif // QUOTE_H
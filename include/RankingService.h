@@ -0,0 +1,72 @@
+#ifndef RANKINGSERVICE_H
+#define RANKINGSERVICE_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "Quote.h"
+#include "SymbolRegistry.h"
+
+// Indexed tournament tree over symbol ids: every internal node holds the
+// id with the largest key in its subtree. set() replays the path to the
+// root, so a key change costs O(log N) and never re-sorts; top(k) walks
+// the tree best-first and touches O(k log N) nodes.
+class RankingTree
+{
+public:
+    void set(quint32 symbolId, double key);
+    void remove(quint32 symbolId);
+    QVector<quint32> top(int k) const;   // best first; symbols without a key are skipped
+
+private:
+    bool beats(int a, int b) const;      // leaf a ranks ahead of leaf b
+    void grow(quint32 symbolId);
+    void replay(int leaf);
+
+    int m_leaves = 0;                    // power of two
+    QVector<double> m_keys;              // per leaf, -inf when absent
+    QVector<int> m_winner;               // heap layout, node 1 is the root
+};
+
+// Universe-wide movers: top gainers, top losers and most volatile symbols.
+// Live quotes update change% per tick; the UniverseAnalytics snapshot
+// supplies volatility and the change% of symbols without a live quote
+// yet. GUI-thread only, like TickStore.
+class RankingService
+{
+public:
+    enum class Metric { Gainers, Losers, Volatile };
+
+    struct Entry {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        double price = 0.0;
+        double change = 0.0;
+        double changePercent = 0.0;
+        double volatility = 0.0;
+    };
+
+    static RankingService &instance();
+
+    void update(const Quote &quote);
+    void updateDaily(quint32 symbolId, double price, double change, double changePercent, double volatility);
+
+    QVector<Entry> top(Metric metric, int k) const;
+    quint64 updates() const { return m_updates; }
+
+private:
+    RankingService() = default;
+
+    struct Row {
+        Entry entry;
+        bool live = false;   // change% comes from a live quote
+    };
+
+    void rankChange(quint32 symbolId, double changePercent);
+
+    SymbolArray<Row> m_rows;
+    RankingTree m_gainers;
+    RankingTree m_losers;     // keyed by -change%
+    RankingTree m_volatile;
+    quint64 m_updates = 0;
+};
+
+#endif // RANKINGSERVICE_H
@@ -2,9 +2,7 @@
 #define REALNEWSMANAGER_H
 
 #include <QObject>
-#include <QNetworkAccessManager>
 #include <QNetworkRequest>
-#include <QNetworkReply>
 #include <QTimer>
 #include <QStringList>
 #include <QTime>
@@ -39,11 +37,11 @@ private:
     void fetchYahooStockNews(const QString &symbol);
     void fetchYahooGeneralNews();
     void fetchYahooRSSNews(const QString &symbol, const QString &type);
-    QStringList parseYahooNewsResponse(const QByteArray &jsonData, const QString &symbol);
-    QStringList parseYahooRSSFeed(const QByteArray &xmlData, const QString &type, const QString &symbol);
+    // Decoders run on the data-plane thread
+    static QStringList parseYahooNewsResponse(const QByteArray &jsonData, const QString &symbol);
+    static QStringList parseYahooRSSFeed(const QByteArray &xmlData, const QString &type, const QString &symbol);
     void emitCombinedNews();
 
-    QNetworkAccessManager *m_networkManager;
     QTimer *m_newsTimer;
     QString m_currentSymbol = "RELIANCE";
     QStringList m_stockNews;
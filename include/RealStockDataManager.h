@@ -12,50 +12,85 @@
 #include <QMap>
 #include <QString>
 #include <QDateTime>
+#include <QUrl>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
 #include <QDebug>
 #include "MarketStatusChecker.h"
+#include "Quote.h"
+#include "SymbolRegistry.h"
 
 class RealStockDataManager : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit RealStockDataManager(QObject *parent = nullptr);
+    // marketChecker is shared with the rest of the app and not owned
+    explicit RealStockDataManager(MarketStatusChecker *marketChecker, QObject *parent = nullptr);
     void fetchStockData(const QString &symbol);
     void fetchAllStocks();
+    // Watches are counted: a symbol leaves the batched refresh once every
+    // watchSymbol() has been matched by an unwatchSymbol()
+    void watchSymbol(const QString &symbol);
+    void unwatchSymbol(const QString &symbol);
     bool isMarketOpen() const;
+
+    // Batched quote mode: fetchAllStocks() requests up to batchSize symbols per call
+    void setBatchSize(int size);
+    int batchSize() const { return m_batchSize; }
+    void setQuoteEndpoint(const QUrl &endpoint);
+    QUrl quoteEndpoint() const { return m_quoteEndpoint; }
     QString getMarketStatus() const;
 
+    // Duplicate requests for a symbol join the one already in flight, and a
+    // quote younger than the freshness TTL is served from memory
+    struct RequestStats {
+        quint64 issued = 0;      // symbols sent to the network
+        quint64 coalesced = 0;   // requests that joined a pending reply
+        quint64 freshHits = 0;   // requests answered from memory
+    };
+    RequestStats requestStats() const { return m_requestStats; }
+    void setFreshnessTtl(int msecs);
+    int freshnessTtl() const { return m_freshnessTtlMs; }
+
 signals:
-    void stockDataReceived(const QString &symbol, const QJsonObject &data);
+    void stockDataReceived(const Quote &quote);
     void apiError(const QString &error);
     void marketStatusChanged(bool isOpen, const QString &statusText);
 
 private slots:
     void onMarketStatusChanged(bool isOpen, const QString &statusText);
-    void handleReply();
 
 private:
     void adjustUpdateInterval();
-    void fetchFromYahoo(const QString &symbol, const QString &yahooSymbol);
-    QJsonObject parseResponse(const QJsonObject &response, const QString &symbol);
+    void fetchFromYahoo(quint32 symbolId);
+    void fetchBatch(const QVector<quint32> &symbolIds);
 
-    QNetworkAccessManager *m_networkManager;
-    QTimer *m_updateTimer;
-    MarketStatusChecker *m_marketChecker;
-    QMap<QString, QString> m_yahooSymbols;
-public:
-    void fetchIndexData();
-    void fetchNiftyData();
-    void fetchSensexData();
+    // Returns the ids that still need a request and marks them in flight;
+    // fresh quotes are replayed to listeners when replayFresh is set
+    QVector<quint32> admit(const QVector<quint32> &symbolIds, bool replayFresh);
+    void complete(const QVector<quint32> &symbolIds, const QVector<Quote> &quotes);
 
-signals:
-    void indexDataReceived(const QString &index, const QJsonObject &data);
+    // Pure decoders; these run on the data-plane thread
+    static Quote parseResponse(const QJsonObject &response, quint32 symbolId, bool marketOpen);
+    static Quote parseQuoteResult(const QJsonObject &result, quint32 symbolId, bool marketOpen);
+    static QVector<Quote> parseBatchResponse(const QJsonObject &response, bool marketOpen);
 
-private:
-    void fetchNiftyFallback();
-    void fetchSensexFallback();
-    QJsonObject parseIndexResponse(const QJsonObject &response, const QString &index);
+    QTimer *m_updateTimer;
+    MarketStatusChecker *m_marketChecker;
+    QVector<quint32> m_trackedIds;      // symbols refreshed by fetchAllStocks()
+    SymbolArray<int> m_tracked;         // watch count per symbol
+    QUrl m_quoteEndpoint;
+    int m_batchSize = 100;
+    SymbolArray<bool> m_inFlight;
+    SymbolArray<Quote> m_recent;         // last quote per symbol
+    SymbolArray<qint64> m_receivedNs;    // local receive time of m_recent
+    int m_freshnessTtlMs = 2000;
+    RequestStats m_requestStats;
 
+    // After a failed batch the per-symbol chart path is used until this time
+    static constexpr int BatchRetryMs = 300000;
+    qint64 m_batchRetryAfterNs = 0;
 };
 #endif // REALSTOCKDATAMANAGER_H
@@ -0,0 +1,92 @@
+#ifndef SCREENER_H
+#define SCREENER_H
+
+#include <QVector>
+#include <QString>
+#include <QtGlobal>
+#include "Quote.h"
+#include "SymbolRegistry.h"
+#include "UniverseAnalytics.h"
+
+// Filters the whole universe with expressions such as
+//   RSI < 30 AND changePercent > 1 AND volume > 2M
+// An expression compiles once into a postfix plan of column comparisons
+// and boolean combinators. run() executes each step over every row at
+// once. A comparison writes a byte mask from one tight loop over a column,
+// and AND/OR combine masks, so the cost is a few passes over flat arrays
+// with no per-row interpretation. NOT is folded into the comparisons at
+// compile time.
+//
+// One row per tracked symbol, stored column-wise. Live quotes update price,
+// change and volume per tick. The UniverseAnalytics snapshot supplies the
+// indicators. Values that are not known yet are NaN, which fails every
+// comparison, negated or not. GUI-thread only, like TickStore.
+class Screener
+{
+public:
+    enum Field {
+        Price, Change, ChangePercent, Volume, High, Low,
+        Rsi, Sma, Ema, BollingerUpper, BollingerLower, Volatility, Slope, RSquared,
+        FieldCount
+    };
+
+    class Plan
+    {
+    public:
+        bool isValid() const { return !m_steps.isEmpty(); }
+        const QString &error() const { return m_error; }
+        const QString &expression() const { return m_expression; }
+
+    private:
+        friend class Screener;
+        friend class ScreenerParser;
+
+        enum class Code : quint8 { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual, And, Or };
+
+        struct Operand {
+            int field = -1;          // column, or -1 for the constant
+            double constant = 0.0;
+        };
+
+        struct Step {
+            Code code;
+            Operand lhs;
+            Operand rhs;
+        };
+
+        QVector<Step> m_steps;       // postfix
+        int m_depth = 0;             // masks live at once
+        QString m_expression;
+        QString m_error;
+    };
+
+    static Screener &instance();
+
+    // Compiles once; keep the plan to rerun it as data changes
+    static Plan compile(const QString &expression);
+
+    // Cheap test for the search box: does the text read as a filter rather than a ticker?
+    static bool looksLikeQuery(const QString &text);
+    static QString fieldName(Field field);
+
+    void track(const QVector<quint32> &symbolIds);
+    void update(const Quote &quote);
+    void updateDaily(const UniverseAnalytics::SymbolAnalytics &row, double volume);
+
+    // Matching symbol ids, in tracking order
+    QVector<quint32> run(const Plan &plan) const;
+    double value(quint32 symbolId, Field field) const;
+    int size() const { return m_symbolIds.size(); }
+
+private:
+    Screener();
+
+    int rowOf(quint32 symbolId);   // adds the row when missing
+
+    QVector<quint32> m_symbolIds;
+    QVector<double> m_columns[FieldCount];
+    QVector<bool> m_live;          // price, change and volume came from a live quote
+    SymbolArray<int> m_rowOf;      // row + 1, 0 when absent
+};
+
+#endif // SCREENER_H
@@ -0,0 +1,65 @@
+#ifndef SERIESLOD_H
+#define SERIESLOD_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "TickStore.h"
+
+// Level-of-detail index for drawing a long price series: a min/max
+// pyramid over blocks of BlockSize values, each level pairing up the
+// blocks of the one below. The extremes of any index range take
+// O(log n) block lookups plus at most two partial blocks of raw values.
+// decimate() picks the lowest and highest point of every pixel column
+// from the coarsest level that fits one, so a repaint emits at most two
+// points per column and costs the same for 1k values as for 10M.
+//
+// sync() follows an append-only TickStore series by its absolute
+// position (Series::appended). New values extend the pyramid in
+// amortised O(1). It is rebuilt when the series is reloaded, rewrites
+// its newest value, or has evicted more than it still holds.
+class SeriesLod
+{
+public:
+    static constexpr int BlockSize = 16;
+
+    struct Extremes {
+        int minAt = -1;   // indices into the synced series
+        int maxAt = -1;
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    void reset();
+    void sync(const TickStore::Series &series);
+
+    // Over series[from, to); the series must be the one last synced
+    Extremes extremes(const PriceSpan &values, int from, int to) const;
+
+    // Indices of at most two points per column over [from, to), in series
+    // order, always including both ends. Every index when the range
+    // already fits in two points per column.
+    void decimate(const PriceSpan &values, int from, int to, int columns, QVector<int> *indices) const;
+
+    int levels() const { return m_levels.size(); }
+
+private:
+    struct Block {
+        double min;
+        double max;
+        quint32 minAt;   // relative to m_origin
+        quint32 maxAt;
+    };
+
+    void extend(const PriceSpan &values, quint64 first, quint64 end);
+    static Block merge(const Block &a, const Block &b);
+
+    QVector<QVector<Block>> m_levels;   // level k blocks span BlockSize << k values
+    quint64 m_origin = 0;               // absolute position of the first indexed value
+    quint64 m_first = 0;                // absolute position of values[0] at the last sync
+    quint64 m_appended = 0;
+    quint64 m_generation = 0;
+    double m_lastValue = 0.0;
+    bool m_valid = false;
+};
+
+#endif // SERIESLOD_H
@@ -30,9 +30,20 @@
 #include <QTableWidgetItem>
 #include <QHeaderView>
 #include <QMessageBox>
+#include <QStatusBar>
+#include <QElapsedTimer>
 #include <QApplication>
 
+#include "Quote.h"
+#include "SymbolRegistry.h"
+#include "TickStore.h"
 #include "RealStockDataManager.h"
+#include "IndexFeed.h"
+#include "UniverseAnalytics.h"
+#include "RankingService.h"
+#include "CorrelationEngine.h"
+#include "AlertEngine.h"
+#include "Screener.h"
 #include "RealNewsManager.h"
 #include "CustomChartWidget.h"
 #include "PredictionChartWidget.h"
@@ -48,16 +59,18 @@ protected:
     void closeEvent(QCloseEvent *event) override;
 
 private slots:
-    void onLiveDataReceived(const QString &symbol, const QJsonObject &data);
+    void onLiveDataReceived(const Quote &quote);
     void onMarketStatusChanged(bool isOpen);
     void onNewsReceived(const QStringList &newsItems);
     void switchView(const QString &viewName);
     void selectStock(const QString &symbol);
-    void updateUIWithLiveData(const QJsonObject &data);
+    void updateUIWithLiveData(const Quote &quote);
     void updateStockData();
     void updateSentimentMeter();
+    void onIndexUpdated(const Quote &quote);
     void updateNiftyDisplay(const QString &price, const QString &change, const QString &color);
     void updateSensexDisplay(const QString &price, const QString &change, const QString &color);
+    void refreshMarketMovers();
 
 private:
     void initializePointers();
@@ -110,6 +123,7 @@ private:
     QLabel *m_sensexLabel;
     QLabel *m_sensexChangeLabel;
     MarketStatusChecker *m_marketStatusChecker;
+    IndexFeed *m_indexFeed;
 
     // Sentiment components
     QLabel *m_sentimentScore;
@@ -123,6 +137,7 @@ private:
     QLabel *m_dashboardSensexPrice;
     QLabel *m_dashboardSensexChange;
     QLabel *m_marketStatusLabel;
+    QLabel *m_marketMoversLabel;
 
     // News and chart components
     QListWidget *m_newsList;
@@ -139,9 +154,14 @@ private:
     // Timer and data
     QTimer *m_updateTimer;
     QString m_currentStock = "RELIANCE";
-    QMap<QString, QJsonObject> m_liveStockData;
-    // Watchlist: symbol -> latest data
-    QMap<QString, QJsonObject> m_watchlist;
+    quint32 m_currentStockId = 0;
+    SymbolArray<Quote> m_liveStockData;   // latest quote per symbol id
+    // Watchlist: symbol ids in display order; prices come from TickStore
+    QVector<quint32> m_watchlistIds;
+    SymbolArray<bool> m_inWatchlist;
+    static constexpr double WatchAlertPercent = 2.0;
+    SymbolArray<quint32> m_watchAlertIds;   // percent-move alert per watched symbol
+    bool m_priceAlertsEnabled = true;
 
     // Add member variables for NIFTY/SENSEX display
     QLabel *m_niftyValueLabel;
@@ -150,6 +170,8 @@ private:
     void addToWatchlist(const QString& symbol);
 void removeFromWatchlist(const QString& symbol);
 void refreshWatchlistTable();
+void notifyFiredAlerts();
+void showScreenerResults(const QString &expression);
 private:
     QTableWidget* m_watchlistTable;
 
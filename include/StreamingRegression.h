@@ -0,0 +1,59 @@
+#ifndef STREAMINGREGRESSION_H
+#define STREAMINGREGRESSION_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// Least-squares line over the last `window` values, x = 0..n-1 from the
+// oldest one. Keeps the windowed sufficient statistics (sum y, sum xy,
+// sum y^2; the x sums are closed-form), so push(), the slide that comes
+// with it and replaceLast() are O(1). Values are stored relative to an
+// origin near the window, and the sums are re-added from the ring once per
+// `window` slides so rounding cannot drift; amortised O(1) as well.
+//
+// Forecasts come with Student-t prediction intervals from the residual
+// standard error of the current fit.
+class StreamingRegression
+{
+public:
+    struct Fit {
+        double slope = 0.0;
+        double intercept = 0.0;        // at x = 0, the oldest value in the window
+        double rSquared = 0.0;
+        double residualStdDev = 0.0;   // sqrt(SSres / (n - 2))
+        int n = 0;
+    };
+
+    explicit StreamingRegression(int window = 20);
+
+    void reset();
+    void push(double value);
+    void replaceLast(double value);
+
+    int window() const { return m_window; }
+    int size() const { return m_size; }
+    Fit fit() const;
+
+    // Value expected `stepsAhead` after the newest one, and the half-width
+    // of its two-sided prediction interval at `level`
+    double predict(int stepsAhead) const;
+    double predictionInterval(int stepsAhead, double level = 0.95) const;
+
+    static double studentQuantile(double p, int degreesOfFreedom);
+
+private:
+    double slot(int age) const;   // age 0 = oldest value in the window
+    void resum();
+
+    int m_window;
+    int m_size = 0;
+    int m_head = 0;               // ring index of the oldest value
+    int m_slidesSinceResum = 0;
+    double m_origin = 0.0;
+    QVector<double> m_values;     // relative to m_origin
+    double m_sumY = 0.0;
+    double m_sumXY = 0.0;
+    double m_sumYY = 0.0;
+};
+
+#endif // STREAMINGREGRESSION_H
@@ -0,0 +1,69 @@
+#ifndef SYMBOLREGISTRY_H
+#define SYMBOLREGISTRY_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <QReadWriteLock>
+
+// Process-wide ticker <-> dense integer id table, plus the Yahoo form of
+// each ticker ("RELIANCE" <-> "RELIANCE.NS"). Ids are stable for the
+// lifetime of the process and are meant to index flat per-symbol arrays.
+class SymbolRegistry
+{
+public:
+    static constexpr quint32 InvalidId = 0xFFFFFFFFu;
+
+    static SymbolRegistry &instance();
+
+    quint32 intern(const QString &symbol);                // adds the symbol if it is new
+    quint32 find(const QString &symbol) const;            // InvalidId if unknown
+    quint32 findYahoo(const QString &yahooSymbol) const;  // InvalidId if unknown
+    QString name(quint32 id) const;
+    QString yahooSymbol(quint32 id) const;
+    int size() const;
+
+    // The NSE universe seeded at startup; ids 0..universe().size()-1
+    QStringList universe() const;
+
+    static QString tickerOf(const QString &symbol);       // "RELIANCE.NS" -> "RELIANCE"
+    static QString yahooFormOf(const QString &ticker);    // "RELIANCE" -> "RELIANCE.NS", "^NSEI" unchanged
+
+private:
+    SymbolRegistry();
+    quint32 internLocked(const QString &ticker);
+
+    mutable QReadWriteLock m_lock;
+    QHash<QString, quint32> m_ids;
+    QHash<QString, quint32> m_yahooIds;
+    QVector<QString> m_names;
+    QVector<QString> m_yahooNames;
+    int m_universeSize = 0;
+};
+
+// Flat per-symbol storage indexed by SymbolRegistry id; grows on demand
+template <typename T>
+class SymbolArray
+{
+public:
+    T &operator[](quint32 id)
+    {
+        if (id >= static_cast<quint32>(m_values.size()))
+            m_values.resize(id + 1);
+        return m_values[id];
+    }
+
+    const T *find(quint32 id) const
+    {
+        return id < static_cast<quint32>(m_values.size()) ? &m_values.at(id) : nullptr;
+    }
+
+    int size() const { return m_values.size(); }
+    void clear() { m_values.clear(); }
+
+private:
+    QVector<T> m_values;
+};
+
+#endif // SYMBOLREGISTRY_H
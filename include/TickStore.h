@@ -0,0 +1,129 @@
+#ifndef TICKSTORE_H
+#define TICKSTORE_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "Quote.h"
+#include "SymbolRegistry.h"
+
+// Read-only view over contiguous doubles (one column of a series)
+struct PriceSpan
+{
+    const double *values = nullptr;
+    int count = 0;
+
+    double operator[](int i) const { return values[i]; }
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    double first() const { return values[0]; }
+    double last() const { return values[count - 1]; }
+    const double *begin() const { return values; }
+    const double *end() const { return values + count; }
+
+    PriceSpan tail(int n) const
+    {
+        n = qBound(0, n, count);
+        return PriceSpan{values + (count - n), n};
+    }
+};
+
+// Owning bar columns, as decoded from the network or read from disk
+struct BarSeries
+{
+    QVector<qint64> timestampNs;
+    QVector<double> close;
+    QVector<double> volume;
+    QVector<double> high;
+    QVector<double> low;
+
+    int size() const { return close.size(); }
+    bool isEmpty() const { return close.isEmpty(); }
+    void reserve(int n)
+    {
+        timestampNs.reserve(n);
+        close.reserve(n);
+        volume.reserve(n);
+        high.reserve(n);
+        low.reserve(n);
+    }
+    void append(qint64 ts, double c, double v, double h, double l)
+    {
+        timestampNs.append(ts);
+        close.append(c);
+        volume.append(v);
+        high.append(h);
+        low.append(l);
+    }
+};
+
+// Central in-memory price history: one fixed-capacity ring buffer per
+// symbol and resolution, stored column-wise (timestamp, price, volume,
+// high, low). Each column is written twice (slot and slot + capacity), so
+// the most recent entries are always contiguous and views need no copy.
+// Until a ring first wraps, its columns hold only what was appended and
+// grow by doubling, so a large capacity costs nothing for short series;
+// the mirror half is added at the first wrap. Appends are amortised O(1).
+// GUI-thread only; a view stays valid until the next write to the same
+// series.
+class TickStore
+{
+public:
+    enum class Resolution { Tick, Daily };
+
+    struct Series
+    {
+        const qint64 *timestampNs = nullptr;
+        PriceSpan price;
+        PriceSpan volume;
+        PriceSpan high;
+        PriceSpan low;
+        quint64 appended = 0;   // total entries ever appended, including evicted ones
+        quint64 generation = 0; // bumped by clear()/assign(); appended restarts from 0
+
+        int size() const { return price.size(); }
+        bool isEmpty() const { return price.isEmpty(); }
+        qint64 lastTimestamp() const { return isEmpty() ? 0 : timestampNs[size() - 1]; }
+    };
+
+    static TickStore &instance();
+
+    void setCapacity(Resolution resolution, int capacity);   // applies to series created afterwards
+    int capacity(Resolution resolution) const;
+
+    void append(const Quote &quote);   // Tick resolution
+    void append(Resolution resolution, quint32 symbolId, qint64 timestampNs,
+                double price, double volume, double high, double low);
+    void append(Resolution resolution, quint32 symbolId, const BarSeries &bars);
+    // Overwrites the newest entry in place (e.g. today's still-forming daily bar)
+    void replaceLast(Resolution resolution, quint32 symbolId, qint64 timestampNs,
+                     double price, double volume, double high, double low);
+    void assign(Resolution resolution, quint32 symbolId, const BarSeries &bars);
+    void clear(Resolution resolution, quint32 symbolId);
+
+    Series series(Resolution resolution, quint32 symbolId) const;
+
+private:
+    TickStore();
+
+    struct Ring
+    {
+        int capacity = 0;
+        quint64 appended = 0;
+        quint64 generation = 0;
+        QVector<qint64> timestampNs;
+        QVector<double> price;
+        QVector<double> volume;
+        QVector<double> high;
+        QVector<double> low;
+    };
+
+    Ring &ring(Resolution resolution, quint32 symbolId);
+    static void resize(Ring &ring, int size);
+    static void write(Ring &ring, int slot, qint64 timestampNs, double price, double volume, double high, double low);
+    static void push(Ring &ring, qint64 timestampNs, double price, double volume, double high, double low);
+
+    int m_capacity[2];
+    SymbolArray<Ring> m_rings[2];
+};
+
+#endif // TICKSTORE_H
@@ -0,0 +1,107 @@
+#ifndef UNIVERSEANALYTICS_H
+#define UNIVERSEANALYTICS_H
+
+#include <QObject>
+#include <QVector>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <QQueue>
+#include <QTimer>
+#include "SymbolRegistry.h"
+#include "TickStore.h"
+
+// Indicators, volatility and a short regression for every symbol at once.
+// run() snapshots each symbol's daily closes on the GUI thread, analyses
+// them in parallel on the global QThreadPool (QtConcurrent::mapped) and
+// publishes the finished table through snapshotReady. Each pass also
+// hands the snapshot to CorrelationEngine and PatternIndex for a rebuild.
+//
+// Symbols with fewer than MinimumBars stored daily bars are left out of a
+// pass and queued for a backfill: a few history requests at a time through
+// the DataPlane, merged into BarStore, so the universe fills in over the
+// first minutes instead of covering only the symbols the user has opened.
+class UniverseAnalytics : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Regression {
+        double slope = 0.0;
+        double intercept = 0.0;
+        double rSquared = 0.0;
+    };
+
+    struct SymbolAnalytics {
+        quint32 symbolId = SymbolRegistry::InvalidId;
+        int bars = 0;
+        double last = 0.0;
+        double change = 0.0;
+        double changePercent = 0.0;
+        double sma = 0.0;
+        double ema = 0.0;
+        double rsi = 50.0;
+        double bollingerUpper = 0.0;
+        double bollingerLower = 0.0;
+        double volatility = 0.0;
+        Regression trend;   // over the last RegressionWindow closes
+    };
+
+    static constexpr int VolatilityPeriod = 10;
+    static constexpr int RegressionWindow = 20;
+    static constexpr int MinimumBars = 2;
+    static constexpr int BackfillInFlight = 2;         // history requests at once
+    static constexpr int BackfillIntervalMs = 1000;    // between request starts
+    static constexpr int BackfillAttempts = 3;         // per symbol and session
+
+    static UniverseAnalytics *instance();
+
+    // Starts a pass unless one is running or the last one started less than
+    // minimumInterval ago; returns whether a pass was started
+    bool run(const QVector<quint32> &symbolIds);
+    bool isRunning() const { return m_watcher.isRunning(); }
+    void setMinimumInterval(int msecs) { m_minimumIntervalMs = qMax(0, msecs); }
+    int pendingBackfills() const { return m_backfillQueue.size() + m_backfillInFlight; }
+
+    const QVector<SymbolAnalytics> &snapshot() const { return m_snapshot; }
+    const SymbolAnalytics *find(quint32 symbolId) const;
+
+    // Pure helpers shared with the single-symbol views
+    static double volatility(const PriceSpan &prices, int period = VolatilityPeriod);
+    static Regression regression(const PriceSpan &prices, int window = RegressionWindow);
+
+    // One symbol's closes as copied out of TickStore, and the pure per-symbol
+    // analysis a pass maps over them on the pool
+    struct Input {
+        quint32 symbolId;
+        QVector<double> closes;
+        QVector<qint64> timestampNs;
+    };
+    static SymbolAnalytics analyze(const Input &input);
+
+signals:
+    void snapshotReady();
+
+private:
+    explicit UniverseAnalytics(QObject *parent = nullptr);
+
+    void publish();
+    void queueBackfill(quint32 symbolId);
+    void startBackfills();
+    void finishBackfill(quint32 symbolId, int changed);
+
+    QFutureWatcher<SymbolAnalytics> m_watcher;
+    QVector<SymbolAnalytics> m_snapshot;
+    SymbolArray<int> m_rowOf;   // row + 1 in m_snapshot, 0 when absent
+    QElapsedTimer m_sinceLastRun;
+    QElapsedTimer m_passTimer;
+    int m_minimumIntervalMs = 30000;
+
+    QTimer *m_backfillTimer;
+    QQueue<quint32> m_backfillQueue;
+    SymbolArray<bool> m_backfillPending;   // queued or in flight
+    SymbolArray<int> m_backfillTries;
+    int m_backfillInFlight = 0;
+    int m_backfilled = 0;                  // symbols filled since the last pass
+};
+
+#endif // UNIVERSEANALYTICS_H
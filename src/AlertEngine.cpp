@@ -0,0 +1,252 @@
+#include "AlertEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    const double Infinity = std::numeric_limits<double>::infinity();
+}
+
+AlertEngine &AlertEngine::instance()
+{
+    static AlertEngine engine;
+    return engine;
+}
+
+quint32 AlertEngine::add(quint32 symbolId, Kind kind, double level, Priority priority)
+{
+    if (symbolId == SymbolRegistry::InvalidId || !(level > 0.0) || !std::isfinite(level))
+        return 0;
+    if (m_alerts.isEmpty())
+        m_alerts.append(Alert());
+
+    Alert alert;
+    alert.id = static_cast<quint32>(m_alerts.size());
+    alert.symbolId = symbolId;
+    alert.kind = kind;
+    alert.priority = priority;
+    alert.level = level;
+    alert.active = true;
+    m_alerts.append(alert);
+    ++m_active;
+
+    Book &book = m_books[symbolId];
+    const double *last = m_lastPrice.find(symbolId);
+    if (last && *last > 0.0)
+        place(book, m_alerts.last(), *last);
+    else
+        book.pending.append(alert.id);
+    return alert.id;
+}
+
+bool AlertEngine::remove(quint32 alertId)
+{
+    if (alertId == 0 || alertId >= static_cast<quint32>(m_alerts.size()) || !m_alerts[alertId].active)
+        return false;
+
+    Alert &alert = m_alerts[alertId];
+    alert.active = false;
+    --m_active;
+    if (alert.placed) {
+        Book &book = m_books[alert.symbolId];
+        book.stale += alert.kind == Kind::PercentMove ? 2 : 1;
+        compact(book);
+    }
+    return true;
+}
+
+const AlertEngine::Alert *AlertEngine::alert(quint32 alertId) const
+{
+    if (alertId == 0 || alertId >= static_cast<quint32>(m_alerts.size()))
+        return nullptr;
+    return &m_alerts.at(alertId);
+}
+
+void AlertEngine::place(Book &book, Alert &alert, double price)
+{
+    alert.placed = true;
+    switch (alert.kind) {
+    case Kind::Above:
+        pushRising(book, {alert.level, alert.id, false});
+        break;
+    case Kind::Below:
+        pushFalling(book, {alert.level, alert.id, false});
+        break;
+    case Kind::CrossAbove:
+        // Already at or above the level: wait until it drops back under
+        if (price < alert.level)
+            pushRising(book, {alert.level, alert.id, false});
+        else
+            pushFalling(book, {std::nextafter(alert.level, -Infinity), alert.id, true});
+        break;
+    case Kind::CrossBelow:
+        if (price > alert.level)
+            pushFalling(book, {alert.level, alert.id, false});
+        else
+            pushRising(book, {std::nextafter(alert.level, Infinity), alert.id, true});
+        break;
+    case Kind::PercentMove:
+        alert.reference = price;
+        pushRising(book, {price * (1.0 + alert.level / 100.0), alert.id, false});
+        pushFalling(book, {price * (1.0 - alert.level / 100.0), alert.id, false});
+        break;
+    }
+}
+
+void AlertEngine::pushRising(Book &book, const Entry &entry)
+{
+    book.rising.append(entry);
+    std::push_heap(book.rising.begin(), book.rising.end(), RisingFirst());
+}
+
+void AlertEngine::pushFalling(Book &book, const Entry &entry)
+{
+    book.falling.append(entry);
+    std::push_heap(book.falling.begin(), book.falling.end(), FallingFirst());
+}
+
+int AlertEngine::evaluate(const Quote &quote)
+{
+    if (!quote.isValid() || quote.symbolId == SymbolRegistry::InvalidId)
+        return 0;
+
+    const double price = quote.price;
+    m_lastPrice[quote.symbolId] = price;
+    Book &book = m_books[quote.symbolId];
+
+    if (!book.pending.isEmpty()) {
+        for (quint32 alertId : book.pending) {
+            Alert &alert = m_alerts[alertId];
+            if (alert.active)
+                place(book, alert, price);
+        }
+        book.pending.clear();
+    }
+
+    int fired = 0;
+
+    while (!book.rising.isEmpty() && book.rising.first().key <= price) {
+        std::pop_heap(book.rising.begin(), book.rising.end(), RisingFirst());
+        const Entry entry = book.rising.takeLast();
+        if (!isLive(entry)) {
+            --book.stale;
+            continue;
+        }
+
+        Alert &alert = m_alerts[entry.alertId];
+        if (entry.arming) {
+            // A cross-below alert is back above its level
+            pushFalling(book, {alert.level, alert.id, false});
+            continue;
+        }
+
+        fire(alert, price, quote.timestampNs);
+        ++fired;
+        if (alert.kind == Kind::CrossAbove) {
+            pushFalling(book, {std::nextafter(alert.level, -Infinity), alert.id, true});
+        } else {
+            alert.active = false;
+            --m_active;
+            if (alert.kind == Kind::PercentMove)
+                ++book.stale;   // its falling level
+        }
+    }
+
+    while (!book.falling.isEmpty() && book.falling.first().key >= price) {
+        std::pop_heap(book.falling.begin(), book.falling.end(), FallingFirst());
+        const Entry entry = book.falling.takeLast();
+        if (!isLive(entry)) {
+            --book.stale;
+            continue;
+        }
+
+        Alert &alert = m_alerts[entry.alertId];
+        if (entry.arming) {
+            // A cross-above alert is back below its level
+            pushRising(book, {alert.level, alert.id, false});
+            continue;
+        }
+
+        fire(alert, price, quote.timestampNs);
+        ++fired;
+        if (alert.kind == Kind::CrossBelow) {
+            pushRising(book, {std::nextafter(alert.level, Infinity), alert.id, true});
+        } else {
+            alert.active = false;
+            --m_active;
+            if (alert.kind == Kind::PercentMove)
+                ++book.stale;   // its rising level
+        }
+    }
+
+    if (fired > 0)
+        compact(book);
+    return fired;
+}
+
+void AlertEngine::fire(Alert &alert, double price, qint64 timestampNs)
+{
+    Fired fired;
+    fired.alertId = alert.id;
+    fired.symbolId = alert.symbolId;
+    fired.kind = alert.kind;
+    fired.priority = alert.priority;
+    fired.level = alert.level;
+    fired.reference = alert.reference;
+    fired.price = price;
+    fired.timestampNs = timestampNs;
+    fired.sequence = ++m_sequence;
+    m_fired.push(fired);
+    ++alert.fired;
+}
+
+void AlertEngine::compact(Book &book)
+{
+    // Only worth a rebuild once dead entries are most of the heaps
+    if (book.stale <= 64 || book.stale * 2 <= book.rising.size() + book.falling.size())
+        return;
+
+    auto dead = [this](const Entry &entry) { return !isLive(entry); };
+    book.rising.erase(std::remove_if(book.rising.begin(), book.rising.end(), dead), book.rising.end());
+    book.falling.erase(std::remove_if(book.falling.begin(), book.falling.end(), dead), book.falling.end());
+    std::make_heap(book.rising.begin(), book.rising.end(), RisingFirst());
+    std::make_heap(book.falling.begin(), book.falling.end(), FallingFirst());
+    book.stale = 0;
+}
+
+AlertEngine::Fired AlertEngine::takeFired()
+{
+    if (m_fired.empty())
+        return Fired();
+    Fired fired = m_fired.top();
+    m_fired.pop();
+    return fired;
+}
+
+QString AlertEngine::describe(const Fired &fired)
+{
+    const QString symbol = SymbolRegistry::instance().name(fired.symbolId);
+    const QString now = QString("₹%1").arg(fired.price, 0, 'f', 2);
+    const QString level = QString("₹%1").arg(fired.level, 0, 'f', 2);
+
+    switch (fired.kind) {
+    case Kind::Above:
+        return QString("🔔 %1 reached %2 (now %3)").arg(symbol, level, now);
+    case Kind::Below:
+        return QString("🔔 %1 fell to %2 (now %3)").arg(symbol, level, now);
+    case Kind::CrossAbove:
+        return QString("🔔 %1 crossed above %2 (now %3)").arg(symbol, level, now);
+    case Kind::CrossBelow:
+        return QString("🔔 %1 crossed below %2 (now %3)").arg(symbol, level, now);
+    case Kind::PercentMove: {
+        const double move = fired.reference > 0.0 ? (fired.price / fired.reference - 1.0) * 100.0 : 0.0;
+        return QString("🔔 %1 moved %2%3% from ₹%4 (now %5)")
+            .arg(symbol, move >= 0 ? "+" : "")
+            .arg(move, 0, 'f', 2)
+            .arg(fired.reference, 0, 'f', 2)
+            .arg(now);
+    }
+    }
+    return QString();
+}
@@ -0,0 +1,172 @@
+#include "Backtester.h"
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
+
+SmaRsiStrategy::SmaRsiStrategy() : SmaRsiStrategy(Params())
+{
+}
+
+SmaRsiStrategy::SmaRsiStrategy(const Params &params) : m_params(params)
+{
+}
+
+void SmaRsiStrategy::reset()
+{
+    m_position = 0;
+    m_primed = false;
+    m_wasAbove = false;
+}
+
+IndicatorEngine::Config SmaRsiStrategy::indicatorConfig() const
+{
+    IndicatorEngine::Config config;
+    config.smaWindow = m_params.smaWindow;
+    config.rsiWindow = m_params.rsiWindow;
+    return config;
+}
+
+int SmaRsiStrategy::onBar(const IndicatorEngine &engine, double close)
+{
+    // Neither indicator means much until its window has filled
+    const quint64 warmup = static_cast<quint64>(qMax(m_params.smaWindow, m_params.rsiWindow + 1));
+    if (engine.count() < warmup)
+        return m_position;
+
+    const double rsi = engine.rsi();
+    const bool above = close > engine.sma();
+    const bool crossedUp = m_primed && above && !m_wasAbove;
+    const bool crossedDown = m_primed && !above && m_wasAbove;
+    m_primed = true;
+    m_wasAbove = above;
+
+    if (m_position == 0) {
+        if ((crossedUp && rsi < m_params.overbought) || rsi < m_params.oversold)
+            m_position = 1;
+    } else if (rsi > m_params.overbought || crossedDown) {
+        m_position = 0;
+    }
+    return m_position;
+}
+
+Backtester::Result Backtester::run(const PriceSpan &closes, Strategy &strategy, const IndicatorEngine::Config &config,
+                                   const Costs &costs, int scoreFrom, QVector<int> *signalsOut)
+{
+    Result result;
+    const int n = closes.size();
+    scoreFrom = qBound(0, scoreFrom, n);
+    if (signalsOut)
+        signalsOut->fill(0, n);
+
+    IndicatorEngine engine(config);
+    strategy.reset();
+
+    double equity = 1.0;
+    double peak = 1.0;
+    double entryEquity = 1.0;
+    int position = 0;
+    int held = 0;
+
+    for (int i = 0; i < n; ++i) {
+        const double close = closes[i];
+        if (position != 0) {
+            // The position taken at the previous close earns this bar's return
+            equity *= 1.0 + position * (close / closes[i - 1] - 1.0);
+            ++held;
+        }
+
+        engine.append(close);
+        const int wanted = qBound(-1, strategy.onBar(engine, close), 1);
+        const int target = i >= scoreFrom ? wanted : 0;
+
+        if (target != position) {
+            if (position != 0) {
+                equity *= 1.0 - costs.perTrade;
+                ++result.trades;
+                if (equity > entryEquity)
+                    ++result.winners;
+            }
+            if (target != 0) {
+                entryEquity = equity;   // before the entry cost, so the trade pays it
+                equity *= 1.0 - costs.perTrade;
+            }
+            if (signalsOut)
+                (*signalsOut)[i] = target > position ? 1 : -1;
+            position = target;
+        }
+
+        peak = qMax(peak, equity);
+        result.maxDrawdown = qMax(result.maxDrawdown, 1.0 - equity / peak);
+    }
+
+    result.bars = n - scoreFrom;
+    result.totalReturn = equity - 1.0;
+    result.exposure = result.bars > 1 ? static_cast<double>(held) / (result.bars - 1) : 0.0;
+    return result;
+}
+
+Backtester::Grid Backtester::defaultGrid()
+{
+    Grid grid;
+    grid.smaWindows = {10, 20, 30, 50};
+    grid.rsiWindows = {14};
+    grid.oversold = {25.0, 30.0, 35.0};
+    grid.overbought = {65.0, 70.0, 75.0};
+    return grid;
+}
+
+QVector<Backtester::SweepResult> Backtester::sweep(const QVector<History> &histories, const Grid &grid,
+                                                   const Costs &costs)
+{
+    const int points = grid.size();
+    const int runs = histories.size() * points;
+    QVector<SweepResult> results(runs);
+    if (runs == 0)
+        return results;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // A single run is a few microseconds, so tasks take contiguous slices
+    // of the (symbol, grid point) space and write disjoint result slots
+    const int tasks = qMin(runs, qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 4));
+    QVector<int> taskIds(tasks);
+    for (int i = 0; i < tasks; ++i)
+        taskIds[i] = i;
+
+    SweepResult *out = results.data();   // detached once here, not from the workers
+    auto runTask = [&](int task) {
+        const int begin = static_cast<int>(static_cast<qint64>(runs) * task / tasks);
+        const int end = static_cast<int>(static_cast<qint64>(runs) * (task + 1) / tasks);
+        for (int run = begin; run < end; ++run) {
+            const History &history = histories[run / points];
+            int point = run % points;
+
+            SmaRsiStrategy::Params params;
+            params.overbought = grid.overbought[point % grid.overbought.size()];
+            point /= grid.overbought.size();
+            params.oversold = grid.oversold[point % grid.oversold.size()];
+            point /= grid.oversold.size();
+            params.rsiWindow = grid.rsiWindows[point % grid.rsiWindows.size()];
+            point /= grid.rsiWindows.size();
+            params.smaWindow = grid.smaWindows[point];
+
+            SmaRsiStrategy strategy(params);
+            const PriceSpan closes{history.closes.constData(), static_cast<int>(history.closes.size())};
+            SweepResult &slot = out[run];
+            slot.symbolId = history.symbolId;
+            slot.params = params;
+            slot.result = Backtester::run(closes, strategy, strategy.indicatorConfig(), costs);
+        }
+    };
+    QtConcurrent::blockingMap(taskIds, runTask);
+
+    qint64 bars = 0;
+    for (const History &history : histories)
+        bars += static_cast<qint64>(history.closes.size()) * points;
+    const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+    qDebug() << "🧪 Backtest sweep:" << runs << "runs," << bars << "bars in" << elapsedNs / 1000 << "µs ("
+             << static_cast<double>(bars) * 1000.0 / elapsedNs << "M bars/s)";
+    return results;
+}
@@ -0,0 +1,201 @@
+#include "BarStore.h"
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+#include <QJsonArray>
+#include <QDebug>
+#include <cstring>
+
+BarStore &BarStore::instance()
+{
+    static BarStore store;
+    return store;
+}
+
+BarStore::BarStore()
+{
+    static_assert(sizeof(Header) == 32, "bar file header must be 32 bytes");
+    static_assert(sizeof(Record) == 40, "bar record must be 40 bytes");
+
+    m_directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/bars";
+    if (!QDir().mkpath(m_directory)) {
+        qWarning() << "⚠️ Cannot create bar store directory" << m_directory;
+    }
+}
+
+QString BarStore::pathFor(quint32 symbolId) const
+{
+    return m_directory + "/" + SymbolRegistry::instance().name(symbolId) + ".bars";
+}
+
+qint64 BarStore::tradingDayOf(qint64 timestampNs)
+{
+    const qint64 istOffsetNs = (5 * 3600LL + 1800LL) * 1000000000LL;
+    return (timestampNs + istOffsetNs) / (86400LL * 1000000000LL);
+}
+
+BarSeries BarStore::parseYahooChart(const QJsonObject &response)
+{
+    BarSeries bars;
+
+    const QJsonArray results = response["chart"].toObject()["result"].toArray();
+    if (results.isEmpty())
+        return bars;
+
+    const QJsonObject result = results[0].toObject();
+    const QJsonArray quote = result["indicators"].toObject()["quote"].toArray();
+    if (quote.isEmpty())
+        return bars;
+
+    const QJsonArray timestamps = result["timestamp"].toArray();
+    const QJsonObject columns = quote[0].toObject();
+    const QJsonArray closePrices = columns["close"].toArray();
+    const QJsonArray volumes = columns["volume"].toArray();
+    const QJsonArray highs = columns["high"].toArray();
+    const QJsonArray lows = columns["low"].toArray();
+
+    bars.reserve(closePrices.size());
+    for (int i = 0; i < closePrices.size(); ++i) {
+        const double close = closePrices[i].toDouble();
+        if (closePrices[i].isNull() || close <= 0)
+            continue;
+
+        const qint64 timestampNs = i < timestamps.size()
+            ? static_cast<qint64>(timestamps[i].toDouble()) * 1000000000LL
+            : 0;
+        const double high = i < highs.size() && !highs[i].isNull() ? highs[i].toDouble() : close;
+        const double low = i < lows.size() && !lows[i].isNull() ? lows[i].toDouble() : close;
+        bars.append(timestampNs, close, i < volumes.size() ? volumes[i].toDouble() : 0.0, high, low);
+    }
+    return bars;
+}
+
+int BarStore::load(quint32 symbolId)
+{
+    Index &index = m_index[symbolId];
+    if (index.loaded)
+        return static_cast<int>(index.count);
+    index.loaded = true;
+
+    QFile file(pathFor(symbolId));
+    if (!file.exists() || file.size() < static_cast<qint64>(sizeof(Header)))
+        return 0;
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "⚠️ Cannot open bar file" << file.fileName();
+        return 0;
+    }
+
+    const qint64 size = file.size();
+    const uchar *data = file.map(0, size);
+    if (!data) {
+        qWarning() << "⚠️ Cannot map bar file" << file.fileName();
+        return 0;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    const qint64 needed = static_cast<qint64>(sizeof(Header)) + static_cast<qint64>(header.count) * sizeof(Record);
+    if (header.magic != Magic || header.version != Version ||
+        header.recordSize != sizeof(Record) || needed > size) {
+        qWarning() << "⚠️ Ignoring malformed bar file" << file.fileName();
+        file.unmap(const_cast<uchar *>(data));
+        return 0;
+    }
+
+    // Only the tail that fits the in-memory ring is copied out of the map
+    const int capacity = TickStore::instance().capacity(TickStore::Resolution::Daily);
+    const quint32 first = header.count > static_cast<quint32>(capacity) ? header.count - capacity : 0;
+
+    BarSeries bars;
+    bars.reserve(static_cast<int>(header.count - first));
+    const uchar *records = data + sizeof(Header);
+    for (quint32 i = first; i < header.count; ++i) {
+        Record record;
+        std::memcpy(&record, records + static_cast<qint64>(i) * sizeof(Record), sizeof(Record));
+        bars.append(record.timestampNs, record.close, record.volume, record.high, record.low);
+    }
+    file.unmap(const_cast<uchar *>(data));
+
+    index.count = header.count;
+    index.firstTimestampNs = header.firstTimestampNs;
+    index.lastTimestampNs = header.lastTimestampNs;
+    TickStore::instance().assign(TickStore::Resolution::Daily, symbolId, bars);
+
+    qDebug() << "💾 Loaded" << header.count << "bars for" << SymbolRegistry::instance().name(symbolId) << "from disk";
+    return static_cast<int>(index.count);
+}
+
+int BarStore::merge(quint32 symbolId, const BarSeries &bars)
+{
+    load(symbolId);
+    Index &index = m_index[symbolId];
+
+    QFile file(pathFor(symbolId));
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning() << "⚠️ Cannot write bar file" << file.fileName();
+        return 0;
+    }
+
+    TickStore &ticks = TickStore::instance();
+    Header header{Magic, Version, static_cast<quint16>(sizeof(Record)),
+                  index.count, 0, index.firstTimestampNs, index.lastTimestampNs};
+    int written = 0;
+
+    for (int i = 0; i < bars.size(); ++i) {
+        const Record record{bars.timestampNs[i], bars.close[i], bars.volume[i], bars.high[i], bars.low[i]};
+        if (record.timestampNs <= 0)
+            continue;
+
+        quint32 slot = header.count;
+        if (header.count > 0) {
+            const qint64 day = tradingDayOf(record.timestampNs);
+            const qint64 lastDay = tradingDayOf(header.lastTimestampNs);
+            if (day < lastDay)
+                continue;   // already on disk
+            if (day == lastDay) {
+                slot = header.count - 1;   // today's bar is still forming
+                const TickStore::Series daily = ticks.series(TickStore::Resolution::Daily, symbolId);
+                if (!daily.isEmpty() && daily.lastTimestamp() == record.timestampNs &&
+                    daily.price.last() == record.close && daily.volume.last() == record.volume &&
+                    daily.high.last() == record.high && daily.low.last() == record.low)
+                    continue;   // unchanged since the last poll
+            }
+        }
+
+        file.seek(static_cast<qint64>(sizeof(Header)) + static_cast<qint64>(slot) * sizeof(Record));
+        file.write(reinterpret_cast<const char *>(&record), sizeof(Record));
+
+        if (slot == header.count) {
+            ++header.count;
+            ticks.append(TickStore::Resolution::Daily, symbolId, record.timestampNs,
+                         record.close, record.volume, record.high, record.low);
+        } else {
+            ticks.replaceLast(TickStore::Resolution::Daily, symbolId, record.timestampNs,
+                              record.close, record.volume, record.high, record.low);
+        }
+        if (header.count == 1)
+            header.firstTimestampNs = record.timestampNs;
+        header.lastTimestampNs = record.timestampNs;
+        ++written;
+    }
+
+    if (written > 0) {
+        file.seek(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        index.count = header.count;
+        index.firstTimestampNs = header.firstTimestampNs;
+        index.lastTimestampNs = header.lastTimestampNs;
+    }
+    return written;
+}
+
+qint64 BarStore::lastTimestamp(quint32 symbolId)
+{
+    load(symbolId);
+    return m_index[symbolId].lastTimestampNs;
+}
+
+int BarStore::count(quint32 symbolId)
+{
+    return load(symbolId);
+}
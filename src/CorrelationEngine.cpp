@@ -0,0 +1,259 @@
+#include "CorrelationEngine.h"
+#include "Kernels.h"
+#include "BarStore.h"
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QDebug>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <limits>
+
+CorrelationEngine *CorrelationEngine::instance()
+{
+    static CorrelationEngine *engine = new CorrelationEngine(QCoreApplication::instance());
+    return engine;
+}
+
+CorrelationEngine::CorrelationEngine(QObject *parent) : QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<Matrix>::finished, this, &CorrelationEngine::adopt);
+}
+
+bool CorrelationEngine::rebuild(const QVector<Input> &inputs)
+{
+    if (m_watcher.isRunning())
+        return false;
+
+    m_buildTimer.start();
+    m_watcher.setFuture(QtConcurrent::run([inputs]() { return compute(inputs); }));
+    return true;
+}
+
+void CorrelationEngine::adopt()
+{
+    m_matrix = m_watcher.result();
+    m_rowOf.clear();
+    for (int row = 0; row < m_matrix.size(); ++row)
+        m_rowOf[m_matrix.symbolIds[row]] = row + 1;
+
+    // The closes were snapshotted before the build; put the live prices back on top
+    for (int row = 0; row < m_matrix.size(); ++row) {
+        const double *price = m_livePrice.find(m_matrix.symbolIds[row]);
+        if (price && *price > 0) {
+            Quote quote;
+            quote.symbolId = m_matrix.symbolIds[row];
+            quote.price = *price;
+            update(quote);
+        }
+    }
+
+    qDebug() << "🔗 Correlation matrix:" << m_matrix.size() << "symbols x" << m_matrix.window << "returns in"
+             << m_buildTimer.nsecsElapsed() / 1000 << "µs";
+    emit matrixReady();
+}
+
+void CorrelationEngine::update(const Quote &quote)
+{
+    if (!quote.isValid())
+        return;
+    m_livePrice[quote.symbolId] = quote.price;
+
+    const int *found = m_rowOf.find(quote.symbolId);
+    if (!found || *found == 0)
+        return;
+    const int row = *found - 1;
+    const int n = m_matrix.size();
+    if (m_matrix.base[row] <= 0)
+        return;
+
+    // Only this symbol's newest return moves: its row and column of cross
+    // sums shift by delta times the other symbols' newest returns
+    const double fresh = std::log(quote.price / m_matrix.base[row]);
+    const double stale = m_matrix.last[row];
+    const double delta = fresh - stale;
+    if (delta == 0.0)
+        return;
+
+    double *cross = m_matrix.cross.data();
+    const double *last = m_matrix.last.constData();
+    double *rowCross = cross + static_cast<qint64>(row) * n;
+    for (int j = 0; j < n; ++j) {
+        rowCross[j] += delta * last[j];
+        cross[static_cast<qint64>(j) * n + row] = rowCross[j];
+    }
+    rowCross[row] = rowCross[row] - delta * stale + fresh * fresh - stale * stale;
+
+    m_matrix.sums[row] += delta;
+    m_matrix.last[row] = fresh;
+}
+
+bool CorrelationEngine::contains(quint32 symbolId) const
+{
+    const int *row = m_rowOf.find(symbolId);
+    return row && *row > 0;
+}
+
+double CorrelationEngine::rowCorrelation(int a, int b) const
+{
+    const int n = m_matrix.size();
+    const double w = m_matrix.window;
+    const double sa = m_matrix.sums[a], sb = m_matrix.sums[b];
+    const double varA = w * m_matrix.cross[static_cast<qint64>(a) * n + a] - sa * sa;
+    const double varB = w * m_matrix.cross[static_cast<qint64>(b) * n + b] - sb * sb;
+    if (varA <= 0 || varB <= 0)
+        return 0.0;
+    const double cov = w * m_matrix.cross[static_cast<qint64>(a) * n + b] - sa * sb;
+    return qBound(-1.0, cov / std::sqrt(varA * varB), 1.0);
+}
+
+double CorrelationEngine::correlation(quint32 a, quint32 b) const
+{
+    const int *rowA = m_rowOf.find(a);
+    const int *rowB = m_rowOf.find(b);
+    if (!rowA || !rowB || *rowA == 0 || *rowB == 0)
+        return 0.0;
+    return rowCorrelation(*rowA - 1, *rowB - 1);
+}
+
+QVector<CorrelationEngine::Similar> CorrelationEngine::mostSimilar(quint32 symbolId, int k) const
+{
+    QVector<Similar> similar;
+    const int *found = m_rowOf.find(symbolId);
+    if (!found || *found == 0 || k <= 0)
+        return similar;
+    const int row = *found - 1;
+
+    similar.reserve(m_matrix.size() - 1);
+    for (int j = 0; j < m_matrix.size(); ++j) {
+        if (j != row)
+            similar.append(Similar{m_matrix.symbolIds[j], rowCorrelation(row, j)});
+    }
+
+    // Ties go to the lower id, so the order is stable between identical matrices
+    const auto higher = [](const Similar &a, const Similar &b) {
+        return a.correlation != b.correlation ? a.correlation > b.correlation : a.symbolId < b.symbolId;
+    };
+    k = qMin(k, similar.size());
+    std::partial_sort(similar.begin(), similar.begin() + k, similar.end(), higher);
+    similar.resize(k);
+    return similar;
+}
+
+CorrelationEngine::Matrix CorrelationEngine::compute(const QVector<Input> &inputs)
+{
+    Matrix m;
+
+    // Trading day of every bar; the current session is the newest day any series reached
+    QVector<QVector<qint64>> days(inputs.size());
+    qint64 session = std::numeric_limits<qint64>::min();
+    for (int i = 0; i < inputs.size(); ++i) {
+        const Input &input = inputs[i];
+        if (input.closes.size() <= MinWindow || input.timestampNs.size() != input.closes.size())
+            continue;
+        days[i].reserve(input.timestampNs.size());
+        for (qint64 timestampNs : input.timestampNs)
+            days[i].append(BarStore::tradingDayOf(timestampNs));
+        session = qMax(session, days[i].last());
+    }
+
+    // A series that stopped before the session would pair its newest return,
+    // and every live quote on top of it, with a different day's returns
+    QVector<qint64> calendar;
+    for (int i = 0; i < inputs.size(); ++i) {
+        if (days[i].isEmpty())
+            continue;
+        if (days[i].last() != session) {
+            days[i].clear();
+            continue;
+        }
+        calendar += days[i];
+    }
+    std::sort(calendar.begin(), calendar.end());
+    calendar.erase(std::unique(calendar.begin(), calendar.end()), calendar.end());
+
+    // Series length in calendar days, from its first bar to the session
+    QVector<int> lengths;
+    for (int i = 0; i < inputs.size(); ++i) {
+        if (!days[i].isEmpty())
+            lengths.append(calendar.end() - std::lower_bound(calendar.begin(), calendar.end(), days[i].first()) - 1);
+    }
+    if (lengths.isEmpty())
+        return m;
+    std::sort(lengths.begin(), lengths.end(), std::greater<int>());
+    const int covered = (lengths.size() * 3 + 3) / 4;
+    const int window = qMin(Window, lengths[covered - 1]);
+    if (window <= 0)
+        return m;
+    const qint64 *windowDays = calendar.constData() + calendar.size() - window - 1;
+
+    // One contiguous run of `window` log-returns per symbol, on the shared
+    // calendar; a day a symbol did not trade carries its previous close
+    QVector<double> returns;
+    QVector<double> aligned(window + 1);
+    for (int i = 0; i < inputs.size(); ++i) {
+        const QVector<qint64> &day = days[i];
+        if (day.isEmpty() || day.first() > windowDays[0])
+            continue;
+        const double *source = inputs[i].closes.constData();
+        int bar = 0;
+        for (int t = 0; t <= window; ++t) {
+            while (bar + 1 < day.size() && day[bar + 1] <= windowDays[t])
+                ++bar;
+            aligned[t] = source[bar];
+        }
+        const double *closes = aligned.constData();
+        if (*std::min_element(closes, closes + window + 1) <= 0)
+            continue;
+
+        const int offset = returns.size();
+        returns.resize(offset + window);
+        for (int t = 0; t < window; ++t)
+            returns[offset + t] = std::log(closes[t + 1] / closes[t]);
+
+        m.symbolIds.append(inputs[i].symbolId);
+        m.base.append(closes[window - 1]);
+        m.last.append(returns[offset + window - 1]);
+        m.sums.append(Kernels::sum(returns.constData() + offset, window));
+    }
+
+    const int n = m.symbolIds.size();
+    m.window = window;
+    m.cross.fill(0.0, n * n);
+    if (n == 0)
+        return m;
+
+    // Upper-triangular tile pairs; each task owns its block and the mirror block
+    const int tiles = (n + TileSymbols - 1) / TileSymbols;
+    QVector<int> pairs;
+    pairs.reserve(tiles * (tiles + 1) / 2);
+    for (int i = 0; i < tiles; ++i)
+        for (int j = i; j < tiles; ++j)
+            pairs.append(i * tiles + j);
+
+    const double *r = returns.constData();
+    double *cross = m.cross.data();
+    auto multiplyTiles = [=](int pair) {
+        const int rowBegin = (pair / tiles) * TileSymbols;
+        const int rowEnd = qMin(n, rowBegin + TileSymbols);
+        const int colBegin = (pair % tiles) * TileSymbols;
+        const int colEnd = qMin(n, colBegin + TileSymbols);
+
+        for (int k = 0; k < window; k += TileBars) {
+            const int bars = qMin(TileBars, window - k);
+            for (int a = rowBegin; a < rowEnd; ++a) {
+                const double *x = r + static_cast<qint64>(a) * window + k;
+                double *out = cross + static_cast<qint64>(a) * n;
+                for (int b = qMax(a, colBegin); b < colEnd; ++b)
+                    out[b] += Kernels::dot(x, r + static_cast<qint64>(b) * window + k, bars);
+            }
+        }
+        for (int a = rowBegin; a < rowEnd; ++a)
+            for (int b = qMax(a + 1, colBegin); b < colEnd; ++b)
+                cross[static_cast<qint64>(b) * n + a] = cross[static_cast<qint64>(a) * n + b];
+    };
+    QtConcurrent::blockingMap(pairs, multiplyTiles);
+    return m;
+}
@@ -1,4 +1,7 @@
 #include "CustomChartWidget.h"
+#include "SymbolRegistry.h"
+#include "BarStore.h"
+#include "Kernels.h"
 #include <cmath>
 #include <algorithm>
 
@@ -6,6 +9,7 @@ CustomChartWidget::CustomChartWidget(QWidget *parent) : QWidget(parent)
 {
     setMinimumHeight(350);
     m_symbol = "RELIANCE";
+    m_symbolId = SymbolRegistry::instance().intern(m_symbol);
     generateRealisticData();
     
     m_animationTimer = new QTimer(this);
@@ -20,26 +24,62 @@ void CustomChartWidget::setTimeframe(const QString &timeframe)
     update();
 }
 
-void CustomChartWidget::updateWithLiveData(const QString &symbol, const QJsonObject &data)
+void CustomChartWidget::updateWithLiveData(const Quote &quote)
 {
-    if (symbol != m_symbol) return;
+    if (quote.symbolId != m_symbolId) return;
     
-    double price = data["price"].toDouble();
-    if (price > 0) {
-        m_dataPoints.append(price);
-        if (m_dataPoints.size() > 50) {
-            m_dataPoints.removeFirst();
-        }
+    // The tick itself is already in TickStore; just rescale and repaint
+    if (quote.isValid()) {
         updateMinMax();
         update();
-        qDebug() << "📈 Chart updated with live price ₹" << price << "for" << symbol;
+        qDebug() << "📈 Chart updated with live price ₹" << quote.price << "for" << m_symbol;
+    }
+}
+
+TickStore::Series CustomChartWidget::displayedSeries()
+{
+    // 1D draws the session's ticks. Longer timeframes draw the stored daily
+    // bars, and fall back to ticks until at least two bars are stored.
+    TickStore::Resolution resolution = TickStore::Resolution::Tick;
+    TickStore::Series series;
+    if (m_timeframe != "1D") {
+        BarStore::instance().load(m_symbolId);   // lazy, once per symbol and session
+        series = TickStore::instance().series(TickStore::Resolution::Daily, m_symbolId);
+        resolution = TickStore::Resolution::Daily;
+    }
+    if (series.size() < 2) {
+        series = TickStore::instance().series(TickStore::Resolution::Tick, m_symbolId);
+        resolution = TickStore::Resolution::Tick;
     }
+
+    // The pyramid follows one series at a time
+    if (resolution != m_lodResolution) {
+        m_lod.reset();
+        m_lodResolution = resolution;
+    }
+    return series;
+}
+
+int CustomChartWidget::firstVisible(const TickStore::Series &series) const
+{
+    int days = 30;
+    if (m_timeframe == "1D") days = 1;
+    else if (m_timeframe == "1W") days = 7;
+    else if (m_timeframe == "1M") days = 30;
+    else if (m_timeframe == "3M") days = 91;
+    else if (m_timeframe == "1Y") days = 365;
+
+    const qint64 start = series.lastTimestamp() - static_cast<qint64>(days) * 86400LL * 1000000000LL;
+    const qint64 *first = std::lower_bound(series.timestampNs, series.timestampNs + series.size(), start);
+    return qMin(static_cast<int>(first - series.timestampNs), series.size() - 2);
 }
 
 void CustomChartWidget::setSymbol(const QString &symbol)
 {
     if (m_symbol != symbol) {
         m_symbol = symbol;
+        m_symbolId = SymbolRegistry::instance().intern(symbol);
+        m_lod.reset();
         generateRealisticData();
         update();
     }
@@ -66,35 +106,46 @@ void CustomChartWidget::paintEvent(QPaintEvent *event)
         painter.drawLine(chartRect.left(), y, chartRect.right(), y);
     }
     
+    const TickStore::Series series = displayedSeries();
+    const bool live = series.size() >= 2;
+    const PriceSpan prices = live ? series.price : PriceSpan{m_placeholder.constData(), static_cast<int>(m_placeholder.size())};
+    const int from = live ? firstVisible(series) : 0;
+
+    // At most two points per pixel column, however long the series is
+    if (live) {
+        m_lod.sync(series);
+        m_lod.decimate(prices, from, prices.size(), chartRect.width(), &m_visible);
+    } else {
+        m_visible.clear();
+        for (int i = 0; i < prices.size(); ++i)
+            m_visible.append(i);
+    }
+
+    m_points.clear();
+    m_points.reserve(m_visible.size() + 2);
+    const double span = qMax(1, prices.size() - 1 - from);
+    for (int i : m_visible) {
+        double x = chartRect.left() + (chartRect.width() * (i - from) / span);
+        double y = chartRect.bottom() - ((prices[i] - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
+        m_points << QPointF(x, y);
+    }
+
     // Draw price line
-    if (m_dataPoints.size() > 1) {
+    if (m_points.size() > 1) {
         painter.setPen(QPen(QColor("#3b82f6"), 2));
-        for (int i = 0; i < m_dataPoints.size() - 1; ++i) {
-            double x1 = chartRect.left() + (chartRect.width() * i / (m_dataPoints.size() - 1));
-            double x2 = chartRect.left() + (chartRect.width() * (i + 1) / (m_dataPoints.size() - 1));
-            double y1 = chartRect.bottom() - ((m_dataPoints[i] - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
-            double y2 = chartRect.bottom() - ((m_dataPoints[i + 1] - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
-            painter.drawLine(QPointF(x1, y1), QPointF(x2, y2));
-        }
+        painter.drawPolyline(m_points);
     }
     
     // Fill area under curve
-    QPolygonF polygon;
-    for (int i = 0; i < m_dataPoints.size(); ++i) {
-        double x = chartRect.left() + (chartRect.width() * i / (m_dataPoints.size() - 1));
-        double y = chartRect.bottom() - ((m_dataPoints[i] - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
-        polygon << QPointF(x, y);
-    }
-    
-    polygon << QPointF(chartRect.right(), chartRect.bottom());
-    polygon << QPointF(chartRect.left(), chartRect.bottom());
+    m_points << QPointF(chartRect.right(), chartRect.bottom());
+    m_points << QPointF(chartRect.left(), chartRect.bottom());
     
     QLinearGradient gradient(0, chartRect.top(), 0, chartRect.bottom());
     gradient.setColorAt(0, QColor(59, 130, 246, 80));
     gradient.setColorAt(1, QColor(59, 130, 246, 15));
     painter.setBrush(QBrush(gradient));
     painter.setPen(Qt::NoPen);
-    painter.drawPolygon(polygon);
+    painter.drawPolygon(m_points);
     
     // Better Y-axis labels
     painter.setPen(QPen(QColor("#6b7280"), 1));
@@ -107,8 +158,8 @@ void CustomChartWidget::paintEvent(QPaintEvent *event)
     }
     
     // Current price indicator
-    if (!m_dataPoints.isEmpty()) {
-        double currentPrice = m_dataPoints.last();
+    if (!prices.isEmpty()) {
+        double currentPrice = prices.last();
         double y = chartRect.bottom() - ((currentPrice - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
         painter.setPen(QPen(QColor("#10b981"), 2));
         painter.drawLine(chartRect.left(), y, chartRect.right(), y);
@@ -130,16 +181,19 @@ void CustomChartWidget::paintEvent(QPaintEvent *event)
 
 void CustomChartWidget::updateChart()
 {
-    if (!m_dataPoints.isEmpty()) {
-        double lastPrice = m_dataPoints.last();
+    // Only the placeholder is animated; real ticks arrive via updateWithLiveData()
+    if (displayedSeries().size() >= 2) return;
+
+    if (!m_placeholder.isEmpty()) {
+        double lastPrice = m_placeholder.last();
         double variation = (QRandomGenerator::global()->bounded(100) - 50) * 0.1;
         double newPrice = lastPrice + variation;
         
         newPrice = qMax(lastPrice * 0.999, qMin(lastPrice * 1.001, newPrice));
         
-        m_dataPoints.append(newPrice);
-        if (m_dataPoints.size() > 50) {
-            m_dataPoints.removeFirst();
+        m_placeholder.append(newPrice);
+        if (m_placeholder.size() > MaxPlaceholderPoints) {
+            m_placeholder.removeFirst();
         }
         updateMinMax();
         update();
@@ -148,7 +202,7 @@ void CustomChartWidget::updateChart()
 
 void CustomChartWidget::generateRealisticData()
 {
-    m_dataPoints.clear();
+    m_placeholder.clear();
     
     QMap<QString, double> realPrices = {
         {"RELIANCE", 1486.90}, {"TCS", 3084.90}, {"INFY", 1789.45},
@@ -167,7 +221,7 @@ void CustomChartWidget::generateRealisticData()
     
     for (int i = 0; i < points; ++i) {
         double price = basePrice + (QRandomGenerator::global()->bounded(60) - 30) + std::sin(i * 0.2) * 15;
-        m_dataPoints.append(price);
+        m_placeholder.append(price);
     }
     
     updateMinMax();
@@ -175,12 +229,22 @@ void CustomChartWidget::generateRealisticData()
 
 void CustomChartWidget::updateMinMax()
 {
-    if (m_dataPoints.isEmpty()) return;
-    
-    m_minPrice = *std::min_element(m_dataPoints.begin(), m_dataPoints.end());
-    m_maxPrice = *std::max_element(m_dataPoints.begin(), m_dataPoints.end());
+    const TickStore::Series series = displayedSeries();
+    if (series.size() >= 2) {
+        // O(log n) over the pyramid, which extends by the new values only
+        m_lod.sync(series);
+        const SeriesLod::Extremes range = m_lod.extremes(series.price, firstVisible(series), series.size());
+        m_minPrice = range.min;
+        m_maxPrice = range.max;
+    } else {
+        if (m_placeholder.isEmpty()) return;
+        Kernels::minMax(m_placeholder.constData(), m_placeholder.size(), &m_minPrice, &m_maxPrice);
+    }
     
-    double padding = (m_maxPrice - m_minPrice) * 0.1;
+    // Flat prices (a quiet stock, an unchanged poll) still get a visible range
+    double padding = qMax((m_maxPrice - m_minPrice) * 0.1, qAbs(m_maxPrice) * 0.001);
+    if (padding <= 0)
+        padding = 1.0;
     m_minPrice -= padding;
     m_maxPrice += padding;
 }
@@ -0,0 +1,211 @@
+#include "DataPlane.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QHash>
+#include <QQueue>
+#include <QDebug>
+
+// Lives on the data-plane thread; owns the manager pool and per-host queues
+class DataPlaneWorker : public QObject
+{
+public:
+    using Started = std::function<void(QNetworkReply *reply)>;
+
+    explicit DataPlaneWorker(DataPlane *plane) : m_plane(plane) {}
+
+    void submit(QNetworkRequest request, const Started &started)
+    {
+        prepare(request);
+        const QString host = request.url().host();
+        HostState &state = m_hosts[host];
+        if (state.active >= m_maxPerHost) {
+            state.waiting.enqueue(Pending{request, started});
+            m_plane->m_queued.fetchAndAddRelaxed(1);
+            return;
+        }
+        start(host, request, started);
+    }
+
+    void preconnect(const QUrl &url)
+    {
+        QNetworkAccessManager *manager = managerFor(url.host());
+        if (url.scheme() == "https") {
+            manager->connectToHostEncrypted(url.host(), url.port(443));
+        } else {
+            manager->connectToHost(url.host(), url.port(80));
+        }
+    }
+
+    void setMaxPerHost(int maxPerHost) { m_maxPerHost = qMax(1, maxPerHost); }
+
+private:
+    struct Pending {
+        QNetworkRequest request;
+        Started started;
+    };
+
+    struct HostState {
+        int active = 0;
+        QQueue<Pending> waiting;
+    };
+
+    static void prepare(QNetworkRequest &request)
+    {
+        if (request.header(QNetworkRequest::UserAgentHeader).isNull()) {
+            request.setHeader(QNetworkRequest::UserAgentHeader,
+                              "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
+        }
+        request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+        // Kept for HTTP/1.1 servers; Qt drops connection headers on HTTP/2
+        request.setRawHeader("Connection", "keep-alive");
+        request.setTransferTimeout(15000);
+    }
+
+    // Each host always maps to the same manager so its connections are reused
+    QNetworkAccessManager *managerFor(const QString &host)
+    {
+        QNetworkAccessManager *&manager = m_pool[qHash(host) % DataPlane::PoolSize];
+        if (!manager) {
+            manager = new QNetworkAccessManager(this);
+        }
+        return manager;
+    }
+
+    void start(const QString &host, const QNetworkRequest &request, const Started &started)
+    {
+        ++m_hosts[host].active;
+        m_plane->m_issued.fetchAndAddRelaxed(1);
+
+        QNetworkReply *reply = managerFor(host)->get(request);
+        connect(reply, &QNetworkReply::finished, this, [this, host, reply]() {
+            if (reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool()) {
+                m_plane->m_http2.fetchAndAddRelaxed(1);
+            }
+            release(host);
+        });
+        started(reply);
+    }
+
+    void release(const QString &host)
+    {
+        HostState &state = m_hosts[host];
+        --state.active;
+        if (!state.waiting.isEmpty() && state.active < m_maxPerHost) {
+            const Pending next = state.waiting.dequeue();
+            start(host, next.request, next.started);
+        }
+    }
+
+    DataPlane *m_plane;
+    QNetworkAccessManager *m_pool[DataPlane::PoolSize] = {};
+    QHash<QString, HostState> m_hosts;
+    int m_maxPerHost = DataPlane::DefaultMaxPerHost;
+};
+
+DataPlane *DataPlane::instance()
+{
+    static DataPlane *plane = new DataPlane(QCoreApplication::instance());
+    return plane;
+}
+
+DataPlane::DataPlane(QObject *parent) : QObject(parent),
+    m_deliveries(0), m_guiNanos(0), m_decodeNanos(0),
+    m_issued(0), m_queued(0), m_http2(0)
+{
+    m_thread = new QThread(this);
+    m_thread->setObjectName("StockSenseDataPlane");
+
+    m_worker = new DataPlaneWorker(this);
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &DataPlane::shutdown);
+    }
+
+    m_thread->start();
+    qDebug() << "✅ Data plane thread started";
+}
+
+DataPlane::~DataPlane()
+{
+    shutdown();
+}
+
+void DataPlane::shutdown()
+{
+    if (m_thread->isRunning()) {
+        m_thread->quit();
+        m_thread->wait();
+    }
+}
+
+void DataPlane::get(const QNetworkRequest &request, QObject *context,
+                    Decoder decode, ErrorHandler onError)
+{
+    QPointer<QObject> guard(context);
+
+    QMetaObject::invokeMethod(m_worker, [this, request, guard, decode, onError]() {
+        m_worker->submit(request, [this, guard, decode, onError](QNetworkReply *reply) {
+            connect(reply, &QNetworkReply::finished, reply, [this, reply, guard, decode, onError]() {
+                reply->deleteLater();
+
+                if (reply->error() != QNetworkReply::NoError) {
+                    if (onError) {
+                        const QString error = reply->errorString();
+                        relay(guard, [onError, error]() { onError(error); });
+                    }
+                    return;
+                }
+
+                QElapsedTimer decodeTimer;
+                decodeTimer.start();
+                Delivery delivery = decode(reply->readAll());
+                m_decodeNanos.fetchAndAddRelaxed(decodeTimer.nsecsElapsed());
+
+                if (!delivery) return;
+
+                relay(guard, [this, delivery]() {
+                    QElapsedTimer guiTimer;
+                    guiTimer.start();
+                    delivery();
+                    m_guiNanos.fetchAndAddRelaxed(guiTimer.nsecsElapsed());
+                    m_deliveries.fetchAndAddRelaxed(1);
+                });
+            });
+        });
+    }, Qt::QueuedConnection);
+}
+
+void DataPlane::relay(const QPointer<QObject> &guard, std::function<void()> fn)
+{
+    QMetaObject::invokeMethod(this, [guard, fn]() {
+        if (!guard.isNull()) fn();
+    }, Qt::QueuedConnection);
+}
+
+void DataPlane::preconnect(const QUrl &url)
+{
+    QMetaObject::invokeMethod(m_worker, [this, url]() { m_worker->preconnect(url); },
+                              Qt::QueuedConnection);
+}
+
+void DataPlane::setMaxPerHost(int maxPerHost)
+{
+    QMetaObject::invokeMethod(m_worker, [this, maxPerHost]() { m_worker->setMaxPerHost(maxPerHost); },
+                              Qt::QueuedConnection);
+}
+
+DataPlane::Stats DataPlane::takeStats()
+{
+    Stats stats;
+    stats.deliveries = m_deliveries.fetchAndStoreRelaxed(0);
+    stats.guiNanos = m_guiNanos.fetchAndStoreRelaxed(0);
+    stats.decodeNanos = m_decodeNanos.fetchAndStoreRelaxed(0);
+    stats.issued = m_issued.fetchAndStoreRelaxed(0);
+    stats.queued = m_queued.fetchAndStoreRelaxed(0);
+    stats.http2 = m_http2.fetchAndStoreRelaxed(0);
+    return stats;
+}
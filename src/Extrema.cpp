@@ -0,0 +1,230 @@
+#include "Extrema.h"
+#include <limits>
+
+RollingExtrema::RollingExtrema(int window) : m_window(qMax(1, window))
+{
+    m_values.resize(m_window);
+    m_min.slots.resize(m_window);
+    m_max.slots.resize(m_window);
+}
+
+void RollingExtrema::reset()
+{
+    m_count = 0;
+    m_next = 0;
+    m_min.head = m_min.size = 0;
+    m_max.head = m_max.size = 0;
+    m_minDisplaced = m_maxDisplaced = 0;
+}
+
+int RollingExtrema::admit(Deque &deque, const Entry &entry, bool keepLarger)
+{
+    int displaced = 0;
+    while (deque.size > 0) {
+        const double tail = deque.back().value;
+        if (keepLarger ? tail > entry.value : tail < entry.value)
+            break;
+        deque.popBack();
+        ++displaced;
+    }
+    deque.pushBack(entry);
+    return displaced;
+}
+
+void RollingExtrema::push(double value)
+{
+    const quint64 index = m_count;
+    m_values[m_next] = value;
+    if (++m_next == m_window)
+        m_next = 0;
+    ++m_count;
+
+    // Drop the index that just left the window
+    if (index >= static_cast<quint64>(m_window)) {
+        const quint64 expired = index - m_window;
+        if (m_min.size > 0 && m_min.front().index == expired) m_min.popFront();
+        if (m_max.size > 0 && m_max.front().index == expired) m_max.popFront();
+    }
+
+    const Entry entry{index, value};
+    m_minDisplaced = admit(m_min, entry, false);
+    m_maxDisplaced = admit(m_max, entry, true);
+}
+
+int RollingExtrema::rewrite(Deque &deque, const Entry &entry, double oldValue, int displaced, bool keepLarger)
+{
+    // The newest index is always at the back
+    deque.popBack();
+
+    const bool moreExtreme = keepLarger ? entry.value >= oldValue : entry.value <= oldValue;
+    if (moreExtreme || displaced == 0) {
+        // Whatever the old value displaced, the new one would displace too;
+        // keep counting from the state before the original push
+        return displaced + admit(deque, entry, keepLarger);
+    }
+
+    // Entries between the surviving back and the newest index were
+    // displaced by the old value and may matter again; replay them
+    const quint64 index = entry.index;
+    const quint64 windowStart = index + 1 > static_cast<quint64>(m_window) ? index + 1 - m_window : 0;
+    quint64 from = deque.size > 0 ? deque.back().index + 1 : windowStart;
+    from = qMax(from, windowStart);
+    for (quint64 i = from; i < index; ++i)
+        admit(deque, Entry{i, m_values[static_cast<int>(i % m_window)]}, keepLarger);
+    return admit(deque, entry, keepLarger);
+}
+
+void RollingExtrema::replaceLast(double value)
+{
+    if (isEmpty()) {
+        push(value);
+        return;
+    }
+    const int slot = (m_next == 0 ? m_window : m_next) - 1;
+    const double old = m_values[slot];
+    m_values[slot] = value;
+    const Entry entry{m_count - 1, value};
+    m_minDisplaced = rewrite(m_min, entry, old, m_minDisplaced, false);
+    m_maxDisplaced = rewrite(m_max, entry, old, m_maxDisplaced, true);
+}
+
+void RollingExtrema::assign(const double *values, int n)
+{
+    reset();
+    if (n <= 0)
+        return;
+
+    // Only indices [n - window, n) can be in the deques at the end; all but
+    // the newest go in directly and the newest through push(), so that
+    // replaceLast() has its displacement counts
+    const int first = qMax(0, n - m_window);
+    int slot = first % m_window;
+    for (int i = first; i < n - 1; ++i) {
+        m_values[slot] = values[i];
+        if (++slot == m_window)
+            slot = 0;
+    }
+
+    // Strict suffix minima and maxima, filled from the back of each ring
+    double low = std::numeric_limits<double>::infinity();
+    double high = -std::numeric_limits<double>::infinity();
+    for (int i = n - 2; i >= first; --i) {
+        if (values[i] < low) {
+            low = values[i];
+            m_min.slots[m_window - 1 - m_min.size++] = Entry{static_cast<quint64>(i), low};
+        }
+        if (values[i] > high) {
+            high = values[i];
+            m_max.slots[m_window - 1 - m_max.size++] = Entry{static_cast<quint64>(i), high};
+        }
+    }
+    m_min.head = m_min.wrap(m_window - m_min.size);
+    m_max.head = m_max.wrap(m_window - m_max.size);
+
+    m_count = static_cast<quint64>(n - 1);
+    m_next = slot;
+    push(values[n - 1]);
+}
+
+PivotDetector::PivotDetector(int strength, int keep)
+    : m_strength(qMax(1, strength)), m_keep(qMax(1, keep)), m_span(2 * m_strength + 1)
+{
+    m_recent.resize(2 * m_span);
+    m_support.reserve(m_keep + 1);
+    m_resistance.reserve(m_keep + 1);
+}
+
+void PivotDetector::reset()
+{
+    m_count = 0;
+    m_next = 0;
+    m_support.clear();
+    m_resistance.clear();
+    m_lastPivot = Pivot::None;
+    m_lastDropped = false;
+}
+
+PivotDetector::Pivot PivotDetector::classify() const
+{
+    if (m_count < static_cast<quint64>(m_span))
+        return Pivot::None;
+
+    const double *values = newest();
+    const double centre = values[m_strength];
+    bool high = true, low = true;
+    for (int k = 0; k < m_span && (high || low); ++k) {
+        if (k == m_strength) continue;
+        high = high && centre > values[k];
+        low = low && centre < values[k];
+    }
+    return high ? Pivot::High : low ? Pivot::Low : Pivot::None;
+}
+
+void PivotDetector::confirm()
+{
+    m_lastPivot = classify();
+    m_lastDropped = false;
+    if (m_lastPivot == Pivot::None)
+        return;
+
+    const double centre = newest()[m_strength];
+    QVector<double> &levels = m_lastPivot == Pivot::High ? m_resistance : m_support;
+    levels.prepend(centre);
+    if (levels.size() > m_keep) {
+        m_dropped = levels.takeLast();
+        m_lastDropped = true;
+    }
+}
+
+void PivotDetector::undoConfirm()
+{
+    if (m_lastPivot == Pivot::None)
+        return;
+    QVector<double> &levels = m_lastPivot == Pivot::High ? m_resistance : m_support;
+    levels.removeFirst();
+    if (m_lastDropped)
+        levels.append(m_dropped);
+    m_lastPivot = Pivot::None;
+    m_lastDropped = false;
+}
+
+void PivotDetector::push(double value)
+{
+    m_recent[m_next] = m_recent[m_next + m_span] = value;
+    if (++m_next == m_span)
+        m_next = 0;
+    ++m_count;
+    confirm();
+}
+
+int PivotDetector::replayStart(const double *values, int n) const
+{
+    // Centre of the keep + 1 newest confirmed pivots of each kind (one more
+    // than is kept, so the newest push drops what a full replay would)
+    int highs = 0, lows = 0;
+    for (int c = n - 1 - m_strength; c >= m_strength; --c) {
+        bool high = true, low = true;
+        for (int k = c - m_strength; k <= c + m_strength && (high || low); ++k) {
+            if (k == c) continue;
+            high = high && values[c] > values[k];
+            low = low && values[c] < values[k];
+        }
+        highs += high;
+        lows += low;
+        if (highs > m_keep && lows > m_keep)
+            return c - m_strength;
+    }
+    return 0;
+}
+
+void PivotDetector::replaceLast(double value)
+{
+    if (m_count == 0) {
+        push(value);
+        return;
+    }
+    undoConfirm();
+    const int slot = (m_next == 0 ? m_span : m_next) - 1;
+    m_recent[slot] = m_recent[slot + m_span] = value;
+    confirm();
+}
@@ -0,0 +1,117 @@
+#include "IndexFeed.h"
+#include "DataPlane.h"
+#include "MarketStatusChecker.h"
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QUrlQuery>
+#include <QDebug>
+
+IndexFeed::IndexFeed(MarketStatusChecker *marketChecker, QObject *parent) : QObject(parent),
+    m_marketChecker(marketChecker)
+{
+    const QString endpoint = qEnvironmentVariable("STOCKSENSE_CHART_ENDPOINT");
+    m_chartEndpoint = QUrl(endpoint.isEmpty() ? QStringLiteral("https://query1.finance.yahoo.com/v8/finance/chart/")
+                                              : endpoint);
+
+    subscribe("^NSEI");    // NIFTY 50
+    subscribe("^BSESN");   // SENSEX
+
+    m_timer = new QTimer(this);
+    connect(m_timer, &QTimer::timeout, this, &IndexFeed::refresh);
+    if (m_marketChecker) {
+        connect(m_marketChecker, &MarketStatusChecker::marketStatusChanged,
+                this, &IndexFeed::adjustInterval);
+    }
+    adjustInterval();
+
+    refresh();
+    qDebug() << "✅ Index feed initialized for" << m_indexIds.size() << "indices";
+}
+
+void IndexFeed::subscribe(const QString &yahooSymbol)
+{
+    const quint32 symbolId = SymbolRegistry::instance().intern(yahooSymbol);
+    if (!m_indexIds.contains(symbolId)) {
+        m_indexIds.append(symbolId);
+    }
+}
+
+void IndexFeed::setChartEndpoint(const QUrl &endpoint)
+{
+    if (endpoint.isValid()) {
+        m_chartEndpoint = endpoint;
+    }
+}
+
+void IndexFeed::adjustInterval()
+{
+    const bool marketOpen = m_marketChecker && m_marketChecker->isMarketOpen();
+    m_timer->start(marketOpen ? 5000 : 60000);
+}
+
+void IndexFeed::refresh()
+{
+    // A slow reply is joined rather than duplicated
+    if (m_inFlight > 0 || m_indexIds.isEmpty())
+        return;
+
+    const bool marketOpen = m_marketChecker && m_marketChecker->isMarketOpen();
+    m_inFlight = m_indexIds.size();
+
+    for (quint32 symbolId : m_indexIds) {
+        QUrl url(m_chartEndpoint.toString() + SymbolRegistry::instance().yahooSymbol(symbolId));
+        QUrlQuery query;
+        query.addQueryItem("range", "1d");
+        query.addQueryItem("interval", "1d");
+        url.setQuery(query);
+
+        QNetworkRequest request(url);
+        request.setHeader(QNetworkRequest::UserAgentHeader,
+                         "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
+        request.setRawHeader("Accept", "application/json");
+
+        DataPlane::instance()->fetch(request, this,
+            [symbolId, marketOpen](const QByteArray &data) {
+                return parseIndexQuote(QJsonDocument::fromJson(data).object(), symbolId, marketOpen);
+            },
+            [this](const Quote &quote) {
+                --m_inFlight;
+                if (!quote.isValid()) return;
+                m_latest[quote.symbolId] = quote;
+                emit indexUpdated(quote);
+                qDebug() << "📈" << SymbolRegistry::instance().name(quote.symbolId) << quote.price
+                         << "(" << quote.change << ")";
+            },
+            [this, symbolId](const QString &error) {
+                // Consumers keep showing the last good level until the next interval
+                --m_inFlight;
+                qWarning() << "❌ Failed to fetch" << SymbolRegistry::instance().name(symbolId) << ":" << error;
+            });
+    }
+}
+
+Quote IndexFeed::parseIndexQuote(const QJsonObject &response, quint32 symbolId, bool marketOpen)
+{
+    const QJsonArray results = response["chart"].toObject()["result"].toArray();
+    if (results.isEmpty()) return Quote();
+
+    const QJsonObject meta = results[0].toObject()["meta"].toObject();
+    const double price = meta["regularMarketPrice"].toDouble();
+    if (price <= 0) return Quote();
+
+    // range=1d meta carries chartPreviousClose; previousClose is not always present
+    const double previousClose = meta.contains("previousClose") ? meta["previousClose"].toDouble()
+                                                                : meta["chartPreviousClose"].toDouble();
+    const qint64 marketTime = static_cast<qint64>(meta["regularMarketTime"].toDouble());
+
+    Quote quote;
+    quote.symbolId = symbolId;
+    quote.price = price;
+    quote.change = price - previousClose;
+    quote.changePercent = previousClose > 0 ? (quote.change / previousClose) * 100 : 0;
+    quote.high = meta["regularMarketDayHigh"].toDouble();
+    quote.low = meta["regularMarketDayLow"].toDouble();
+    quote.timestampNs = marketTime > 0 ? marketTime * 1000000000LL : Quote::nowNs();
+    quote.source = marketOpen ? Quote::Source::LiveYahoo : Quote::Source::YahooLastClose;
+    return quote;
+}
@@ -0,0 +1,86 @@
+#include "IndicatorEngine.h"
+
+IndicatorEngine::IndicatorEngine() : IndicatorEngine(Config())
+{
+}
+
+IndicatorEngine::IndicatorEngine(const Config &config) : m_config(config)
+{
+    m_config.smaWindow = qMax(1, m_config.smaWindow);
+    m_config.emaWindow = qMax(1, m_config.emaWindow);
+    m_config.rsiWindow = qMax(1, m_config.rsiWindow);
+    m_config.bollingerWindow = qMax(1, m_config.bollingerWindow);
+    m_window.resize(qMax(m_config.smaWindow, m_config.bollingerWindow));
+}
+
+void IndicatorEngine::reset()
+{
+    m_state = State();
+    m_previous = State();
+    m_overwritten = 0.0;
+    m_window.fill(0.0);
+}
+
+IndicatorPipeline::RuntimeWindows IndicatorEngine::windows() const
+{
+    return IndicatorPipeline::RuntimeWindows{{m_config.smaWindow}, {m_config.emaWindow},
+                                             {m_config.rsiWindow}, {m_config.bollingerWindow}};
+}
+
+void IndicatorEngine::append(double price)
+{
+    m_previous = m_state;
+    const quint64 n = m_state.count;
+    const int slot = static_cast<int>(n % m_window.size());
+    m_overwritten = m_window[slot];
+
+    const quint64 smaWindow = static_cast<quint64>(m_config.smaWindow);
+    const quint64 bbWindow = static_cast<quint64>(m_config.bollingerWindow);
+    IndicatorPipeline::step<false>(m_state, windows(), price,
+                                   n >= smaWindow ? windowValue(n - smaWindow) : 0.0,
+                                   n >= bbWindow ? windowValue(n - bbWindow) : 0.0);
+    m_window[slot] = price;
+}
+
+void IndicatorEngine::replaceLast(double price)
+{
+    if (m_state.count == 0) {
+        append(price);
+        return;
+    }
+    m_window[static_cast<int>((m_state.count - 1) % m_window.size())] = m_overwritten;
+    m_state = m_previous;
+    append(price);
+}
+
+IndicatorEngine IndicatorEngine::compute(const PriceSpan &prices)
+{
+    return compute(prices, Config());
+}
+
+IndicatorEngine IndicatorEngine::compute(const PriceSpan &prices, const Config &config)
+{
+    return compute(prices, config, prices.size(), [](int, double) {});
+}
+
+void IndicatorEngine::fillWindow(const PriceSpan &prices, int end)
+{
+    const int span = m_window.size();
+    for (int i = qMax(0, end - span); i < end; ++i)
+        m_window[i % span] = prices[i];
+}
+
+double IndicatorEngine::sma() const
+{
+    return IndicatorPipeline::smaFrom(m_state, m_config.smaWindow);
+}
+
+double IndicatorEngine::rsi() const
+{
+    return IndicatorPipeline::rsiFrom(m_state.avgGain, m_state.avgLoss, m_state.count);
+}
+
+double IndicatorEngine::stdDev() const
+{
+    return IndicatorPipeline::stdDevFrom(m_state, m_config.bollingerWindow);
+}
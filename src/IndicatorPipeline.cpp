@@ -0,0 +1,40 @@
+#include "IndicatorPipeline.h"
+
+namespace IndicatorPipeline
+{
+    double sma(const double *closes, int n, int window)
+    {
+        switch (window) {
+        case 10: return sma(closes, n, Window<10>());
+        case 20: return sma(closes, n, Window<20>());
+        case 50: return sma(closes, n, Window<50>());
+        case 200: return sma(closes, n, Window<200>());
+        default: return sma(closes, n, DynamicWindow{qMax(1, window)});
+        }
+    }
+
+    double ema(const double *closes, int n, int window)
+    {
+        switch (window) {
+        case 12: return ema(closes, n, Window<12>());
+        case 26: return ema(closes, n, Window<26>());
+        default: return ema(closes, n, DynamicWindow{qMax(1, window)});
+        }
+    }
+
+    double rsi(const double *closes, int n, int window)
+    {
+        switch (window) {
+        case 14: return rsi(closes, n, Window<14>());
+        default: return rsi(closes, n, DynamicWindow{qMax(1, window)});
+        }
+    }
+
+    Bands bollinger(const double *closes, int n, int window)
+    {
+        switch (window) {
+        case 20: return bollinger(closes, n, Window<20>());
+        default: return bollinger(closes, n, DynamicWindow{qMax(1, window)});
+        }
+    }
+}
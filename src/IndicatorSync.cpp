@@ -0,0 +1,74 @@
+#include "IndicatorSync.h"
+
+IndicatorSync::IndicatorSync() : IndicatorSync(Config())
+{
+}
+
+IndicatorSync::IndicatorSync(const Config &config)
+    : m_config(config),
+      m_engine(config.indicators),
+      m_range(config.rangeWindow),
+      m_pivots(config.pivotStrength, config.pivotLevels),
+      m_trend(config.trendWindow)
+{
+}
+
+void IndicatorSync::sync(const TickStore::Series &series)
+{
+    const quint64 added = series.appended - m_appended;
+
+    if (m_appended == 0 || m_generation != series.generation ||
+        series.appended < m_appended || added >= static_cast<quint64>(series.size()))
+    {
+        // First sight of the series, or it was reloaded
+        load(series.price);
+    }
+    else
+    {
+        // The value consumed last may have been rewritten (a forming bar), then new ones follow
+        const int lastSeen = series.size() - 1 - static_cast<int>(added);
+        if (series.price[lastSeen] != m_lastPrice)
+            replaceLast(series.price[lastSeen]);
+        for (int i = lastSeen + 1; i < series.size(); ++i)
+            push(series.price[i]);
+    }
+
+    m_generation = series.generation;
+    m_appended = series.appended;
+    m_lastPrice = series.isEmpty() ? 0.0 : series.price.last();
+}
+
+void IndicatorSync::load(const PriceSpan &prices)
+{
+    // The pivots and the trend line only need the closes from where their
+    // replay starts; they ride along in the indicator pass from there
+    const int n = prices.size();
+    const int pivotFrom = m_pivots.replayStart(prices.begin(), n);
+    const int trendFrom = n - m_trend.window();
+    m_range.assign(prices.begin(), n);
+    m_pivots.reset();
+    m_trend.reset();
+    m_engine = IndicatorEngine::compute(prices, m_config.indicators, qMin(pivotFrom, qMax(0, trendFrom)),
+                                        [&](int i, double price) {
+        if (i >= pivotFrom)
+            m_pivots.push(price);
+        if (i >= trendFrom)
+            m_trend.push(price);
+    });
+}
+
+void IndicatorSync::push(double price)
+{
+    m_engine.append(price);
+    m_range.push(price);
+    m_pivots.push(price);
+    m_trend.push(price);
+}
+
+void IndicatorSync::replaceLast(double price)
+{
+    m_engine.replaceLast(price);
+    m_range.replaceLast(price);
+    m_pivots.replaceLast(price);
+    m_trend.replaceLast(price);
+}
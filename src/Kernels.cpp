@@ -0,0 +1,604 @@
+#include "Kernels.h"
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define KERNELS_TARGET_SSE2
+#define KERNELS_TARGET_AVX2
+#else
+#define KERNELS_TARGET_SSE2 __attribute__((target("sse2")))
+#define KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define KERNELS_X86 0
+#endif
+
+namespace
+{
+    struct Table {
+        double (*sum)(const double *, int);
+        double (*dot)(const double *, const double *, int);
+        void (*minMax)(const double *, int, double *, double *);
+        double (*sumSquaredDeviation)(const double *, int, double);
+        double (*sumReturns)(const double *, int);
+        double (*sumSquaredReturnDeviation)(const double *, int, double);
+        void (*returns)(const double *, int, double *);
+        Kernels::LinearSums (*linearSums)(const double *, int);
+        void (*emaScan)(const double *, int, double, double, double *);
+    };
+
+    // ---- Scalar reference -------------------------------------------------
+
+    double scalarSum(const double *x, int n)
+    {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) s += x[i];
+        return s;
+    }
+
+    double scalarDot(const double *a, const double *b, int n)
+    {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) s += a[i] * b[i];
+        return s;
+    }
+
+    void scalarMinMax(const double *x, int n, double *min, double *max)
+    {
+        double lo = x[0], hi = x[0];
+        for (int i = 1; i < n; ++i) {
+            lo = x[i] < lo ? x[i] : lo;
+            hi = x[i] > hi ? x[i] : hi;
+        }
+        *min = lo;
+        *max = hi;
+    }
+
+    double scalarSumSquaredDeviation(const double *x, int n, double mean)
+    {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) s += (x[i] - mean) * (x[i] - mean);
+        return s;
+    }
+
+    // The return kernels take the price count n and walk the n - 1 returns
+    double scalarSumReturns(const double *p, int n)
+    {
+        double s = 0.0;
+        for (int i = 1; i < n; ++i) s += (p[i] - p[i - 1]) / p[i - 1];
+        return s;
+    }
+
+    double scalarSumSquaredReturnDeviation(const double *p, int n, double mean)
+    {
+        double s = 0.0;
+        for (int i = 1; i < n; ++i) {
+            const double d = (p[i] - p[i - 1]) / p[i - 1] - mean;
+            s += d * d;
+        }
+        return s;
+    }
+
+    void scalarReturns(const double *p, int n, double *out)
+    {
+        for (int i = 1; i < n; ++i) out[i - 1] = (p[i] - p[i - 1]) / p[i - 1];
+    }
+
+    Kernels::LinearSums scalarLinearSums(const double *y, int n)
+    {
+        Kernels::LinearSums s;
+        for (int i = 0; i < n; ++i) {
+            s.sumY += y[i];
+            s.sumXY += i * y[i];
+            s.sumYY += y[i] * y[i];
+        }
+        return s;
+    }
+
+    void scalarEmaScan(const double *x, int n, double alpha, double seed, double *out)
+    {
+        const double decay = 1.0 - alpha;
+        double y = seed;
+        for (int i = 0; i < n; ++i) {
+            y = alpha * x[i] + decay * y;
+            out[i] = y;
+        }
+    }
+
+    const Table ScalarTable = {
+        scalarSum, scalarDot, scalarMinMax, scalarSumSquaredDeviation, scalarSumReturns,
+        scalarSumSquaredReturnDeviation, scalarReturns, scalarLinearSums, scalarEmaScan,
+    };
+
+#if KERNELS_X86
+    // ---- SSE2, two lanes --------------------------------------------------
+
+    KERNELS_TARGET_SSE2 double hsum2(__m128d v)
+    {
+        return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+    }
+
+    KERNELS_TARGET_SSE2 double sse2Sum(const double *x, int n)
+    {
+        __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            a = _mm_add_pd(a, _mm_loadu_pd(x + i));
+            b = _mm_add_pd(b, _mm_loadu_pd(x + i + 2));
+        }
+        double s = hsum2(_mm_add_pd(a, b));
+        for (; i < n; ++i) s += x[i];
+        return s;
+    }
+
+    KERNELS_TARGET_SSE2 double sse2Dot(const double *x, const double *y, int n)
+    {
+        __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            a = _mm_add_pd(a, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+            b = _mm_add_pd(b, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+        }
+        double s = hsum2(_mm_add_pd(a, b));
+        for (; i < n; ++i) s += x[i] * y[i];
+        return s;
+    }
+
+    KERNELS_TARGET_SSE2 void sse2MinMax(const double *x, int n, double *min, double *max)
+    {
+        __m128d lo = _mm_set1_pd(x[0]), hi = lo;
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d v = _mm_loadu_pd(x + i);
+            lo = _mm_min_pd(lo, v);
+            hi = _mm_max_pd(hi, v);
+        }
+        lo = _mm_min_sd(lo, _mm_unpackhi_pd(lo, lo));
+        hi = _mm_max_sd(hi, _mm_unpackhi_pd(hi, hi));
+        double l = _mm_cvtsd_f64(lo), h = _mm_cvtsd_f64(hi);
+        for (; i < n; ++i) {
+            l = x[i] < l ? x[i] : l;
+            h = x[i] > h ? x[i] : h;
+        }
+        *min = l;
+        *max = h;
+    }
+
+    KERNELS_TARGET_SSE2 double sse2SumSquaredDeviation(const double *x, int n, double mean)
+    {
+        const __m128d m = _mm_set1_pd(mean);
+        __m128d a = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d d = _mm_sub_pd(_mm_loadu_pd(x + i), m);
+            a = _mm_add_pd(a, _mm_mul_pd(d, d));
+        }
+        double s = hsum2(a);
+        for (; i < n; ++i) s += (x[i] - mean) * (x[i] - mean);
+        return s;
+    }
+
+    KERNELS_TARGET_SSE2 double sse2SumReturns(const double *p, int n)
+    {
+        __m128d a = _mm_setzero_pd();
+        int i = 1;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d prev = _mm_loadu_pd(p + i - 1);
+            a = _mm_add_pd(a, _mm_div_pd(_mm_sub_pd(_mm_loadu_pd(p + i), prev), prev));
+        }
+        double s = hsum2(a);
+        for (; i < n; ++i) s += (p[i] - p[i - 1]) / p[i - 1];
+        return s;
+    }
+
+    KERNELS_TARGET_SSE2 double sse2SumSquaredReturnDeviation(const double *p, int n, double mean)
+    {
+        const __m128d m = _mm_set1_pd(mean);
+        __m128d a = _mm_setzero_pd();
+        int i = 1;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d prev = _mm_loadu_pd(p + i - 1);
+            const __m128d d = _mm_sub_pd(_mm_div_pd(_mm_sub_pd(_mm_loadu_pd(p + i), prev), prev), m);
+            a = _mm_add_pd(a, _mm_mul_pd(d, d));
+        }
+        double s = hsum2(a);
+        for (; i < n; ++i) {
+            const double d = (p[i] - p[i - 1]) / p[i - 1] - mean;
+            s += d * d;
+        }
+        return s;
+    }
+
+    KERNELS_TARGET_SSE2 void sse2Returns(const double *p, int n, double *out)
+    {
+        int i = 1;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d prev = _mm_loadu_pd(p + i - 1);
+            _mm_storeu_pd(out + i - 1, _mm_div_pd(_mm_sub_pd(_mm_loadu_pd(p + i), prev), prev));
+        }
+        for (; i < n; ++i) out[i - 1] = (p[i] - p[i - 1]) / p[i - 1];
+    }
+
+    KERNELS_TARGET_SSE2 Kernels::LinearSums sse2LinearSums(const double *y, int n)
+    {
+        __m128d sy = _mm_setzero_pd(), sxy = _mm_setzero_pd(), syy = _mm_setzero_pd();
+        __m128d x = _mm_set_pd(1.0, 0.0);
+        const __m128d step = _mm_set1_pd(2.0);
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d v = _mm_loadu_pd(y + i);
+            sy = _mm_add_pd(sy, v);
+            sxy = _mm_add_pd(sxy, _mm_mul_pd(x, v));
+            syy = _mm_add_pd(syy, _mm_mul_pd(v, v));
+            x = _mm_add_pd(x, step);
+        }
+        Kernels::LinearSums s{hsum2(sy), hsum2(sxy), hsum2(syy)};
+        for (; i < n; ++i) {
+            s.sumY += y[i];
+            s.sumXY += i * y[i];
+            s.sumYY += y[i] * y[i];
+        }
+        return s;
+    }
+
+    // Two-lane scan: s = v + d*[0, v0], then y = s + [d, d^2] * previous
+    KERNELS_TARGET_SSE2 void sse2EmaScan(const double *x, int n, double alpha, double seed, double *out)
+    {
+        const double decay = 1.0 - alpha;
+        const __m128d a = _mm_set1_pd(alpha), d = _mm_set1_pd(decay);
+        const __m128d carry = _mm_set_pd(decay * decay, decay);
+        __m128d prev = _mm_set1_pd(seed);
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d v = _mm_mul_pd(a, _mm_loadu_pd(x + i));
+            const __m128d s = _mm_add_pd(v, _mm_mul_pd(d, _mm_unpacklo_pd(_mm_setzero_pd(), v)));
+            const __m128d y = _mm_add_pd(s, _mm_mul_pd(carry, prev));
+            _mm_storeu_pd(out + i, y);
+            prev = _mm_unpackhi_pd(y, y);
+        }
+        double y = _mm_cvtsd_f64(prev);
+        for (; i < n; ++i) {
+            y = alpha * x[i] + decay * y;
+            out[i] = y;
+        }
+    }
+
+    const Table Sse2Table = {
+        sse2Sum, sse2Dot, sse2MinMax, sse2SumSquaredDeviation, sse2SumReturns,
+        sse2SumSquaredReturnDeviation, sse2Returns, sse2LinearSums, sse2EmaScan,
+    };
+
+    // ---- AVX2, four lanes -------------------------------------------------
+
+    KERNELS_TARGET_AVX2 double hsum4(__m256d v)
+    {
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+
+    KERNELS_TARGET_AVX2 double avx2Sum(const double *x, int n)
+    {
+        __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            a = _mm256_add_pd(a, _mm256_loadu_pd(x + i));
+            b = _mm256_add_pd(b, _mm256_loadu_pd(x + i + 4));
+        }
+        double s = hsum4(_mm256_add_pd(a, b));
+        for (; i < n; ++i) s += x[i];
+        return s;
+    }
+
+    KERNELS_TARGET_AVX2 double avx2Dot(const double *x, const double *y, int n)
+    {
+        __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            a = _mm256_add_pd(a, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+            b = _mm256_add_pd(b, _mm256_mul_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+        }
+        double s = hsum4(_mm256_add_pd(a, b));
+        for (; i < n; ++i) s += x[i] * y[i];
+        return s;
+    }
+
+    KERNELS_TARGET_AVX2 void avx2MinMax(const double *x, int n, double *min, double *max)
+    {
+        __m256d lo = _mm256_set1_pd(x[0]), hi = lo;
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d v = _mm256_loadu_pd(x + i);
+            lo = _mm256_min_pd(lo, v);
+            hi = _mm256_max_pd(hi, v);
+        }
+        __m128d l2 = _mm_min_pd(_mm256_castpd256_pd128(lo), _mm256_extractf128_pd(lo, 1));
+        __m128d h2 = _mm_max_pd(_mm256_castpd256_pd128(hi), _mm256_extractf128_pd(hi, 1));
+        l2 = _mm_min_sd(l2, _mm_unpackhi_pd(l2, l2));
+        h2 = _mm_max_sd(h2, _mm_unpackhi_pd(h2, h2));
+        double l = _mm_cvtsd_f64(l2), h = _mm_cvtsd_f64(h2);
+        for (; i < n; ++i) {
+            l = x[i] < l ? x[i] : l;
+            h = x[i] > h ? x[i] : h;
+        }
+        *min = l;
+        *max = h;
+    }
+
+    KERNELS_TARGET_AVX2 double avx2SumSquaredDeviation(const double *x, int n, double mean)
+    {
+        const __m256d m = _mm256_set1_pd(mean);
+        __m256d a = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d d = _mm256_sub_pd(_mm256_loadu_pd(x + i), m);
+            a = _mm256_add_pd(a, _mm256_mul_pd(d, d));
+        }
+        double s = hsum4(a);
+        for (; i < n; ++i) s += (x[i] - mean) * (x[i] - mean);
+        return s;
+    }
+
+    KERNELS_TARGET_AVX2 double avx2SumReturns(const double *p, int n)
+    {
+        __m256d a = _mm256_setzero_pd();
+        int i = 1;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d prev = _mm256_loadu_pd(p + i - 1);
+            a = _mm256_add_pd(a, _mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(p + i), prev), prev));
+        }
+        double s = hsum4(a);
+        for (; i < n; ++i) s += (p[i] - p[i - 1]) / p[i - 1];
+        return s;
+    }
+
+    KERNELS_TARGET_AVX2 double avx2SumSquaredReturnDeviation(const double *p, int n, double mean)
+    {
+        const __m256d m = _mm256_set1_pd(mean);
+        __m256d a = _mm256_setzero_pd();
+        int i = 1;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d prev = _mm256_loadu_pd(p + i - 1);
+            const __m256d d = _mm256_sub_pd(_mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(p + i), prev), prev), m);
+            a = _mm256_add_pd(a, _mm256_mul_pd(d, d));
+        }
+        double s = hsum4(a);
+        for (; i < n; ++i) {
+            const double d = (p[i] - p[i - 1]) / p[i - 1] - mean;
+            s += d * d;
+        }
+        return s;
+    }
+
+    KERNELS_TARGET_AVX2 void avx2Returns(const double *p, int n, double *out)
+    {
+        int i = 1;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d prev = _mm256_loadu_pd(p + i - 1);
+            _mm256_storeu_pd(out + i - 1, _mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(p + i), prev), prev));
+        }
+        for (; i < n; ++i) out[i - 1] = (p[i] - p[i - 1]) / p[i - 1];
+    }
+
+    KERNELS_TARGET_AVX2 Kernels::LinearSums avx2LinearSums(const double *y, int n)
+    {
+        __m256d sy = _mm256_setzero_pd(), sxy = _mm256_setzero_pd(), syy = _mm256_setzero_pd();
+        __m256d x = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+        const __m256d step = _mm256_set1_pd(4.0);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d v = _mm256_loadu_pd(y + i);
+            sy = _mm256_add_pd(sy, v);
+            sxy = _mm256_add_pd(sxy, _mm256_mul_pd(x, v));
+            syy = _mm256_add_pd(syy, _mm256_mul_pd(v, v));
+            x = _mm256_add_pd(x, step);
+        }
+        Kernels::LinearSums s{hsum4(sy), hsum4(sxy), hsum4(syy)};
+        for (; i < n; ++i) {
+            s.sumY += y[i];
+            s.sumXY += i * y[i];
+            s.sumYY += y[i] * y[i];
+        }
+        return s;
+    }
+
+    // Four-lane scan in two shift-and-add steps (Hillis-Steele), then the
+    // carry from the previous block: y_k = s_k + d^(k+1) * previous
+    KERNELS_TARGET_AVX2 void avx2EmaScan(const double *x, int n, double alpha, double seed, double *out)
+    {
+        const double decay = 1.0 - alpha;
+        const double d2 = decay * decay;
+        const __m256d a = _mm256_set1_pd(alpha);
+        const __m256d d = _mm256_set1_pd(decay);
+        const __m256d dd = _mm256_set1_pd(d2);
+        const __m256d carry = _mm256_set_pd(d2 * d2, d2 * decay, d2, decay);
+        const __m256d zero = _mm256_setzero_pd();
+        __m256d prev = _mm256_set1_pd(seed);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d v = _mm256_mul_pd(a, _mm256_loadu_pd(x + i));
+            const __m256d shift1 = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1);
+            const __m256d s1 = _mm256_add_pd(v, _mm256_mul_pd(d, shift1));
+            const __m256d shift2 = _mm256_blend_pd(_mm256_permute4x64_pd(s1, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3);
+            const __m256d s2 = _mm256_add_pd(s1, _mm256_mul_pd(dd, shift2));
+            const __m256d y = _mm256_add_pd(s2, _mm256_mul_pd(carry, prev));
+            _mm256_storeu_pd(out + i, y);
+            prev = _mm256_permute4x64_pd(y, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        double y = _mm_cvtsd_f64(_mm256_castpd256_pd128(prev));
+        for (; i < n; ++i) {
+            y = alpha * x[i] + decay * y;
+            out[i] = y;
+        }
+    }
+
+    const Table Avx2Table = {
+        avx2Sum, avx2Dot, avx2MinMax, avx2SumSquaredDeviation, avx2SumReturns,
+        avx2SumSquaredReturnDeviation, avx2Returns, avx2LinearSums, avx2EmaScan,
+    };
+#endif // KERNELS_X86
+
+    Kernels::Isa detectIsa()
+    {
+#if KERNELS_X86 && defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        const bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28))
+                                && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        if (osSavesYmm && (info[1] & (1 << 5)))
+            return Kernels::Isa::Avx2;
+        return Kernels::Isa::Sse2;
+#elif KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return Kernels::Isa::Avx2;
+        if (__builtin_cpu_supports("sse2"))
+            return Kernels::Isa::Sse2;
+        return Kernels::Isa::Scalar;
+#else
+        return Kernels::Isa::Scalar;
+#endif
+    }
+
+    const Table *tableFor(Kernels::Isa isa)
+    {
+#if KERNELS_X86
+        switch (isa) {
+        case Kernels::Isa::Avx2: return &Avx2Table;
+        case Kernels::Isa::Sse2: return &Sse2Table;
+        case Kernels::Isa::Scalar: break;
+        }
+#else
+        Q_UNUSED(isa)
+#endif
+        return &ScalarTable;
+    }
+
+    std::atomic<int> &activeIsa()
+    {
+        static std::atomic<int> active{static_cast<int>(Kernels::bestIsa())};
+        return active;
+    }
+
+    const Table &table()
+    {
+        return *tableFor(static_cast<Kernels::Isa>(activeIsa().load(std::memory_order_relaxed)));
+    }
+}
+
+namespace Kernels
+{
+    Isa bestIsa()
+    {
+        static const Isa best = detectIsa();
+        return best;
+    }
+
+    Isa isa()
+    {
+        return static_cast<Isa>(activeIsa().load(std::memory_order_relaxed));
+    }
+
+    void setIsa(Isa isa)
+    {
+        const int clamped = qMin(static_cast<int>(isa), static_cast<int>(bestIsa()));
+        activeIsa().store(clamped, std::memory_order_relaxed);
+    }
+
+    const char *isaName(Isa isa)
+    {
+        switch (isa) {
+        case Isa::Avx2: return "AVX2";
+        case Isa::Sse2: return "SSE2";
+        case Isa::Scalar: break;
+        }
+        return "scalar";
+    }
+
+    double sum(const double *x, int n)
+    {
+        return n > 0 ? table().sum(x, n) : 0.0;
+    }
+
+    double dot(const double *a, const double *b, int n)
+    {
+        return n > 0 ? table().dot(a, b, n) : 0.0;
+    }
+
+    void minMax(const double *x, int n, double *min, double *max)
+    {
+        if (n <= 0) return;
+        table().minMax(x, n, min, max);
+    }
+
+    Moments moments(const double *x, int n)
+    {
+        Moments m;
+        if (n <= 0) return m;
+        const Table &t = table();
+        m.mean = t.sum(x, n) / n;
+        m.variance = t.sumSquaredDeviation(x, n, m.mean) / n;
+        return m;
+    }
+
+    void returns(const double *prices, int n, double *out)
+    {
+        if (n < 2) return;
+        table().returns(prices, n, out);
+    }
+
+    Moments returnMoments(const double *prices, int n)
+    {
+        Moments m;
+        if (n < 2) return m;
+        const Table &t = table();
+        const int count = n - 1;
+        m.mean = t.sumReturns(prices, n) / count;
+        m.variance = t.sumSquaredReturnDeviation(prices, n, m.mean) / count;
+        return m;
+    }
+
+    LinearSums linearSums(const double *y, int n)
+    {
+        return n > 0 ? table().linearSums(y, n) : LinearSums();
+    }
+
+    void emaScan(const double *x, int n, double alpha, double seed, double *out)
+    {
+        if (n <= 0) return;
+        table().emaScan(x, n, alpha, seed, out);
+    }
+
+    void rollingMean(const double *x, int n, int window, double *out)
+    {
+        if (window <= 0 || n < window) return;
+        double s = sum(x, window);
+        out[0] = s / window;
+        for (int i = window; i < n; ++i) {
+            s += x[i] - x[i - window];
+            out[i - window + 1] = s / window;
+        }
+    }
+
+    void rollingVariance(const double *x, int n, int window, double *out)
+    {
+        // Windowed Welford, the same update IndicatorEngine uses for Bollinger
+        if (window <= 0 || n < window) return;
+        const Moments first = moments(x, window);
+        double mean = first.mean;
+        double m2 = first.variance * window;
+        out[0] = first.variance;
+        for (int i = window; i < n; ++i) {
+            const double evicted = x[i - window];
+            const double oldMean = mean;
+            mean += (x[i] - evicted) / window;
+            m2 += (x[i] - evicted) * (x[i] - mean + evicted - oldMean);
+            if (m2 < 0.0) m2 = 0.0;
+            out[i - window + 1] = m2 / window;
+        }
+    }
+}
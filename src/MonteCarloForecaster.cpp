@@ -0,0 +1,213 @@
+#include "MonteCarloForecaster.h"
+#include "Kernels.h"
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <cmath>
+
+namespace
+{
+    const quint32 PhiloxM0 = 0xD2511F53;
+    const quint32 PhiloxM1 = 0xCD9E8D57;
+    const quint32 PhiloxW0 = 0x9E3779B9;
+    const quint32 PhiloxW1 = 0xBB67AE85;
+    const double TwoPi = 6.283185307179586;
+    const double SpreadSigmas = 6.0;   // histogram covers centre +- 6 sigma sqrt(t)
+
+    // Everything a block needs, estimated once and shared read-only
+    struct Setup {
+        MonteCarloForecaster::Model model;
+        Philox4x32 rng;
+        int paths = 0;
+        int steps = 0;
+        int bins = 0;
+        double drift = 0.0;       // mean log-return per step
+        double sigma = 0.0;       // std-dev of log-return per step
+        QVector<double> returns;  // log-returns for the bootstrap
+        QVector<double> low;      // per step: histogram lower edge
+        QVector<double> scale;    // per step: bins per unit of log-return
+    };
+
+    struct Histogram {
+        QVector<quint32> counts;  // steps x bins
+    };
+
+    inline double uniform(quint32 bits)
+    {
+        return (bits + 0.5) * (1.0 / 4294967296.0);   // open interval (0, 1)
+    }
+
+    void simulateBlock(const Setup &setup, int block, Histogram &histogram)
+    {
+        const int first = block * MonteCarloForecaster::BlockPaths;
+        const int count = qMin(MonteCarloForecaster::BlockPaths, setup.paths - first);
+
+        double logReturn[MonteCarloForecaster::BlockPaths] = {};
+        double shock[MonteCarloForecaster::BlockPaths];
+        quint32 bits[4];
+
+        for (int step = 0; step < setup.steps; ++step) {
+            // One Philox call per four paths; the counter names the block, step and lane group
+            for (int lane = 0; lane < count; lane += 4) {
+                const quint32 counter[4] = {static_cast<quint32>(block), static_cast<quint32>(step),
+                                            static_cast<quint32>(lane / 4), 0};
+                setup.rng.generate(counter, bits);
+                if (setup.model == MonteCarloForecaster::Model::Gbm) {
+                    // Box-Muller, two normals per pair of uniforms
+                    const double r0 = std::sqrt(-2.0 * std::log(uniform(bits[0])));
+                    const double r1 = std::sqrt(-2.0 * std::log(uniform(bits[2])));
+                    const double t0 = TwoPi * uniform(bits[1]);
+                    const double t1 = TwoPi * uniform(bits[3]);
+                    shock[lane] = r0 * std::cos(t0);
+                    shock[lane + 1] = r0 * std::sin(t0);
+                    shock[lane + 2] = r1 * std::cos(t1);
+                    shock[lane + 3] = r1 * std::sin(t1);
+                } else {
+                    const quint64 n = static_cast<quint64>(setup.returns.size());
+                    for (int k = 0; k < 4; ++k)
+                        shock[lane + k] = setup.returns[static_cast<int>((bits[k] * n) >> 32)];
+                }
+            }
+
+            if (setup.model == MonteCarloForecaster::Model::Gbm) {
+                const double drift = setup.drift, sigma = setup.sigma;
+                for (int i = 0; i < count; ++i)
+                    logReturn[i] += drift + sigma * shock[i];
+            } else {
+                for (int i = 0; i < count; ++i)
+                    logReturn[i] += shock[i];
+            }
+
+            quint32 *row = histogram.counts.data() + step * setup.bins;
+            const double low = setup.low[step], scale = setup.scale[step];
+            const int lastBin = setup.bins - 1;
+            for (int i = 0; i < count; ++i) {
+                const int bin = static_cast<int>((logReturn[i] - low) * scale);
+                ++row[qBound(0, bin, lastBin)];
+            }
+        }
+    }
+
+    double percentile(const Setup &setup, const quint32 *row, quint64 total, double p)
+    {
+        const double target = p * total;
+        quint64 below = 0;
+        for (int bin = 0; bin < setup.bins; ++bin) {
+            if (below + row[bin] >= target && row[bin] > 0) {
+                const double within = (target - below) / row[bin];
+                return bin + within;
+            }
+            below += row[bin];
+        }
+        return setup.bins;
+    }
+}
+
+void Philox4x32::generate(const quint32 counter[4], quint32 out[4]) const
+{
+    quint32 c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    quint32 k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round) {
+        if (round > 0) {
+            k0 += PhiloxW0;
+            k1 += PhiloxW1;
+        }
+        const quint64 p0 = static_cast<quint64>(PhiloxM0) * c0;
+        const quint64 p1 = static_cast<quint64>(PhiloxM1) * c2;
+        c0 = static_cast<quint32>(p1 >> 32) ^ c1 ^ k0;
+        c1 = static_cast<quint32>(p1);
+        c2 = static_cast<quint32>(p0 >> 32) ^ c3 ^ k1;
+        c3 = static_cast<quint32>(p0);
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+QVector<MonteCarloForecaster::Band> MonteCarloForecaster::simulate(const PriceSpan &history)
+{
+    return simulate(history, Config());
+}
+
+QVector<MonteCarloForecaster::Band> MonteCarloForecaster::simulate(const PriceSpan &history, const Config &config)
+{
+    QVector<Band> bands;
+    const int lookback = qMin(qMax(2, config.lookback), history.size() - 1);
+    if (lookback < 2 || config.paths <= 0 || config.steps <= 0)
+        return bands;
+
+    Setup setup;
+    setup.model = config.model;
+    setup.rng.key[0] = static_cast<quint32>(config.seed);
+    setup.rng.key[1] = static_cast<quint32>(config.seed >> 32);
+    setup.paths = config.paths;
+    setup.steps = config.steps;
+    setup.bins = qMax(16, config.bins);
+
+    const PriceSpan window = history.tail(lookback + 1);
+    double spread;
+    if (config.model == Model::Gbm) {
+        // Same estimate as UniverseAnalytics::volatility, plus the mean for the drift
+        const Kernels::Moments moments = Kernels::returnMoments(window.begin(), window.size());
+        setup.sigma = std::sqrt(moments.variance);
+        setup.drift = moments.mean - moments.variance / 2.0;
+        spread = setup.sigma;
+    } else {
+        setup.returns.reserve(lookback);
+        for (int i = 1; i < window.size(); ++i)
+            setup.returns.append(std::log(window[i] / window[i - 1]));
+        const Kernels::Moments moments = Kernels::moments(setup.returns.constData(), setup.returns.size());
+        setup.drift = moments.mean;
+        spread = std::sqrt(moments.variance);
+    }
+
+    setup.low.resize(setup.steps);
+    setup.scale.resize(setup.steps);
+    for (int step = 0; step < setup.steps; ++step) {
+        const double t = step + 1;
+        const double half = qMax(SpreadSigmas * spread * std::sqrt(t), 1e-9);
+        setup.low[step] = setup.drift * t - half;
+        setup.scale[step] = setup.bins / (2.0 * half);
+    }
+
+    // Contiguous runs of blocks per task; the split only affects scheduling
+    const int blocks = (setup.paths + BlockPaths - 1) / BlockPaths;
+    const int tasks = qMin(blocks, qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 4));
+    QVector<int> taskIds(tasks);
+    for (int i = 0; i < tasks; ++i)
+        taskIds[i] = i;
+
+    auto runTask = [&setup, blocks, tasks](int task) {
+        Histogram histogram;
+        histogram.counts.fill(0, setup.steps * setup.bins);
+        const int begin = static_cast<int>(static_cast<qint64>(blocks) * task / tasks);
+        const int end = static_cast<int>(static_cast<qint64>(blocks) * (task + 1) / tasks);
+        for (int block = begin; block < end; ++block)
+            simulateBlock(setup, block, histogram);
+        return histogram;
+    };
+    auto merge = [](Histogram &total, const Histogram &part) {
+        if (total.counts.isEmpty()) {
+            total = part;
+            return;
+        }
+        quint32 *into = total.counts.data();
+        const quint32 *from = part.counts.constData();
+        for (int i = 0; i < part.counts.size(); ++i)
+            into[i] += from[i];
+    };
+    const Histogram histogram = QtConcurrent::blockingMappedReduced<Histogram>(
+        taskIds, runTask, merge, QtConcurrent::UnorderedReduce);
+
+    const double start = history.last();
+    bands.resize(setup.steps);
+    for (int step = 0; step < setup.steps; ++step) {
+        const quint32 *row = histogram.counts.constData() + step * setup.bins;
+        auto price = [&](double p) {
+            const double bin = percentile(setup, row, static_cast<quint64>(setup.paths), p);
+            return start * std::exp(setup.low[step] + bin / setup.scale[step]);
+        };
+        bands[step] = Band{price(0.05), price(0.25), price(0.50), price(0.75), price(0.95)};
+    }
+    return bands;
+}
@@ -0,0 +1,410 @@
+#include "PatternIndex.h"
+#include <QCoreApplication>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QPair>
+#include <QDebug>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    const double Infinity = std::numeric_limits<double>::infinity();
+
+    // N(0,1) quantiles splitting z-normalised values into equiprobable SAX levels
+    const double Breakpoints[PatternIndex::Cardinality - 1] = {-1.1503493803760079, -0.6744897501960817,
+                                                               -0.3186393639643752, 0.0, 0.3186393639643752,
+                                                               0.6744897501960817, 1.1503493803760079};
+
+    int level(double value)
+    {
+        int symbol = 0;
+        while (symbol < PatternIndex::Cardinality - 1 && value > Breakpoints[symbol])
+            ++symbol;
+        return symbol;
+    }
+
+    int segmentStart(int segment, const PatternIndex::Config &config)
+    {
+        return segment * config.length / config.segments;
+    }
+
+    // PAA and box bounds are stored as float; never prune on a margin that rounding could explain
+    bool cannotBeat(double bound, double threshold)
+    {
+        return bound > threshold * 1.0001 + 1e-9;
+    }
+
+    // Squared DTW inside a Sakoe-Chiba band, rows along `a`. Gives up once
+    // the cheapest cell of row i plus remaining[i], a lower bound on what
+    // the rows after it must still add, reaches `abandonAbove`.
+    double dtw(const double *a, const double *b, int m, int band, double abandonAbove, const double *remaining,
+               double *prev, double *cur)
+    {
+        for (int i = 0; i < m; ++i) {
+            const int lo = qMax(0, i - band);
+            const int hi = qMin(m - 1, i + band);
+            if (lo > 0)
+                cur[lo - 1] = Infinity;
+
+            double rowMin = Infinity;
+            for (int j = lo; j <= hi; ++j) {
+                const double d = (a[i] - b[j]) * (a[i] - b[j]);
+                double reach;
+                if (i == 0 && j == 0)
+                    reach = 0.0;
+                else {
+                    reach = j > 0 ? cur[j - 1] : Infinity;
+                    if (i > 0) {
+                        reach = qMin(reach, prev[j]);
+                        if (j > 0)
+                            reach = qMin(reach, prev[j - 1]);
+                    }
+                }
+                cur[j] = d + reach;
+                rowMin = qMin(rowMin, cur[j]);
+            }
+            if (hi + 1 < m)
+                cur[hi + 1] = Infinity;
+            if (rowMin + remaining[i] >= abandonAbove)
+                return Infinity;
+            std::swap(prev, cur);
+        }
+        return prev[m - 1];
+    }
+
+    bool before(const PatternIndex::Match &a, const PatternIndex::Match &b)
+    {
+        if (a.distance != b.distance)
+            return a.distance < b.distance;
+        return a.symbolId != b.symbolId ? a.symbolId < b.symbolId : a.offset < b.offset;
+    }
+
+    bool overlaps(const PatternIndex::Match &a, const PatternIndex::Match &b, int length)
+    {
+        return a.symbolId == b.symbolId && std::abs(a.offset - b.offset) < length;
+    }
+
+    // Best first, skipping any window that overlaps one already taken, up to `limit` picks
+    QVector<PatternIndex::Match> selectNonOverlapping(const QVector<PatternIndex::Match> &sorted, int limit, int length)
+    {
+        QVector<PatternIndex::Match> picks;
+        for (const PatternIndex::Match &match : sorted) {
+            if (picks.size() == limit)
+                break;
+            if (std::none_of(picks.begin(), picks.end(),
+                             [&](const PatternIndex::Match &pick) { return overlaps(pick, match, length); }))
+                picks.append(match);
+        }
+        return picks;
+    }
+
+    // Adds a candidate to the sorted pool and returns the new pruning
+    // threshold. The answer is the greedy non-overlapping selection over
+    // every window, and a window still to come can knock out at most two
+    // picks, one on each side of it; so once the pool holds 2K - 1
+    // non-overlapping picks, nothing beyond the last of them can make the
+    // top K. The pool is trimmed to that threshold.
+    double offer(QVector<PatternIndex::Match> &pool, int k, int length, const PatternIndex::Match &candidate)
+    {
+        pool.insert(std::upper_bound(pool.begin(), pool.end(), candidate, before), candidate);
+
+        const QVector<PatternIndex::Match> picks = selectNonOverlapping(pool, 2 * k - 1, length);
+        if (picks.size() < 2 * k - 1)
+            return Infinity;
+        const double threshold = picks.last().distance;
+        pool.erase(std::upper_bound(pool.begin(), pool.end(), picks.last(), before), pool.end());
+        return threshold;
+    }
+}
+
+PatternIndex *PatternIndex::instance()
+{
+    static PatternIndex *index = new PatternIndex(QCoreApplication::instance());
+    return index;
+}
+
+PatternIndex::PatternIndex(QObject *parent) : QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<Index>::finished, this, &PatternIndex::adopt);
+}
+
+bool PatternIndex::rebuild(const QVector<Input> &inputs)
+{
+    if (m_watcher.isRunning())
+        return false;
+
+    const Config config = m_index.config;
+    m_buildTimer.start();
+    m_watcher.setFuture(QtConcurrent::run([inputs, config]() { return build(inputs, config); }));
+    return true;
+}
+
+void PatternIndex::adopt()
+{
+    m_index = m_watcher.result();
+    qDebug() << "🔍 Pattern index:" << m_index.windows() << "windows of" << m_index.config.length << "closes from"
+             << m_index.symbolIds.size() << "series in" << m_index.buckets() << "buckets,"
+             << m_buildTimer.nsecsElapsed() / 1000 << "µs";
+    emit indexReady();
+}
+
+QVector<PatternIndex::Match> PatternIndex::search(const PriceSpan &query, int k, quint32 querySymbolId, Stats *stats) const
+{
+    return search(m_index, query, k, querySymbolId, stats);
+}
+
+PatternIndex::Index PatternIndex::build(const QVector<Input> &inputs, const Config &requested)
+{
+    Index index;
+    Config &config = index.config;
+    config.length = qMax(4, requested.length);
+    config.segments = qBound(1, requested.segments, qMin(10, config.length));   // 10 x 3 bits fit the word
+    config.band = qBound(0, requested.band, config.length - 1);
+    const int m = config.length;
+    const int w = config.segments;
+
+    // PAA of every z-normalised window straight from running sums
+    QVector<float> paa;
+    QVector<quint64> keys;   // SAX word << 32 | window, sorted to group the buckets
+    QVector<int> series, offset;
+    QVector<double> means, scales;
+    QVector<double> prefix, prefixSq;
+    for (const Input &input : inputs) {
+        const int n = input.closes.size();
+        if (n < m)
+            continue;
+        prefix.resize(n + 1);
+        prefixSq.resize(n + 1);
+        prefix[0] = prefixSq[0] = 0.0;
+        for (int t = 0; t < n; ++t) {
+            prefix[t + 1] = prefix[t] + input.closes[t];
+            prefixSq[t + 1] = prefixSq[t] + input.closes[t] * input.closes[t];
+        }
+        const int s = index.symbolIds.size();
+        index.symbolIds.append(input.symbolId);
+        index.closes.append(input.closes);
+
+        const double *sum = prefix.constData();
+        const double *sumSq = prefixSq.constData();
+        for (int off = 0; off <= n - m; ++off) {
+            const double mean = (sum[off + m] - sum[off]) / m;
+            const double variance = (sumSq[off + m] - sumSq[off]) / m - mean * mean;
+            if (variance <= 1e-12 * mean * mean)
+                continue;   // flat: no shape to compare
+            const double sd = std::sqrt(variance);
+
+            quint64 word = 0;
+            for (int i = 0; i < w; ++i) {
+                const int a = off + segmentStart(i, config);
+                const int b = off + segmentStart(i + 1, config);
+                const double value = ((sum[b] - sum[a]) / (b - a) - mean) / sd;
+                paa.append(static_cast<float>(value));
+                word = word * Cardinality + level(value);
+            }
+            keys.append(word << 32 | static_cast<quint64>(series.size()));
+            series.append(s);
+            offset.append(off);
+            means.append(mean);
+            scales.append(1.0 / sd);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    const int windows = keys.size();
+    index.series.resize(windows);
+    index.offset.resize(windows);
+    index.mean.resize(windows);
+    index.scale.resize(windows);
+    index.paa.resize(windows * w);
+    quint64 previousWord = ~0ULL;
+    for (int slot = 0; slot < windows; ++slot) {
+        const quint64 word = keys[slot] >> 32;
+        const int from = static_cast<int>(keys[slot] & 0xffffffffULL);
+        index.series[slot] = series[from];
+        index.offset[slot] = offset[from];
+        index.mean[slot] = means[from];
+        index.scale[slot] = scales[from];
+        const float *source = paa.constData() + from * w;
+        std::copy(source, source + w, index.paa.begin() + slot * w);
+
+        if (word != previousWord) {
+            index.bucketBegin.append(slot);
+            index.boxLow.append(QVector<float>(source, source + w));
+            index.boxHigh.append(QVector<float>(source, source + w));
+            previousWord = word;
+        }
+        float *low = index.boxLow.data() + index.boxLow.size() - w;
+        float *high = index.boxHigh.data() + index.boxHigh.size() - w;
+        for (int i = 0; i < w; ++i) {
+            low[i] = qMin(low[i], source[i]);
+            high[i] = qMax(high[i], source[i]);
+        }
+    }
+    index.bucketBegin.append(windows);
+    return index;
+}
+
+QVector<PatternIndex::Match> PatternIndex::search(const Index &index, const PriceSpan &query, int k,
+                                                  quint32 querySymbolId, Stats *stats)
+{
+    QVector<Match> best;
+    const Config &config = index.config;
+    const int m = config.length;
+    const int w = config.segments;
+    const int band = config.band;
+    if (k <= 0 || query.size() < m || index.windows() == 0)
+        return best;
+
+    // z-normalised query and its warping envelope
+    const PriceSpan tail = query.tail(m);
+    QVector<double> buffers(9 * m + 1);   // the only allocation besides the bucket order
+    double *q = buffers.data();
+    double *upper = q + m;
+    double *lower = upper + m;
+    double *candidate = lower + m;
+    double *prev = candidate + m;
+    double *cur = prev + m;
+    double *forward = cur + m;       // LB_Keogh terms per candidate point, then suffix sums
+    double *reverse = forward + m;   // the same with the roles swapped, per query point
+    double *remaining = reverse + m; // m + 1 entries
+
+    double mean = 0.0, meanSq = 0.0;
+    for (double price : tail) {
+        mean += price;
+        meanSq += price * price;
+    }
+    mean /= m;
+    const double variance = meanSq / m - mean * mean;
+    if (variance <= 1e-12 * mean * mean)
+        return best;
+    const double sd = std::sqrt(variance);
+    for (int t = 0; t < m; ++t)
+        q[t] = (tail[t] - mean) / sd;
+    for (int t = 0; t < m; ++t) {
+        upper[t] = -Infinity;
+        lower[t] = Infinity;
+        for (int j = qMax(0, t - band); j <= qMin(m - 1, t + band); ++j) {
+            upper[t] = qMax(upper[t], q[j]);
+            lower[t] = qMin(lower[t], q[j]);
+        }
+    }
+
+    // The envelope reduced per PAA segment: a window's segment mean has to
+    // leave [segLower, segUpper] before its points can leave the envelope
+    QVector<double> segUpper(w), segLower(w), segLength(w);
+    for (int i = 0; i < w; ++i) {
+        const int a = segmentStart(i, config), b = segmentStart(i + 1, config);
+        segUpper[i] = *std::max_element(upper + a, upper + b);
+        segLower[i] = *std::min_element(lower + a, lower + b);
+        segLength[i] = b - a;
+    }
+
+    QVector<QPair<double, int>> order(index.buckets());
+    for (int bucket = 0; bucket < index.buckets(); ++bucket) {
+        const float *low = index.boxLow.constData() + bucket * w;
+        const float *high = index.boxHigh.constData() + bucket * w;
+        double bound = 0.0;
+        for (int i = 0; i < w; ++i) {
+            if (low[i] > segUpper[i])
+                bound += segLength[i] * (low[i] - segUpper[i]) * (low[i] - segUpper[i]);
+            else if (high[i] < segLower[i])
+                bound += segLength[i] * (segLower[i] - high[i]) * (segLower[i] - high[i]);
+        }
+        order[bucket] = qMakePair(bound, bucket);
+    }
+    std::sort(order.begin(), order.end());
+
+    Stats local;
+    local.windows = index.windows();
+    QVector<Match> pool;           // every window under the threshold, best first
+    double threshold = Infinity;   // squared distance past which no window can make the top K
+
+    for (const QPair<double, int> &entry : order) {
+        if (cannotBeat(entry.first, threshold))
+            break;
+        ++local.bucketsVisited;
+
+        for (int slot = index.bucketBegin[entry.second]; slot < index.bucketBegin[entry.second + 1]; ++slot) {
+            const int s = index.series[slot];
+            const int off = index.offset[slot];
+            const int n = index.closes[s].size();
+            if (index.symbolIds[s] == querySymbolId && off + m > n - m)
+                continue;   // overlaps the query itself
+
+            const float *point = index.paa.constData() + slot * w;
+            double bound = 0.0;
+            for (int i = 0; i < w; ++i) {
+                if (point[i] > segUpper[i])
+                    bound += segLength[i] * (point[i] - segUpper[i]) * (point[i] - segUpper[i]);
+                else if (point[i] < segLower[i])
+                    bound += segLength[i] * (segLower[i] - point[i]) * (segLower[i] - point[i]);
+            }
+            if (cannotBeat(bound, threshold)) {
+                ++local.prunedByPaa;
+                continue;
+            }
+
+            const double *closes = index.closes[s].constData() + off;
+            const double windowMean = index.mean[slot];
+            const double windowScale = index.scale[slot];
+
+            // LB_Keogh of the candidate against the query envelope, abandoned
+            // as soon as it passes the threshold
+            double keogh = 0.0;
+            int t = 0;
+            for (; t < m && keogh < threshold; ++t) {
+                const double c = (closes[t] - windowMean) * windowScale;
+                candidate[t] = c;
+                forward[t] = c > upper[t] ? (c - upper[t]) * (c - upper[t])
+                           : c < lower[t] ? (lower[t] - c) * (lower[t] - c) : 0.0;
+                keogh += forward[t];
+            }
+            if (t < m || keogh >= threshold) {
+                ++local.prunedByKeogh;
+                continue;
+            }
+
+            // And of the query against the candidate's envelope
+            double reverseKeogh = 0.0;
+            for (int i = 0; i < m && reverseKeogh < threshold; ++i) {
+                double high = -Infinity, low = Infinity;
+                for (int j = qMax(0, i - band); j <= qMin(m - 1, i + band); ++j) {
+                    high = qMax(high, candidate[j]);
+                    low = qMin(low, candidate[j]);
+                }
+                reverse[i] = q[i] > high ? (q[i] - high) * (q[i] - high) : q[i] < low ? (low - q[i]) * (low - q[i]) : 0.0;
+                reverseKeogh += reverse[i];
+            }
+            if (reverseKeogh >= threshold) {
+                ++local.prunedByKeogh;
+                continue;
+            }
+
+            // After row i every query point past i, and every candidate point
+            // past i + band, is still to be matched
+            for (int i = m - 2; i >= 0; --i) {
+                forward[i] += forward[i + 1];
+                reverse[i] += reverse[i + 1];
+            }
+            for (int i = 0; i < m; ++i) {
+                const double later = i + 1 < m ? reverse[i + 1] : 0.0;
+                const double beyond = i + band + 1 < m ? forward[i + band + 1] : 0.0;
+                remaining[i] = qMax(later, beyond);
+            }
+
+            ++local.dtwComputed;
+            const double distance = dtw(q, candidate, m, band, threshold, remaining, prev, cur);
+            if (distance < threshold)
+                threshold = offer(pool, k, m, Match{index.symbolIds[s], off, n - off - m, distance});
+        }
+    }
+
+    best = selectNonOverlapping(pool, k, m);
+    for (Match &match : best)
+        match.distance = std::sqrt(match.distance);
+    if (stats)
+        *stats = local;
+    return best;
+}
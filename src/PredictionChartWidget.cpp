@@ -1,4 +1,8 @@
 #include "PredictionChartWidget.h"
+#include "DataPlane.h"
+#include "SymbolRegistry.h"
+#include "BarStore.h"
+#include "UniverseAnalytics.h"
 #include <QPainter>
 #include <QTimer>
 #include <QNetworkAccessManager>
@@ -11,11 +15,12 @@
 #include <QPen>
 #include <QColor>
 #include <QTime>
-#include <QQueue>
-#include <QStack>
+#include <QDateTime>
+#include <QtConcurrent/QtConcurrentRun>
 #include <algorithm>
 #include <queue>
 #include <cmath>
+#include <limits>
 
 PredictionChartWidget::PredictionChartWidget(QWidget *parent) : QWidget(parent)
 {
@@ -35,9 +40,25 @@ PredictionChartWidget::PredictionChartWidget(QWidget *parent) : QWidget(parent)
     m_cacheHits = 0;
     m_cacheMisses = 0;
 
-    m_historicalData.clear();
+    m_historicalData = PriceSpan();
     m_predictedData.clear();
 
+    connect(&m_monteCarloWatcher, &QFutureWatcher<QVector<MonteCarloForecaster::Band>>::finished,
+            this, &PredictionChartWidget::onMonteCarloFinished);
+
+    connect(UniverseAnalytics::instance(), &UniverseAnalytics::snapshotReady, this, [this]() {
+        findTopPerformers();
+        update();
+    });
+    connect(CorrelationEngine::instance(), &CorrelationEngine::matrixReady, this, [this]() {
+        findTopPerformers();
+        update();
+    });
+    connect(PatternIndex::instance(), &PatternIndex::indexReady, this, [this]() {
+        findSimilarPatterns();
+        update();
+    });
+
     m_updateTimer = new QTimer(this);
     connect(m_updateTimer, &QTimer::timeout, this, &PredictionChartWidget::updatePredictions);
     m_updateTimer->start(5000);
@@ -63,12 +84,19 @@ void PredictionChartWidget::setCurrentStock(const QString &symbol)
 
     qDebug() << "🔄 Switching from" << m_currentSymbol << "to" << symbol;
     m_currentSymbol = symbol;
-    m_historicalData.clear();
+    m_currentSymbolId = SymbolRegistry::instance().intern(symbol);
+    m_historicalData = PriceSpan();
     m_predictedData.clear();
+    m_monteCarloBands.clear();
+    m_tradingSignals.clear();
+    m_similarStocks.clear();
+    m_similarPatterns.clear();
+    m_backtest = Backtester::Result();
+    m_walkForward = Backtester::Result();
     m_trendDirection = "loading";
 
-    QVector<double> cached = getCachedStock(symbol);
-    if (!cached.isEmpty() && cached.size() >= 10)
+    PriceSpan cached = getCachedStock(symbol);
+    if (cached.size() >= 10)
     {
         m_historicalData = cached;
         analyzeWithAllDSA();
@@ -81,93 +109,87 @@ void PredictionChartWidget::setCurrentStock(const QString &symbol)
     update();
 }
 
-void PredictionChartWidget::updateWithLiveData(const QString &symbol, const QVector<double> &prices)
+void PredictionChartWidget::requestHistoricalData(const QString &symbol)
 {
-    if (symbol != m_currentSymbol || prices.size() < 10)
+    const quint32 symbolId = SymbolRegistry::instance().intern(symbol);
+    if (m_historyInFlight[symbolId])
         return;
 
-    cacheStock(symbol, prices);
-    m_historicalData = prices;
-    analyzeWithAllDSA();
-    update();
-
-    qDebug() << "📊 Live update:" << symbol << "with" << prices.size() << "points";
-}
-
-void PredictionChartWidget::requestHistoricalData(const QString &symbol)
-{
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
-    QString url = QString("https://query1.finance.yahoo.com/v8/finance/chart/%1.NS?interval=1d&range=3mo").arg(symbol);
+    // A full year (what the chart's 1Y timeframe shows) only when too little
+    // is stored; otherwise just the delta from the start of the last stored
+    // trading day (that bar may still be forming)
+    const qint64 lastTimestampNs = BarStore::instance().lastTimestamp(symbolId);
+    const QString yahooSymbol = SymbolRegistry::instance().yahooSymbol(symbolId);
+    QString url;
+    if (lastTimestampNs == 0 || BarStore::instance().count(symbolId) < 10)
+    {
+        url = QString("https://query1.finance.yahoo.com/v8/finance/chart/%1?interval=1d&range=1y").arg(yahooSymbol);
+    }
+    else
+    {
+        const qint64 istOffsetSecs = 5 * 3600 + 1800;
+        const qint64 period1 = BarStore::tradingDayOf(lastTimestampNs) * 86400 - istOffsetSecs;
+        const qint64 period2 = QDateTime::currentSecsSinceEpoch();
+        url = QString("https://query1.finance.yahoo.com/v8/finance/chart/%1?interval=1d&period1=%2&period2=%3")
+                  .arg(yahooSymbol).arg(period1).arg(period2);
+    }
 
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::UserAgentHeader,
                       "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
 
-    QNetworkReply *reply = manager->get(request);
+    m_historyInFlight[symbolId] = true;
 
-    connect(reply, &QNetworkReply::finished, [this, reply, symbol]()
-            {
-                if (reply->error() == QNetworkReply::NoError)
-                {
-                    QByteArray data = reply->readAll();
-                    QJsonDocument doc = QJsonDocument::fromJson(data);
-
-                    if (!doc.isNull())
-                    {
-                        QVector<double> prices = parseYahooData(doc.object());
-                        if (prices.size() > 0)
-                        {
-                            m_lastFetchedPrice = prices.last();
-                            cacheStock(symbol, prices);
-                            m_historicalData = prices;
-                            analyzeWithAllDSA();
-                            update();
-                            qDebug() << "Fetched" << prices.size() << "real prices for" << symbol;
-                        }
-                        else
-                        {
-                            m_trendDirection = "nodata";
-                            update();
-                        }
-                    }
-                }
-                // (Optional: else block for errors, or logging)
-            });
+    struct History {
+        BarSeries bars;
+        int bytes = 0;
+    };
 
-}
-QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &response)
-    {
-        QVector<double> prices;
-
-        try
+    // Parse on the data plane; only the bar columns come back to the GUI thread
+    DataPlane::instance()->fetch(request, this,
+        [](const QByteArray &data)
         {
-            QJsonArray results = response["chart"].toObject()["result"].toArray();
-            if (results.isEmpty())
-                return prices;
-
-            QJsonObject result = results[0].toObject();
-            QJsonArray quote = result["indicators"].toObject()["quote"].toArray();
-            if (quote.isEmpty())
-                return prices;
-
-            QJsonArray closePrices = quote[0].toObject()["close"].toArray();
+            History history;
+            history.bytes = data.size();
+            QJsonDocument doc = QJsonDocument::fromJson(data);
+            if (!doc.isNull())
+                history.bars = BarStore::parseYahooChart(doc.object());
+            return history;
+        },
+        [this, symbol, symbolId](const History &history)
+        {
+            m_historyInFlight[symbolId] = false;
+            m_historyBytes += history.bytes;
+            const BarSeries &bars = history.bars;
 
-            for (const QJsonValue &val : closePrices)
+            if (!bars.isEmpty())
             {
-                if (!val.isNull() && val.toDouble() > 0)
+                m_lastFetchedPrice = bars.close.last();
+                const int changed = cacheStock(symbol, bars);
+                qDebug() << "Fetched" << bars.size() << "bars for" << symbol << "-" << changed << "new or updated,"
+                         << history.bytes << "bytes (" << m_historyBytes << "total )";
+
+                // Nothing new since the last poll: indicators and chart are already current
+                if (symbol == m_currentSymbol && (changed > 0 || m_historicalData.isEmpty()))
                 {
-                    prices.append(val.toDouble());
+                    m_historicalData = TickStore::instance()
+                        .series(TickStore::Resolution::Daily, symbolId).price;
+                    analyzeWithAllDSA();
+                    update();
                 }
             }
-        }
-        catch (...)
+            else if (symbol == m_currentSymbol && m_historicalData.isEmpty())
+            {
+                m_trendDirection = "nodata";
+                update();
+            }
+        },
+        [this, symbolId](const QString &error)
         {
-            qWarning() << "Error parsing data";
-        }
-
-        return prices;
-    }
-
+            m_historyInFlight[symbolId] = false;
+            qWarning() << "History request failed:" << error;
+        });
+}
     void PredictionChartWidget::analyzeWithAllDSA()
     {
         if (m_historicalData.size() < 10)
@@ -178,88 +200,67 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
         calculateSlidingWindowIndicators();
         detectTrendWithStack();
         findTopPerformers();
+        findSimilarPatterns();
         generateLinearForecast();
+        generateTradingSignals();
+        startMonteCarlo();
         updateChartBounds();
 
         qDebug() << "✅ Analysis complete: SMA:" << m_smaValue << "RSI:" << m_rsiValue;
     }
 
-    void PredictionChartWidget::cacheStock(const QString &symbol, const QVector<double> &prices)
+    int PredictionChartWidget::cacheStock(const QString &symbol, const BarSeries &bars)
     {
-        m_stockCache[symbol] = prices;
+        // Persists only the bars newer than what is on disk; TickStore follows
+        return BarStore::instance().merge(SymbolRegistry::instance().intern(symbol), bars);
     }
 
-    QVector<double> PredictionChartWidget::getCachedStock(const QString &symbol)
+    PriceSpan PredictionChartWidget::getCachedStock(const QString &symbol)
     {
-        if (m_stockCache.contains(symbol))
+        const quint32 symbolId = SymbolRegistry::instance().intern(symbol);
+        BarStore::instance().load(symbolId);   // lazy, once per symbol and session
+        const TickStore::Series daily = TickStore::instance().series(TickStore::Resolution::Daily, symbolId);
+        if (!daily.isEmpty())
         {
             m_cacheHits++;
-            return m_stockCache[symbol];
+            return daily.price;
         }
         m_cacheMisses++;
-        return QVector<double>();
+        return PriceSpan();
     }
 
-    void PredictionChartWidget::updateCache(const QString &symbol, double price)
+    const IndicatorEngine &PredictionChartWidget::syncIndicators(quint32 symbolId)
     {
-        if (m_stockCache.contains(symbol))
+        // The range spans the whole daily series: its window doubles as the
+        // series grows, up to the ring's capacity. The trend line spans the
+        // forecast window. Either change means one cold load.
+        const TickStore::Series daily = TickStore::instance().series(TickStore::Resolution::Daily, symbolId);
+        IndicatorSync &sync = m_indicators[symbolId];
+        int rangeWindow = qMax(64, sync.config().rangeWindow);
+        while (rangeWindow < daily.size())
+            rangeWindow *= 2;
+        rangeWindow = qMin(rangeWindow, TickStore::instance().capacity(TickStore::Resolution::Daily));
+        if (sync.config().rangeWindow != rangeWindow || sync.config().trendWindow != m_forecastWindow)
         {
-            m_stockCache[symbol].append(price);
-            if (m_stockCache[symbol].size() > 100)
-            {
-                m_stockCache[symbol].removeFirst();
-            }
+            IndicatorSync::Config config;
+            config.rangeWindow = rangeWindow;
+            config.trendWindow = m_forecastWindow;
+            sync = IndicatorSync(config);
         }
+        sync.sync(daily);
+        return sync.engine();
     }
 
     void PredictionChartWidget::calculateSlidingWindowIndicators()
     {
-        int smaWindow = qMin(20, m_historicalData.size());
-        QQueue<double> priceQueue;
-        double sum = 0.0;
-
-        for (int i = m_historicalData.size() - smaWindow; i < m_historicalData.size(); ++i)
-        {
-            priceQueue.enqueue(m_historicalData[i]);
-            sum += m_historicalData[i];
-        }
-        m_smaValue = sum / smaWindow;
-
-        int emaWindow = qMin(12, m_historicalData.size());
-        double multiplier = 2.0 / (emaWindow + 1.0);
-        m_emaValue = m_historicalData[0];
-
-        for (int i = 1; i < m_historicalData.size(); ++i)
-        {
-            m_emaValue = (m_historicalData[i] * multiplier) + (m_emaValue * (1 - multiplier));
-        }
-
-        int rsiWindow = qMin(14, m_historicalData.size() - 1);
-        double gains = 0.0, losses = 0.0;
-
-        for (int i = m_historicalData.size() - rsiWindow; i < m_historicalData.size(); ++i)
-        {
-            double change = m_historicalData[i] - m_historicalData[i - 1];
-            if (change > 0)
-                gains += change;
-            else
-                losses += -change;
-        }
-
-        double avgGain = gains / rsiWindow;
-        double avgLoss = losses / rsiWindow;
-        double rs = (avgLoss == 0) ? 100 : avgGain / avgLoss;
-        m_rsiValue = 100 - (100 / (1 + rs));
-
-        int bbWindow = qMin(20, m_historicalData.size());
-        double variance = 0.0;
-        for (int i = m_historicalData.size() - bbWindow; i < m_historicalData.size(); ++i)
-        {
-            variance += (m_historicalData[i] - m_smaValue) * (m_historicalData[i] - m_smaValue);
-        }
-        double stdDev = sqrt(variance / bbWindow);
-        m_bollingerUpper = m_smaValue + (2.0 * stdDev);
-        m_bollingerLower = m_smaValue - (2.0 * stdDev);
+        // O(1) per new bar: only what arrived since the previous analysis is folded in
+        const IndicatorEngine &engine = syncIndicators(m_currentSymbolId);
+
+        m_smaValue = engine.sma();
+        m_emaValue = engine.ema();
+        m_rsiValue = engine.rsi();
+        m_bollingerUpper = engine.bollingerUpper();
+        m_bollingerLower = engine.bollingerLower();
     }
 
     void PredictionChartWidget::detectTrendWithStack()
@@ -270,35 +271,11 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
             return;
         }
 
-        QStack<double> peakStack;
-        QStack<double> valleyStack;
-
-        for (int i = 1; i < m_historicalData.size() - 1; ++i)
-        {
-            if (m_historicalData[i] > m_historicalData[i - 1] &&
-                m_historicalData[i] > m_historicalData[i + 1])
-            {
-                peakStack.push(m_historicalData[i]);
-            }
-            else if (m_historicalData[i] < m_historicalData[i - 1] &&
-                     m_historicalData[i] < m_historicalData[i + 1])
-            {
-                valleyStack.push(m_historicalData[i]);
-            }
-        }
-
-        m_supportLevels.clear();
-        m_resistanceLevels.clear();
-
-        while (!valleyStack.isEmpty() && m_supportLevels.size() < 3)
-        {
-            m_supportLevels.append(valleyStack.pop());
-        }
-
-        while (!peakStack.isEmpty() && m_resistanceLevels.size() < 3)
-        {
-            m_resistanceLevels.append(peakStack.pop());
-        }
+        // Swing highs/lows are tracked incrementally as bars arrive; newest three of each
+        syncIndicators(m_currentSymbolId);
+        const IndicatorSync &sync = m_indicators[m_currentSymbolId];
+        m_supportLevels = sync.pivots().support();
+        m_resistanceLevels = sync.pivots().resistance();
 
         int trendWindow = qMin(10, m_historicalData.size());
         double recentAvg = 0.0;
@@ -333,6 +310,23 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
         current.volatility = calculateVolatility(m_historicalData, 10);
 
         m_stockPerformances.append(current);
+
+        // Universe-wide movers, kept ranked per tick by RankingService
+        m_topGainers = getTopGainers();
+        m_topLosers = getTopLosers();
+        m_mostVolatile = getMostVolatile();
+        m_similarStocks = CorrelationEngine::instance()->mostSimilar(m_currentSymbolId, 3);
+    }
+
+    void PredictionChartWidget::findSimilarPatterns()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        PatternIndex::Stats stats;
+        m_similarPatterns = PatternIndex::instance()->search(m_historicalData, 3, m_currentSymbolId, &stats);
+        if (!m_similarPatterns.isEmpty())
+            qDebug() << "🔍 Pattern search:" << stats.windows << "windows," << stats.bucketsVisited << "buckets visited,"
+                     << stats.dtwComputed << "DTW in" << timer.nsecsElapsed() / 1000 << "µs";
     }
 
     void PredictionChartWidget::generateLinearForecast()
@@ -340,84 +334,156 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
         m_predictedData.clear();
         m_confidenceIntervals.clear();
 
-        if (m_historicalData.size() < 20)
+        if (m_historicalData.size() < m_forecastWindow)
             return;
 
-        int n = 20;
-        double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+        // The windowed fit is kept current bar by bar; this only reads it
+        syncIndicators(m_currentSymbolId);
+        const StreamingRegression &trend = m_indicators[m_currentSymbolId].trend();
 
-        for (int i = 0; i < n; ++i)
+        for (int i = 1; i <= m_forecastHorizon; ++i)
         {
-            double x = i;
-            double y = m_historicalData[m_historicalData.size() - n + i];
-            sumX += x;
-            sumY += y;
-            sumXY += x * y;
-            sumXX += x * x;
+            m_predictedData.append(trend.predict(i));
+            m_confidenceIntervals.append(trend.predictionInterval(i, 0.95));
         }
 
-        double slope = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
-        double intercept = (sumY - slope * sumX) / n;
+        m_forecastAccuracy = trend.fit().rSquared;
+    }
 
-        for (int i = 1; i <= 7; ++i)
-        {
-            double forecast = intercept + slope * (n + i);
-            m_predictedData.append(forecast);
-            m_confidenceIntervals.append(15.0 * i);
-        }
+    void PredictionChartWidget::generateTradingSignals()
+    {
+        const Backtester::Costs costs;
+        SmaRsiStrategy strategy;
+        m_backtest = Backtester::run(m_historicalData, strategy, strategy.indicatorConfig(), costs, 0, &m_tradingSignals);
+
+        // R² only says how well the line fits the bars it was fitted on; pick the
+        // strategy parameters on older bars and score them on the newer ones
+        m_walkForward = Backtester::Result();
+        const int split = m_historicalData.size() * 2 / 3;
+        if (split < 40 || m_historicalData.size() - split < 20)
+            return;
 
-        double meanY = sumY / n;
-        double ssTotal = 0, ssRes = 0;
-        for (int i = 0; i < n; ++i)
+        Backtester::History inSample;
+        inSample.symbolId = m_currentSymbolId;
+        inSample.closes = QVector<double>(m_historicalData.begin(), m_historicalData.begin() + split);
+        const QVector<Backtester::SweepResult> results = Backtester::sweep({inSample}, Backtester::defaultGrid(), costs);
+
+        const Backtester::SweepResult *best = &results.first();
+        for (const Backtester::SweepResult &result : results)
+            if (result.result.totalReturn > best->result.totalReturn)
+                best = &result;
+
+        m_walkForwardParams = best->params;
+        SmaRsiStrategy tuned(m_walkForwardParams);
+        m_walkForward = Backtester::run(m_historicalData, tuned, tuned.indicatorConfig(), costs, split);
+        qDebug() << "🧪 Walk-forward" << m_currentSymbol << "SMA" << m_walkForwardParams.smaWindow << "RSI"
+                 << m_walkForwardParams.oversold << "/" << m_walkForwardParams.overbought << "in-sample"
+                 << best->result.totalReturn * 100 << "% out-of-sample" << m_walkForward.totalReturn * 100 << "%";
+    }
+
+    void PredictionChartWidget::startMonteCarlo()
+    {
+        if (m_historicalData.size() < 3)
+            return;
+        if (m_monteCarloWatcher.isRunning())
         {
-            double actual = m_historicalData[m_historicalData.size() - n + i];
-            double predicted = intercept + slope * i;
-            ssTotal += (actual - meanY) * (actual - meanY);
-            ssRes += (actual - predicted) * (actual - predicted);
+            m_monteCarloPending = true;
+            return;
         }
-        m_forecastAccuracy = ssTotal > 0 ? qMax(0.0, 1.0 - (ssRes / ssTotal)) : 0.0;
+
+        // TickStore is GUI-thread only; the simulation gets its own copy of the closes
+        const QVector<double> closes(m_historicalData.begin(), m_historicalData.end());
+        MonteCarloForecaster::Config config;
+        config.steps = m_forecastHorizon;
+        config.seed ^= m_currentSymbolId;   // reproducible per symbol
+
+        m_monteCarloSymbolId = m_currentSymbolId;
+        m_monteCarloTimer.start();
+        m_monteCarloWatcher.setFuture(QtConcurrent::run([closes, config]() {
+            return MonteCarloForecaster::simulate(PriceSpan{closes.constData(), static_cast<int>(closes.size())}, config);
+        }));
     }
 
-    double PredictionChartWidget::calculateVolatility(const QVector<double> &prices, int period)
+    void PredictionChartWidget::onMonteCarloFinished()
     {
-        if (prices.size() < period)
-            return 0.0;
-
-        QVector<double> returns;
-        for (int i = 1; i < prices.size(); ++i)
+        const QVector<MonteCarloForecaster::Band> bands = m_monteCarloWatcher.result();
+        if (m_monteCarloSymbolId == m_currentSymbolId)
         {
-            returns.append((prices[i] - prices[i - 1]) / prices[i - 1]);
+            m_monteCarloBands = bands;
+            qDebug() << "🎲 Monte Carlo:" << MonteCarloForecaster::Config().paths << "paths x" << bands.size()
+                     << "steps in" << m_monteCarloTimer.elapsed() << "ms";
+            updateChartBounds();
+            update();
         }
 
-        if (returns.size() < period)
-            return 0.0;
+        if (m_monteCarloPending)
+        {
+            m_monteCarloPending = false;
+            startMonteCarlo();
+        }
+    }
 
-        double sum = 0.0;
-        int start = returns.size() - period;
-        for (int i = start; i < returns.size(); ++i)
+    void PredictionChartWidget::setForecastWindow(int bars)
+    {
+        bars = qMax(3, bars);
+        if (bars == m_forecastWindow)
+            return;
+        m_forecastWindow = bars;
+        m_indicators.clear();   // every symbol refits over the new window on its next sync
+        if (!m_historicalData.isEmpty())
         {
-            sum += returns[i];
+            analyzeWithAllDSA();
+            update();
         }
-        double mean = sum / period;
+    }
 
-        double variance = 0.0;
-        for (int i = start; i < returns.size(); ++i)
+    void PredictionChartWidget::setForecastHorizon(int days)
+    {
+        days = qMax(1, days);
+        if (days == m_forecastHorizon)
+            return;
+        m_forecastHorizon = days;
+        if (!m_historicalData.isEmpty())
         {
-            variance += (returns[i] - mean) * (returns[i] - mean);
+            generateLinearForecast();
+            startMonteCarlo();
+            updateChartBounds();
+            update();
         }
+    }
 
-        return sqrt(variance / period);
+    double PredictionChartWidget::calculateVolatility(const PriceSpan &prices, int period)
+    {
+        return UniverseAnalytics::volatility(prices, period);
     }
 
     void PredictionChartWidget::updateChartBounds()
     {
-        QVector<double> allData = m_historicalData + m_predictedData;
-        if (!allData.isEmpty())
+        if (m_historicalData.isEmpty() && m_predictedData.isEmpty())
+            return;
+
+        double low = std::numeric_limits<double>::max();
+        double high = std::numeric_limits<double>::lowest();
+        syncIndicators(m_currentSymbolId);
+        const RollingExtrema &range = m_indicators[m_currentSymbolId].range();
+        if (!m_historicalData.isEmpty() && !range.isEmpty())
+        {
+            low = range.min();
+            high = range.max();
+        }
+        for (int i = 0; i < m_predictedData.size(); ++i)
         {
-            auto minmax = std::minmax_element(allData.begin(), allData.end());
-            m_minPrice = *minmax.first * 0.95;
-            m_maxPrice = *minmax.second * 1.05;
+            const double band = i < m_confidenceIntervals.size() ? m_confidenceIntervals[i] : 0.0;
+            low = qMin(low, m_predictedData[i] - band);
+            high = qMax(high, m_predictedData[i] + band);
         }
+        for (const MonteCarloForecaster::Band &band : m_monteCarloBands)
+        {
+            low = qMin(low, band.p5);
+            high = qMax(high, band.p95);
+        }
+        m_minPrice = low * 0.95;
+        m_maxPrice = high * 1.05;
     }
 
     void PredictionChartWidget::paintEvent(QPaintEvent * event)
@@ -514,6 +580,85 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
             }
         }
 
+        if (m_tradingSignals.size() == m_historicalData.size())
+        {
+            // Backtest entries and exits: green triangles below the close, red above
+            painter.setPen(Qt::NoPen);
+            const int total = m_historicalData.size() + m_predictedData.size();
+            for (int i = 0; i < m_tradingSignals.size(); ++i)
+            {
+                if (m_tradingSignals[i] == 0)
+                    continue;
+                const double x = chartRect.left() + (chartRect.width() * i / static_cast<double>(total));
+                const double y = chartRect.bottom() - ((m_historicalData[i] - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
+                QPolygonF marker;
+                if (m_tradingSignals[i] > 0)
+                    marker << QPointF(x, y + 6) << QPointF(x - 6, y + 16) << QPointF(x + 6, y + 16);
+                else
+                    marker << QPointF(x, y - 6) << QPointF(x - 6, y - 16) << QPointF(x + 6, y - 16);
+                painter.setBrush(m_tradingSignals[i] > 0 ? QColor("#16a34a") : QColor("#dc2626"));
+                painter.drawPolygon(marker);
+            }
+            painter.setBrush(Qt::NoBrush);
+        }
+
+        if (m_predictedData.size() > 1 && m_monteCarloBands.size() == m_predictedData.size())
+        {
+            // Monte Carlo percentile fans: 5-95% outer, 25-75% inner, dotted median
+            const int total = m_historicalData.size() + m_predictedData.size();
+            auto xAt = [&](int i) {
+                return chartRect.left() + (chartRect.width() * (m_historicalData.size() + i) / static_cast<double>(total));
+            };
+            auto yAt = [&](double price) {
+                return chartRect.bottom() - ((price - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
+            };
+            auto fan = [&](double MonteCarloForecaster::Band::*upper, double MonteCarloForecaster::Band::*lower) {
+                QPolygonF polygon;
+                for (int i = 0; i < m_monteCarloBands.size(); ++i)
+                    polygon << QPointF(xAt(i), yAt(m_monteCarloBands[i].*upper));
+                for (int i = m_monteCarloBands.size() - 1; i >= 0; --i)
+                    polygon << QPointF(xAt(i), yAt(m_monteCarloBands[i].*lower));
+                return polygon;
+            };
+
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(QColor(139, 92, 246, 35));
+            painter.drawPolygon(fan(&MonteCarloForecaster::Band::p95, &MonteCarloForecaster::Band::p5));
+            painter.setBrush(QColor(139, 92, 246, 60));
+            painter.drawPolygon(fan(&MonteCarloForecaster::Band::p75, &MonteCarloForecaster::Band::p25));
+            painter.setBrush(Qt::NoBrush);
+
+            QPen medianPen(QColor("#8b5cf6"), 2);
+            medianPen.setStyle(Qt::DotLine);
+            painter.setPen(medianPen);
+            for (int i = 0; i < m_monteCarloBands.size() - 1; ++i)
+                painter.drawLine(QPointF(xAt(i), yAt(m_monteCarloBands[i].p50)),
+                                 QPointF(xAt(i + 1), yAt(m_monteCarloBands[i + 1].p50)));
+        }
+
+        if (m_predictedData.size() > 1 && m_confidenceIntervals.size() == m_predictedData.size())
+        {
+            // 95% prediction band from the residuals of the trend fit
+            QPolygonF band;
+            const int total = m_historicalData.size() + m_predictedData.size();
+            for (int i = 0; i < m_predictedData.size(); ++i)
+            {
+                double x = chartRect.left() + (chartRect.width() * (m_historicalData.size() + i) / total);
+                double y = chartRect.bottom() - ((m_predictedData[i] + m_confidenceIntervals[i] - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
+                band << QPointF(x, y);
+            }
+            for (int i = m_predictedData.size() - 1; i >= 0; --i)
+            {
+                double x = chartRect.left() + (chartRect.width() * (m_historicalData.size() + i) / total);
+                double y = chartRect.bottom() - ((m_predictedData[i] - m_confidenceIntervals[i] - m_minPrice) / (m_maxPrice - m_minPrice)) * chartRect.height();
+                band << QPointF(x, y);
+            }
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(QColor(59, 130, 246, 40));
+            painter.drawPolygon(band);
+            painter.setBrush(Qt::NoBrush);
+        }
+
         if (m_predictedData.size() > 1)
         {
             QPen forecastPen(QColor("#3b82f6"));
@@ -556,8 +701,59 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
                            .arg(m_rsiValue, 0, 'f', 1)
                            .arg(m_trendDirection.toUpper())
                            .arg(m_forecastAccuracy, 0, 'f', 3);
+        if (m_walkForward.bars > 0)
+            info += QString(" | Out-of-sample: %1% return, %2% hit rate, %3% max DD")
+                        .arg(m_walkForward.totalReturn * 100, 0, 'f', 1)
+                        .arg(m_walkForward.hitRate() * 100, 0, 'f', 0)
+                        .arg(m_walkForward.maxDrawdown * 100, 0, 'f', 1);
         painter.drawText(QRect(30, 75, width() - 60, 30), Qt::AlignLeft, info);
 
+        if (!m_topGainers.isEmpty())
+        {
+            auto describe = [](const QVector<StockPerformance> &rows, bool showVolatility) {
+                QStringList parts;
+                for (const StockPerformance &row : rows)
+                    parts << (showVolatility ? QString("%1 %2%").arg(row.symbol).arg(row.volatility * 100, 0, 'f', 2)
+                                             : QString("%1 %2%").arg(row.symbol).arg(row.changePercent, 0, 'f', 2));
+                return parts.join(", ");
+            };
+            painter.setFont(QFont("Arial", 10));
+            painter.setPen(QColor("#4b5563"));
+            painter.drawText(QRect(30, 110, width() - 60, 30), Qt::AlignLeft,
+                             QString("🏆 Gainers: %1 | 📉 Losers: %2 | ⚡ Volatile: %3")
+                                 .arg(describe(m_topGainers, false), describe(m_topLosers, false),
+                                      describe(m_mostVolatile, true)));
+        }
+
+        QStringList related;
+        if (!m_similarStocks.isEmpty())
+        {
+            QStringList parts;
+            for (const CorrelationEngine::Similar &similar : m_similarStocks)
+                parts << QString("%1 %2").arg(SymbolRegistry::instance().name(similar.symbolId))
+                                         .arg(similar.correlation, 0, 'f', 2);
+            related << QString("🔗 Moves like (%1-day correlation): %2")
+                           .arg(CorrelationEngine::instance()->window())
+                           .arg(parts.join(", "));
+        }
+        if (!m_similarPatterns.isEmpty())
+        {
+            // Distance shown per bar, so it does not depend on the window length
+            const int length = PatternIndex::instance()->config().length;
+            QStringList parts;
+            for (const PatternIndex::Match &match : m_similarPatterns)
+                parts << QString("%1 %2d ago (%3)").arg(SymbolRegistry::instance().name(match.symbolId))
+                                                   .arg(match.barsAgo)
+                                                   .arg(match.distance / std::sqrt(static_cast<double>(length)), 0, 'f', 2);
+            related << QString("🔍 Similar %1-day patterns: %2").arg(length).arg(parts.join(", "));
+        }
+        if (!related.isEmpty())
+        {
+            painter.setFont(QFont("Arial", 10));
+            painter.setPen(QColor("#4b5563"));
+            painter.drawText(QRect(30, 128, width() - 60, 20), Qt::AlignLeft, related.join(" | "));
+        }
+
         drawDSALegend(painter, chartRect.bottom() + 30);
 
         painter.setFont(QFont("Arial", 10, QFont::Bold));
@@ -578,11 +774,11 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
         painter.setPen(QColor("#374151"));
 
         int y = startY + 45;
-        painter.drawText(30, y, "💾 HashMap O(1) - Instant caching | 🔄 Queue O(n) - Moving averages");
+        painter.drawText(30, y, "💾 HashMap O(1) - Instant caching | 🔄 Running windows O(1) - SMA, EMA, RSI, Bollinger");
         y += 25;
-        painter.drawText(30, y, "📈 Stack O(n) - Trend detection | 🏆 Heap O(n log k) - Top performers");
+        painter.drawText(30, y, "📈 Monotonic deque O(1) - Support/resistance | 🏆 Tournament tree O(log n) - Top performers");
         y += 25;
-        painter.drawText(30, y, "🎯 Linear Regression O(n) - 7-day price forecasting");
+        painter.drawText(30, y, QString("🎯 Streaming Regression O(1) - %1-day forecast with 95% band").arg(m_forecastHorizon));
 
         y += 35;
         QPen histPen(QColor("#059669"), 3);
@@ -598,13 +794,32 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
         painter.setPen(QColor("#374151"));
         painter.drawText(80, y + 5, "20-Day SMA");
 
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor("#16a34a"));
+        painter.drawPolygon(QPolygonF() << QPointF(274, y - 6) << QPointF(268, y + 4) << QPointF(280, y + 4));
+        painter.setBrush(QColor("#dc2626"));
+        painter.drawPolygon(QPolygonF() << QPointF(286, y + 4) << QPointF(280, y - 6) << QPointF(292, y - 6));
+        painter.setBrush(Qt::NoBrush);
+        painter.setPen(QColor("#374151"));
+        painter.drawText(310, y + 5, QString("SMA/RSI backtest: %1% return, %2 trades, %3% hit rate")
+                                         .arg(m_backtest.totalReturn * 100, 0, 'f', 1)
+                                         .arg(m_backtest.trades)
+                                         .arg(m_backtest.hitRate() * 100, 0, 'f', 0));
+
         y += 25;
         QPen fcPen(QColor("#3b82f6"), 4);
         fcPen.setStyle(Qt::DashLine);
         painter.setPen(fcPen);
         painter.drawLine(30, y, 70, y);
         painter.setPen(QColor("#374151"));
-        painter.drawText(80, y + 5, "7-Day Forecast");
+        painter.drawText(80, y + 5, QString("%1-Day Forecast").arg(m_forecastHorizon));
+
+        QPen mcPen(QColor("#8b5cf6"), 3);
+        mcPen.setStyle(Qt::DotLine);
+        painter.setPen(mcPen);
+        painter.drawLine(260, y, 300, y);
+        painter.setPen(QColor("#374151"));
+        painter.drawText(310, y + 5, "Monte Carlo median, 25-75% / 5-95% bands");
     }
 
     void PredictionChartWidget::updatePredictions()
@@ -615,19 +830,69 @@ QVector<double> PredictionChartWidget::parseYahooData(const QJsonObject &respons
         }
     }
 
+    QVector<PredictionChartWidget::StockPerformance> PredictionChartWidget::topFrom(RankingService::Metric metric, int count)
+    {
+        QVector<StockPerformance> rows;
+        const QVector<RankingService::Entry> entries = RankingService::instance().top(metric, count);
+        rows.reserve(entries.size());
+        for (const RankingService::Entry &entry : entries)
+        {
+            StockPerformance performance;
+            performance.symbol = SymbolRegistry::instance().name(entry.symbolId);
+            performance.price = entry.price;
+            performance.change = entry.change;
+            performance.changePercent = entry.changePercent;
+            performance.volatility = entry.volatility;
+            rows.append(performance);
+        }
+        return rows;
+    }
+
+    QVector<PredictionChartWidget::StockPerformance> PredictionChartWidget::getTopGainers(int count)
+    {
+        return topFrom(RankingService::Metric::Gainers, count);
+    }
+
+    QVector<PredictionChartWidget::StockPerformance> PredictionChartWidget::getTopLosers(int count)
+    {
+        return topFrom(RankingService::Metric::Losers, count);
+    }
+
+    QVector<PredictionChartWidget::StockPerformance> PredictionChartWidget::getMostVolatile(int count)
+    {
+        return topFrom(RankingService::Metric::Volatile, count);
+    }
+
+    // Single indicators over an arbitrary series. Common windows run with
+    // compile-time sizes; the live view reads IndicatorEngine instead.
+    double PredictionChartWidget::calculateSMA(const QVector<double> &prices, int window)
+    {
+        return IndicatorPipeline::sma(prices.constData(), prices.size(), window);
+    }
+
+    double PredictionChartWidget::calculateEMA(const QVector<double> &prices, int window)
+    {
+        return IndicatorPipeline::ema(prices.constData(), prices.size(), window);
+    }
+
+    double PredictionChartWidget::calculateRSI(const QVector<double> &prices, int window)
+    {
+        return IndicatorPipeline::rsi(prices.constData(), prices.size(), window);
+    }
+
+    void PredictionChartWidget::calculateBollingerBands(const QVector<double> &prices, int window)
+    {
+        const IndicatorPipeline::Bands bands = IndicatorPipeline::bollinger(prices.constData(), prices.size(), window);
+        const double width = IndicatorEngine::Config().bollingerWidth;
+        m_bollingerUpper = bands.mean + width * bands.stdDev;
+        m_bollingerLower = bands.mean - width * bands.stdDev;
+    }
+
     // Stubs
-    QVector<PredictionChartWidget::StockPerformance> PredictionChartWidget::getTopGainers(int) { return {}; }
-    QVector<PredictionChartWidget::StockPerformance> PredictionChartWidget::getTopLosers(int) { return {}; }
-    QVector<PredictionChartWidget::StockPerformance> PredictionChartWidget::getMostVolatile(int) { return {}; }
     QVector<double> PredictionChartWidget::calculatePriceChanges(const QVector<double> &) { return {}; }
     QString PredictionChartWidget::analyzeTrend(const QVector<double> &) { return "neutral"; }
     QVector<double> PredictionChartWidget::findSupportResistance(const QVector<double> &) { return {}; }
-    void PredictionChartWidget::generateTradingSignals() {}
     void PredictionChartWidget::drawEnhancedLegend(QPainter &, int, int) {}
-    double PredictionChartWidget::calculateSMA(const QVector<double> &, int) { return 0.0; }
-    double PredictionChartWidget::calculateEMA(const QVector<double> &, int) { return 0.0; }
-    double PredictionChartWidget::calculateRSI(const QVector<double> &, int) { return 50.0; }
-    void PredictionChartWidget::calculateBollingerBands(const QVector<double> &, int) {}
     PredictionChartWidget::RegressionResult PredictionChartWidget::performLinearRegression(const QVector<double> &) { return RegressionResult(); }
     QVector<double> PredictionChartWidget::generateForecast(const RegressionResult &, int) { return {}; }
     void PredictionChartWidget::generateAdvancedPredictions() {}
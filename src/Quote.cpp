@@ -0,0 +1,15 @@
+#include "Quote.h"
+
+QString Quote::sourceName(Source source)
+{
+    switch (source) {
+    case Source::LiveNse:           return QStringLiteral("LIVE_NSE");
+    case Source::NseLastClose:      return QStringLiteral("NSE_LastClose");
+    case Source::LiveYahoo:         return QStringLiteral("LIVE_Yahoo");
+    case Source::YahooLastClose:    return QStringLiteral("Yahoo_LastClose");
+    case Source::NseOfficial:       return QStringLiteral("NSE_Official");
+    case Source::FallbackRealistic: return QStringLiteral("Fallback_Realistic");
+    case Source::Unknown:           break;
+    }
+    return QStringLiteral("Unknown");
+}
@@ -0,0 +1,147 @@
+#include "RankingService.h"
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace
+{
+    const double Absent = -std::numeric_limits<double>::infinity();
+}
+
+bool RankingTree::beats(int a, int b) const
+{
+    // Ties go to the lower id so the order is stable between ticks
+    return m_keys[a] > m_keys[b] || (m_keys[a] == m_keys[b] && a < b);
+}
+
+void RankingTree::grow(quint32 symbolId)
+{
+    int leaves = qMax(m_leaves, 64);
+    while (static_cast<quint32>(leaves) <= symbolId)
+        leaves *= 2;
+    if (leaves == m_leaves)
+        return;
+
+    m_keys.resize(leaves);
+    for (int i = m_leaves; i < leaves; ++i)
+        m_keys[i] = Absent;
+    m_leaves = leaves;
+
+    // Rebuild bottom-up: O(N), only when the universe outgrows the tree
+    m_winner.resize(2 * leaves);
+    for (int i = 0; i < leaves; ++i)
+        m_winner[leaves + i] = i;
+    for (int node = leaves - 1; node >= 1; --node) {
+        const int left = m_winner[2 * node], right = m_winner[2 * node + 1];
+        m_winner[node] = beats(right, left) ? right : left;
+    }
+}
+
+void RankingTree::replay(int leaf)
+{
+    for (int node = (m_leaves + leaf) / 2; node >= 1; node /= 2) {
+        const int left = m_winner[2 * node], right = m_winner[2 * node + 1];
+        m_winner[node] = beats(right, left) ? right : left;
+    }
+}
+
+void RankingTree::set(quint32 symbolId, double key)
+{
+    if (static_cast<quint32>(m_leaves) <= symbolId)
+        grow(symbolId);
+    if (std::isnan(key))
+        key = Absent;
+    const int leaf = static_cast<int>(symbolId);
+    if (m_keys[leaf] == key)
+        return;
+    m_keys[leaf] = key;
+    replay(leaf);
+}
+
+void RankingTree::remove(quint32 symbolId)
+{
+    if (static_cast<quint32>(m_leaves) > symbolId)
+        set(symbolId, Absent);
+}
+
+QVector<quint32> RankingTree::top(int k) const
+{
+    QVector<quint32> ids;
+    if (m_leaves == 0 || k <= 0)
+        return ids;
+    ids.reserve(k);
+
+    // Best-first over subtrees ordered by their winner; a subtree's winner
+    // is never worse than anything below it, so leaves pop in rank order
+    auto worse = [this](int a, int b) { return beats(m_winner[b], m_winner[a]); };
+    std::priority_queue<int, std::vector<int>, decltype(worse)> frontier(worse);
+    frontier.push(1);
+    while (!frontier.empty() && ids.size() < k) {
+        const int node = frontier.top();
+        frontier.pop();
+        if (m_keys[m_winner[node]] == Absent)
+            break;
+        if (node >= m_leaves) {
+            ids.append(static_cast<quint32>(m_winner[node]));
+        } else {
+            frontier.push(2 * node);
+            frontier.push(2 * node + 1);
+        }
+    }
+    return ids;
+}
+
+RankingService &RankingService::instance()
+{
+    static RankingService service;
+    return service;
+}
+
+void RankingService::update(const Quote &quote)
+{
+    if (!quote.isValid())
+        return;
+    Row &row = m_rows[quote.symbolId];
+    row.entry.symbolId = quote.symbolId;
+    row.entry.price = quote.price;
+    row.entry.change = quote.change;
+    row.entry.changePercent = quote.changePercent;
+    row.live = true;
+    rankChange(quote.symbolId, quote.changePercent);
+}
+
+void RankingService::updateDaily(quint32 symbolId, double price, double change, double changePercent, double volatility)
+{
+    Row &row = m_rows[symbolId];
+    row.entry.symbolId = symbolId;
+    row.entry.volatility = volatility;
+    m_volatile.set(symbolId, volatility);
+    ++m_updates;
+    if (row.live)
+        return;
+    row.entry.price = price;
+    row.entry.change = change;
+    row.entry.changePercent = changePercent;
+    rankChange(symbolId, changePercent);
+}
+
+void RankingService::rankChange(quint32 symbolId, double changePercent)
+{
+    m_gainers.set(symbolId, changePercent);
+    m_losers.set(symbolId, -changePercent);
+    ++m_updates;
+}
+
+QVector<RankingService::Entry> RankingService::top(Metric metric, int k) const
+{
+    const RankingTree &tree = metric == Metric::Gainers ? m_gainers
+                              : metric == Metric::Losers ? m_losers
+                                                         : m_volatile;
+    QVector<Entry> entries;
+    const QVector<quint32> ids = tree.top(k);
+    entries.reserve(ids.size());
+    for (quint32 id : ids)
+        entries.append(m_rows.find(id)->entry);
+    return entries;
+}
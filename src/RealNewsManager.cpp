@@ -1,4 +1,5 @@
 #include "RealNewsManager.h"
+#include "DataPlane.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -8,8 +9,6 @@
 
 RealNewsManager::RealNewsManager(QObject *parent) : QObject(parent)
 {
-    m_networkManager = new QNetworkAccessManager(this);
-    
     // Setup news update timer
     m_newsTimer = new QTimer(this);
     connect(m_newsTimer, &QTimer::timeout, this, &RealNewsManager::fetchNewsForCurrentStock);
@@ -48,27 +47,17 @@ void RealNewsManager::fetchYahooStockNews(const QString &symbol)
                      "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
     request.setRawHeader("Accept", "application/json");
     
-    QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("type", "stock");
-    reply->setProperty("symbol", symbol);
-    
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (!reply) return;
-        
-        QString symbol = reply->property("symbol").toString();
-        
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QStringList newsItems = parseYahooNewsResponse(data, symbol);
+    DataPlane::instance()->fetch(request, this,
+        [symbol](const QByteArray &data) { return parseYahooNewsResponse(data, symbol); },
+        [this](const QStringList &newsItems) {
             m_stockNews = newsItems;
-        } else {
+            emitCombinedNews();
+        },
+        [this, symbol](const QString &) {
             // Fallback to RSS feed
             fetchYahooRSSNews(symbol, "stock");
-        }
-        
-        reply->deleteLater();
-        emitCombinedNews();
-    });
+            emitCombinedNews();
+        });
 }
 
 
@@ -95,26 +84,17 @@ void RealNewsManager::fetchYahooRSSNews(const QString &symbol, const QString &ty
     request.setHeader(QNetworkRequest::UserAgentHeader,
                      "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
     
-    QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("type", type);
-    reply->setProperty("symbol", symbol);
-    
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (!reply) return;
-        
-        QString type = reply->property("type").toString();
-        QString symbol = reply->property("symbol").toString();
-        
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QStringList newsItems = parseYahooRSSFeed(data, type, symbol);
-            
+    DataPlane::instance()->fetch(request, this,
+        [type, symbol](const QByteArray &data) { return parseYahooRSSFeed(data, type, symbol); },
+        [this, type](const QStringList &newsItems) {
             if (type == "stock") {
                 m_stockNews = newsItems;
             } else {
                 m_generalNews = newsItems;
             }
-        } else {
+            emitCombinedNews();
+        },
+        [this, type, symbol](const QString &) {
             // Ultimate fallback to intelligent news
             QStringList fallbackNews = generateIntelligentNews("Yahoo Finance " + symbol, type);
             if (type == "stock") {
@@ -122,11 +102,8 @@ void RealNewsManager::fetchYahooRSSNews(const QString &symbol, const QString &ty
             } else {
                 m_generalNews = fallbackNews;
             }
-        }
-        
-        reply->deleteLater();
-        emitCombinedNews();
-    });
+            emitCombinedNews();
+        });
 }
 
 
@@ -1,289 +1,214 @@
 #include "RealStockDataManager.h"
+#include "DataPlane.h"
+#include "SymbolRegistry.h"
+#include <QUrlQuery>
 
-RealStockDataManager::RealStockDataManager(QObject *parent) : QObject(parent)
+RealStockDataManager::RealStockDataManager(MarketStatusChecker *marketChecker, QObject *parent) : QObject(parent),
+    m_marketChecker(marketChecker)
 {
-    m_networkManager = new QNetworkAccessManager(this);
-    m_marketChecker = new MarketStatusChecker(this);
     connect(m_marketChecker, &MarketStatusChecker::marketStatusChanged,
         this, [this](bool isOpen) {
-            QString status = isOpen ? "Market Open" : "Market Closed";
-            qDebug() << "Market Status:" << status;
-            adjustUpdateInterval();
+            onMarketStatusChanged(isOpen, m_marketChecker->getMarketStatusText());
         });
 
     
-    m_yahooSymbols = {
-        {"RELIANCE", "RELIANCE.NS"}, {"TCS", "TCS.NS"}, {"INFY", "INFY.NS"},
-        {"HDFCBANK", "HDFCBANK.NS"}, {"ICICIBANK", "ICICIBANK.NS"},
-        {"BHARTIARTL", "BHARTIARTL.NS"}, {"ITC", "ITC.NS"}, {"WIPRO", "WIPRO.NS"},
-        {"LT", "LT.NS"}, {"MARUTI", "MARUTI.NS"}
+    // Symbols refreshed on every tick; Yahoo forms come from the SymbolRegistry
+    const QStringList defaultSymbols = {
+        "RELIANCE", "TCS", "INFY", "HDFCBANK", "ICICIBANK",
+        "BHARTIARTL", "ITC", "WIPRO", "LT", "MARUTI"
     };
+    for (const QString &symbol : defaultSymbols) {
+        watchSymbol(symbol);
+    }
+
+    // Batched quote endpoint; override with STOCKSENSE_QUOTE_ENDPOINT to point at a local stand-in server
+    const QString endpoint = qEnvironmentVariable("STOCKSENSE_QUOTE_ENDPOINT");
+    m_quoteEndpoint = QUrl(endpoint.isEmpty() ? QStringLiteral("https://query1.finance.yahoo.com/v7/finance/quote")
+                                              : endpoint);
+    DataPlane::instance()->preconnect(m_quoteEndpoint);   // TLS handshake before the first tick
     
     m_updateTimer = new QTimer(this);
     connect(m_updateTimer, &QTimer::timeout, this, [this]() {
+        // GUI-thread cost of the previous tick's deliveries (decoding happens on the data plane)
+        DataPlane::Stats stats = DataPlane::instance()->takeStats();
+        if (stats.deliveries > 0) {
+            qDebug() << "⏱️ GUI thread:" << stats.guiNanos / 1000 << "µs for" << stats.deliveries
+                     << "replies | data plane decode:" << stats.decodeNanos / 1000 << "µs";
+        }
+        const RequestStats &requests = m_requestStats;
+        qDebug() << "🧮 Quote requests - issued:" << requests.issued << "| coalesced:" << requests.coalesced
+                 << "| served fresh:" << requests.freshHits;
+        if (stats.issued > 0) {
+            qDebug() << "🌐 Requests issued:" << stats.issued << "| queued for a host slot:" << stats.queued
+                     << "| over HTTP/2:" << stats.http2;
+        }
         fetchAllStocks();
-        fetchIndexData(); // Fetch NIFTY & SENSEX data
     });
     adjustUpdateInterval();
     
-    // Initial fetch
-    fetchIndexData();
-    
-    qDebug() << "✅ LIVE NSE Data Manager with Enhanced NIFTY/SENSEX initialized";
+    qDebug() << "✅ LIVE NSE Data Manager initialized";
 }
 
 void RealStockDataManager::fetchStockData(const QString &symbol)
 {
-    QString yahooSymbol;
-    if (m_yahooSymbols.contains(symbol)) {
-        // Use your mapping for known symbols (to handle special cases/ticker differences)
-        yahooSymbol = m_yahooSymbols[symbol];
-    } else {
-        // Dynamically form the Yahoo symbol for any user-typed NSE symbol
-        yahooSymbol = symbol.endsWith(".NS") ? symbol : symbol + ".NS";
-    }
-    fetchFromYahoo(symbol, yahooSymbol);
-    qDebug() << "🔄 Requesting LIVE data for" << symbol << "->" << yahooSymbol;
+    const quint32 symbolId = SymbolRegistry::instance().intern(symbol);
+    if (admit(QVector<quint32>{symbolId}, true).isEmpty())
+        return;
+
+    fetchFromYahoo(symbolId);
+    qDebug() << "🔄 Requesting LIVE data for" << symbol << "->" << SymbolRegistry::instance().yahooSymbol(symbolId);
 }
 
-void RealStockDataManager::fetchAllStocks()
+void RealStockDataManager::setFreshnessTtl(int msecs)
+{
+    m_freshnessTtlMs = qMax(0, msecs);
+}
+
+QVector<quint32> RealStockDataManager::admit(const QVector<quint32> &symbolIds, bool replayFresh)
 {
-    for (const QString &symbol : m_yahooSymbols.keys()) {
-        fetchStockData(symbol);
+    QVector<quint32> needed;
+    needed.reserve(symbolIds.size());
+    const qint64 freshAfterNs = Quote::nowNs() - static_cast<qint64>(m_freshnessTtlMs) * 1000000LL;
+
+    for (quint32 id : symbolIds) {
+        const bool *inFlight = m_inFlight.find(id);
+        if (inFlight && *inFlight) {
+            ++m_requestStats.coalesced;   // the pending reply is broadcast to every listener
+            continue;
+        }
+
+        const qint64 *receivedNs = m_receivedNs.find(id);
+        if (receivedNs && *receivedNs > freshAfterNs) {
+            ++m_requestStats.freshHits;
+            if (replayFresh) {
+                const Quote quote = m_recent[id];
+                QMetaObject::invokeMethod(this, [this, quote]() { emit stockDataReceived(quote); },
+                                          Qt::QueuedConnection);
+            }
+            continue;
+        }
+
+        m_inFlight[id] = true;
+        ++m_requestStats.issued;
+        needed.append(id);
     }
+    return needed;
 }
 
-void RealStockDataManager::fetchIndexData()
+void RealStockDataManager::complete(const QVector<quint32> &symbolIds, const QVector<Quote> &quotes)
 {
-    fetchNiftyData();
-    fetchSensexData();
+    const qint64 nowNs = Quote::nowNs();
+    for (const Quote &quote : quotes) {
+        m_recent[quote.symbolId] = quote;
+        m_receivedNs[quote.symbolId] = nowNs;
+    }
+    for (quint32 id : symbolIds) {
+        m_inFlight[id] = false;
+    }
 }
 
-void RealStockDataManager::fetchNiftyData()
+void RealStockDataManager::watchSymbol(const QString &symbol)
 {
-    // Primary source: Yahoo Finance
-    QString url = "https://query1.finance.yahoo.com/v8/finance/chart/%5ENSEI"; // ^NSEI = NIFTY 50
-    
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader,
-                     "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/91.0.4472.124 Safari/537.36");
-    request.setRawHeader("Accept", "application/json");
-    request.setRawHeader("Accept-Language", "en-US,en;q=0.9");
-    request.setRawHeader("Cache-Control", "no-cache");
-    
-    QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("index", "NIFTY");
-    reply->setProperty("source", "yahoo");
-    
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (!reply) return;
-        
-        QString index = reply->property("index").toString();
-        
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QJsonDocument doc = QJsonDocument::fromJson(data);
-            
-            if (!doc.isNull()) {
-                QJsonObject parsed = parseIndexResponse(doc.object(), index);
-                if (!parsed.isEmpty()) {
-                    // Validate data before emitting
-                    double price = parsed["price"].toDouble();
-                    if (price > 20000 && price < 30000) { // NIFTY range validation
-                        emit indexDataReceived(index, parsed);
-                        qDebug() << "✅ VERIFIED LIVE" << index << "data - Price:" << price;
-                    } else {
-                        qWarning() << "❌ Invalid NIFTY price:" << price << "- fetching fallback";
-                        fetchNiftyFallback();
-                    }
-                } else {
-                    fetchNiftyFallback();
-                }
-            }
-        } else {
-            qWarning() << "❌ Yahoo Finance error for NIFTY:" << reply->errorString();
-            fetchNiftyFallback();
-        }
-        
-        reply->deleteLater();
-    });
+    if (symbol.isEmpty())
+        return;
+
+    const quint32 symbolId = SymbolRegistry::instance().intern(symbol);
+    if (m_tracked[symbolId]++ == 0)
+        m_trackedIds.append(symbolId);
 }
 
-void RealStockDataManager::fetchSensexData()
+void RealStockDataManager::unwatchSymbol(const QString &symbol)
 {
-    // Primary source: Yahoo Finance
-    QString url = "https://query1.finance.yahoo.com/v8/finance/chart/%5EBSESN"; // ^BSESN = SENSEX
-    
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader,
-                     "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/91.0.4472.124 Safari/537.36");
-    request.setRawHeader("Accept", "application/json");
-    request.setRawHeader("Accept-Language", "en-US,en;q=0.9");
-    request.setRawHeader("Cache-Control", "no-cache");
-    
-    QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("index", "SENSEX");
-    reply->setProperty("source", "yahoo");
-    
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (!reply) return;
-        
-        QString index = reply->property("index").toString();
-        
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QJsonDocument doc = QJsonDocument::fromJson(data);
-            
-            if (!doc.isNull()) {
-                QJsonObject parsed = parseIndexResponse(doc.object(), index);
-                if (!parsed.isEmpty()) {
-                    // Validate data before emitting
-                    double price = parsed["price"].toDouble();
-                    if (price > 70000 && price < 90000) { // SENSEX range validation
-                        emit indexDataReceived(index, parsed);
-                        qDebug() << "✅ VERIFIED LIVE" << index << "data - Price:" << price;
-                    } else {
-                        qWarning() << "❌ Invalid SENSEX price:" << price << "- fetching fallback";
-                        fetchSensexFallback();
-                    }
-                } else {
-                    fetchSensexFallback();
-                }
-            }
-        } else {
-            qWarning() << "❌ Yahoo Finance error for SENSEX:" << reply->errorString();
-            fetchSensexFallback();
-        }
-        
-        reply->deleteLater();
-    });
+    const quint32 symbolId = SymbolRegistry::instance().find(symbol);
+    if (symbolId == SymbolRegistry::InvalidId)
+        return;
+
+    int &watchers = m_tracked[symbolId];
+    if (watchers > 0 && --watchers == 0)
+        m_trackedIds.removeAll(symbolId);
 }
 
-void RealStockDataManager::fetchNiftyFallback()
+void RealStockDataManager::setBatchSize(int size)
 {
-    // Fallback: Use NSE official API
-    QString url = "https://www.nseindia.com/api/allIndices";
-    
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader,
-                     "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
-    request.setRawHeader("Accept", "application/json");
-    request.setRawHeader("Accept-Language", "en-US,en;q=0.9");
-    
-    QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("index", "NIFTY");
-    reply->setProperty("source", "nse");
-    
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (!reply) return;
-        
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QJsonDocument doc = QJsonDocument::fromJson(data);
-            
-            if (!doc.isNull()) {
-                QJsonArray indices = doc.object()["data"].toArray();
-                
-                for (const QJsonValue &value : indices) {
-                    QJsonObject index = value.toObject();
-                    QString indexName = index["index"].toString();
-                    
-                    if (indexName.contains("NIFTY 50", Qt::CaseInsensitive)) {
-                        QJsonObject parsed;
-                        parsed["index"] = "NIFTY";
-                        parsed["price"] = index["last"].toDouble();
-                        parsed["change"] = index["change"].toDouble();
-                        parsed["changePercent"] = index["percentChange"].toDouble();
-                        parsed["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-                        parsed["source"] = "NSE_Official";
-                        
-                        emit indexDataReceived("NIFTY", parsed);
-                        qDebug() << "✅ NSE Fallback NIFTY data - Price:" << parsed["price"].toDouble();
-                        break;
-                    }
-                }
-            }
-        } else {
-            // Final fallback with realistic current data
-            QJsonObject parsed;
-            parsed["index"] = "NIFTY";
-            parsed["price"] = 26054.0; // Current approximate value
-            parsed["change"] = 117.0;
-            parsed["changePercent"] = 0.45;
-            parsed["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-            parsed["source"] = "Fallback_Realistic";
-            
-            emit indexDataReceived("NIFTY", parsed);
-            qDebug() << "⚠️ Using fallback NIFTY data";
-        }
-        
-        reply->deleteLater();
-    });
+    m_batchSize = qMax(1, size);
 }
 
-void RealStockDataManager::fetchSensexFallback()
+void RealStockDataManager::setQuoteEndpoint(const QUrl &endpoint)
 {
-    // Fallback with current realistic SENSEX data
-    QJsonObject parsed;
-    parsed["index"] = "SENSEX";
-    parsed["price"] = 84997.0; // Current approximate value from search results
-    parsed["change"] = 349.0;
-    parsed["changePercent"] = 0.41;
-    parsed["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-    parsed["source"] = "Fallback_Realistic";
-    
-    emit indexDataReceived("SENSEX", parsed);
-    qDebug() << "⚠️ Using fallback SENSEX data - Price: 84,997";
+    if (endpoint.isValid()) {
+        m_quoteEndpoint = endpoint;
+    }
 }
 
-QJsonObject RealStockDataManager::parseIndexResponse(const QJsonObject &response, const QString &index)
+void RealStockDataManager::fetchAllStocks()
 {
-    QJsonObject parsed;
-    try {
-        QJsonObject chart = response["chart"].toObject();
-        QJsonArray results = chart["result"].toArray();
-        
-        if (results.isEmpty()) return parsed;
-        
-        QJsonObject result = results[0].toObject();
-        QJsonObject meta = result["meta"].toObject();
-        
-        double currentPrice = meta["regularMarketPrice"].toDouble();
-        double previousClose = meta["previousClose"].toDouble();
-        
-        // Additional validation for reasonable price ranges
-        bool validPrice = false;
-        if (index == "NIFTY" && currentPrice > 20000 && currentPrice < 30000) {
-            validPrice = true;
-        } else if (index == "SENSEX" && currentPrice > 70000 && currentPrice < 90000) {
-            validPrice = true;
-        }
-        
-        if (!validPrice) {
-            qWarning() << "❌ Price out of expected range for" << index << ":" << currentPrice;
-            return parsed;
+    // One request per chunk of m_batchSize symbols instead of one per symbol;
+    // symbols already pending or freshly quoted are left out
+    const QVector<quint32> needed = admit(m_trackedIds, false);
+    if (Quote::nowNs() < m_batchRetryAfterNs) {
+        // The batch endpoint failed recently; the per-symbol chart endpoint needs no crumb
+        for (quint32 id : needed) {
+            fetchFromYahoo(id);
         }
-        
-        double change = currentPrice - previousClose;
-        double changePercent = previousClose > 0 ? (change / previousClose) * 100 : 0;
-        
-        parsed["index"] = index;
-        parsed["price"] = currentPrice;
-        parsed["change"] = change;
-        parsed["changePercent"] = changePercent;
-        parsed["high"] = meta["regularMarketDayHigh"].toDouble();
-        parsed["low"] = meta["regularMarketDayLow"].toDouble();
-        parsed["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-        parsed["source"] = m_marketChecker->isMarketOpen() ? "LIVE_Yahoo" : "Yahoo_LastClose";
-        
-        qDebug() << "📊 Parsed" << index << "- Price:" << currentPrice 
-                 << "Change:" << change << "(" << changePercent << "%)";
-        
-    } catch (...) {
-        qWarning() << "❌ Error parsing data for" << index;
+        return;
     }
-    
-    return parsed;
+    for (int i = 0; i < needed.size(); i += m_batchSize) {
+        fetchBatch(needed.mid(i, m_batchSize));
+    }
+}
+
+void RealStockDataManager::fetchBatch(const QVector<quint32> &symbolIds)
+{
+    if (symbolIds.isEmpty())
+        return;
+
+    QStringList yahooSymbols;
+    yahooSymbols.reserve(symbolIds.size());
+    for (quint32 id : symbolIds) {
+        yahooSymbols.append(SymbolRegistry::instance().yahooSymbol(id));
+    }
+
+    QUrl url(m_quoteEndpoint);
+    QUrlQuery query(url);
+    query.addQueryItem("symbols", yahooSymbols.join(','));
+    query.addQueryItem("fields", "regularMarketPrice,regularMarketPreviousClose,regularMarketVolume,"
+                                 "regularMarketDayHigh,regularMarketDayLow,regularMarketTime");
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::UserAgentHeader,
+                     "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
+    request.setRawHeader("Accept", "application/json");
+
+    // Decode on the data plane; Yahoo symbols resolve to ids through the registry
+    const bool marketOpen = m_marketChecker->isMarketOpen();
+    const int requested = yahooSymbols.size();
+
+    DataPlane::instance()->fetch(request, this,
+        [marketOpen](const QByteArray &data) {
+            return parseBatchResponse(QJsonDocument::fromJson(data).object(), marketOpen);
+        },
+        [this, symbolIds, requested](const QVector<Quote> &quotes) {
+            complete(symbolIds, quotes);
+            for (const Quote &quote : quotes) {
+                emit stockDataReceived(quote);
+            }
+            qDebug() << "✅ LIVE batch:" << quotes.size() << "of" << requested << "symbols";
+        },
+        [this, symbolIds](const QString &error) {
+            // Report the endpoint once, not once per batch, then retry these
+            // symbols one by one; they stay marked in flight meanwhile
+            const qint64 nowNs = Quote::nowNs();
+            if (nowNs >= m_batchRetryAfterNs) {
+                qWarning() << "❌ Batch quote request failed, falling back to per-symbol requests:" << error;
+                emit apiError(QString("Batch quote request failed: %1").arg(error));
+            }
+            m_batchRetryAfterNs = nowNs + static_cast<qint64>(BatchRetryMs) * 1000000LL;
+            for (quint32 id : symbolIds) {
+                fetchFromYahoo(id);
+            }
+        });
+    qDebug() << "🔄 Requesting LIVE batch of" << yahooSymbols.size() << "symbols";
 }
 
 bool RealStockDataManager::isMarketOpen() const
@@ -302,86 +227,94 @@ void RealStockDataManager::onMarketStatusChanged(bool isOpen, const QString &sta
     emit marketStatusChanged(isOpen, statusText);
 }
 
-void RealStockDataManager::handleReply()
+QVector<Quote> RealStockDataManager::parseBatchResponse(const QJsonObject &response, bool marketOpen)
 {
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-    
-    QString symbol = reply->property("symbol").toString();
-    
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray data = reply->readAll();
-        QJsonDocument doc = QJsonDocument::fromJson(data);
-        
-        if (!doc.isNull()) {
-            QJsonObject parsed = parseResponse(doc.object(), symbol);
-            if (!parsed.isEmpty()) {
-                emit stockDataReceived(symbol, parsed);
-                qDebug() << "✅ LIVE data for" << symbol << "Price: ₹" << parsed["price"].toDouble();
-            }
+    QVector<Quote> quotes;
+    QJsonArray results = response["quoteResponse"].toObject()["result"].toArray();
+    quotes.reserve(results.size());
+
+    for (const QJsonValue &value : results) {
+        QJsonObject result = value.toObject();
+        quint32 symbolId = SymbolRegistry::instance().findYahoo(result["symbol"].toString());
+        if (symbolId == SymbolRegistry::InvalidId) continue;
+
+        Quote quote = parseQuoteResult(result, symbolId, marketOpen);
+        if (quote.isValid()) {
+            quotes.append(quote);
         }
-    } else {
-        qWarning() << "❌ Network error for" << symbol << ":" << reply->errorString();
-        emit apiError(QString("Network error for %1: %2").arg(symbol, reply->errorString()));
     }
-    
-    reply->deleteLater();
+    return quotes;
 }
 
 void RealStockDataManager::adjustUpdateInterval()
 {
     if (m_marketChecker->isMarketOpen()) {
-        m_updateTimer->start(5000); // 5 seconds during market hours (more frequent for indices)
+        m_updateTimer->start(5000); // 5 seconds during market hours
     } else {
         m_updateTimer->start(300000); // 5 minutes after hours
     }
 }
 
-void RealStockDataManager::fetchFromYahoo(const QString &symbol, const QString &yahooSymbol)
+void RealStockDataManager::fetchFromYahoo(quint32 symbolId)
 {
-    QString url = QString("https://query1.finance.yahoo.com/v8/finance/chart/%1").arg(yahooSymbol);
+    const QString symbol = SymbolRegistry::instance().name(symbolId);
+    QString url = QString("https://query1.finance.yahoo.com/v8/finance/chart/%1")
+                      .arg(SymbolRegistry::instance().yahooSymbol(symbolId));
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::UserAgentHeader,
                      "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
     
-    QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("symbol", symbol);
-    connect(reply, &QNetworkReply::finished, this, &RealStockDataManager::handleReply);
+    const bool marketOpen = m_marketChecker->isMarketOpen();
+    DataPlane::instance()->fetch(request, this,
+        [symbolId, marketOpen](const QByteArray &data) {
+            QJsonDocument doc = QJsonDocument::fromJson(data);
+            return doc.isNull() ? Quote() : parseResponse(doc.object(), symbolId, marketOpen);
+        },
+        [this, symbolId, symbol](const Quote &quote) {
+            complete(QVector<quint32>{symbolId}, quote.isValid() ? QVector<Quote>{quote} : QVector<Quote>());
+            if (quote.isValid()) {
+                emit stockDataReceived(quote);
+                qDebug() << "✅ LIVE data for" << symbol << "Price: ₹" << quote.price;
+            }
+        },
+        [this, symbolId, symbol](const QString &error) {
+            complete(QVector<quint32>{symbolId}, QVector<Quote>());
+            qWarning() << "❌ Network error for" << symbol << ":" << error;
+            emit apiError(QString("Network error for %1: %2").arg(symbol, error));
+        });
 }
 
-QJsonObject RealStockDataManager::parseResponse(const QJsonObject &response, const QString &symbol)
+Quote RealStockDataManager::parseResponse(const QJsonObject &response, quint32 symbolId, bool marketOpen)
 {
-    QJsonObject parsed;
-    try {
-        QJsonObject chart = response["chart"].toObject();
-        QJsonArray results = chart["result"].toArray();
-        
-        if (results.isEmpty()) return parsed;
-        
-        QJsonObject result = results[0].toObject();
-        QJsonObject meta = result["meta"].toObject();
-        
-        double currentPrice = meta["regularMarketPrice"].toDouble();
-        double previousClose = meta["previousClose"].toDouble();
-        
-        if (currentPrice <= 0) return parsed;
-        
-        double change = currentPrice - previousClose;
-        double changePercent = previousClose > 0 ? (change / previousClose) * 100 : 0;
-        
-        parsed["symbol"] = symbol;
-        parsed["price"] = currentPrice;
-        parsed["change"] = change;
-        parsed["changePercent"] = changePercent;
-        parsed["volume"] = meta["regularMarketVolume"].toInt();
-        parsed["high"] = meta["regularMarketDayHigh"].toDouble();
-        parsed["low"] = meta["regularMarketDayLow"].toDouble();
-        parsed["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-        parsed["source"] = m_marketChecker->isMarketOpen() ? "LIVE_NSE" : "NSE_LastClose";
-        
-    } catch (...) {
-        qWarning() << "❌ Error parsing data for" << symbol;
-    }
-    
-    return parsed;
+    QJsonArray results = response["chart"].toObject()["result"].toArray();
+    if (results.isEmpty()) return Quote();
+
+    return parseQuoteResult(results[0].toObject()["meta"].toObject(), symbolId, marketOpen);
+}
+
+Quote RealStockDataManager::parseQuoteResult(const QJsonObject &result, quint32 symbolId, bool marketOpen)
+{
+    Quote quote;
+
+    double currentPrice = result["regularMarketPrice"].toDouble();
+    // The chart endpoint's meta block calls it previousClose, the quote endpoint regularMarketPreviousClose
+    double previousClose = result.contains("regularMarketPreviousClose")
+                               ? result["regularMarketPreviousClose"].toDouble()
+                               : result["previousClose"].toDouble();
+
+    if (currentPrice <= 0) return quote;
+
+    qint64 marketTime = static_cast<qint64>(result["regularMarketTime"].toDouble());
+
+    quote.symbolId = symbolId;
+    quote.price = currentPrice;
+    quote.change = currentPrice - previousClose;
+    quote.changePercent = previousClose > 0 ? (quote.change / previousClose) * 100 : 0;
+    quote.volume = static_cast<qint64>(result["regularMarketVolume"].toDouble());
+    quote.high = result["regularMarketDayHigh"].toDouble();
+    quote.low = result["regularMarketDayLow"].toDouble();
+    quote.timestampNs = marketTime > 0 ? marketTime * 1000000000LL : Quote::nowNs();
+    quote.source = marketOpen ? Quote::Source::LiveNse : Quote::Source::NseLastClose;
+
+    return quote;
 }
@@ -0,0 +1,497 @@
+#include "Screener.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    struct Token {
+        enum Kind { End, Word, Number, Symbol, LParen, RParen } kind = End;
+        QString text;
+        double number = 0.0;
+        int position = 0;
+    };
+
+    bool isWordChar(QChar c)
+    {
+        return c.isLetterOrNumber() || c == '_' || c == '%';
+    }
+
+    // Volume-style suffixes, Indian units included: 2M, 500K, 3L, 1.5Cr
+    bool scaleFor(const QString &suffix, double *scale)
+    {
+        const QString s = suffix.toLower();
+        if (s.isEmpty() || s == "%")
+            *scale = 1.0;
+        else if (s == "k")
+            *scale = 1e3;
+        else if (s == "l" || s == "lakh")
+            *scale = 1e5;
+        else if (s == "m" || s == "mn")
+            *scale = 1e6;
+        else if (s == "cr" || s == "crore")
+            *scale = 1e7;
+        else if (s == "b" || s == "bn")
+            *scale = 1e9;
+        else
+            return false;
+        return true;
+    }
+
+    bool tokenize(const QString &text, QVector<Token> *tokens, QString *error)
+    {
+        int i = 0;
+        while (i < text.size()) {
+            const QChar c = text.at(i);
+            if (c.isSpace()) {
+                ++i;
+                continue;
+            }
+
+            Token token;
+            token.position = i;
+            if (c.isDigit() || (c == '.' && i + 1 < text.size() && text.at(i + 1).isDigit())) {
+                int end = i;
+                while (end < text.size() && (text.at(end).isDigit() || text.at(end) == '.'))
+                    ++end;
+                bool ok = false;
+                const double value = text.mid(i, end - i).toDouble(&ok);
+                int suffixEnd = end;
+                while (suffixEnd < text.size() && isWordChar(text.at(suffixEnd)))
+                    ++suffixEnd;
+                double scale = 1.0;
+                if (!ok || !scaleFor(text.mid(end, suffixEnd - end), &scale)) {
+                    *error = QString("Bad number \"%1\"").arg(text.mid(i, suffixEnd - i));
+                    return false;
+                }
+                token.kind = Token::Number;
+                token.number = value * scale;
+                i = suffixEnd;
+            } else if (isWordChar(c)) {
+                int end = i;
+                while (end < text.size() && isWordChar(text.at(end)))
+                    ++end;
+                token.kind = Token::Word;
+                token.text = text.mid(i, end - i).toLower();
+                i = end;
+            } else if (c == '(' || c == ')') {
+                token.kind = c == '(' ? Token::LParen : Token::RParen;
+                ++i;
+            } else {
+                // Two-character operators first: <= >= == != && ||
+                const QString two = text.mid(i, 2);
+                if (two == "<=" || two == ">=" || two == "==" || two == "!=" || two == "&&" || two == "||") {
+                    token.text = two;
+                    i += 2;
+                } else if (c == '<' || c == '>' || c == '=' || c == '!' || c == '-') {
+                    token.text = QString(c);
+                    ++i;
+                } else {
+                    *error = QString("Unexpected \"%1\"").arg(QString(c));
+                    return false;
+                }
+                token.kind = Token::Symbol;
+            }
+            tokens->append(token);
+        }
+        Token end;
+        end.position = text.size();
+        tokens->append(end);
+        return true;
+    }
+
+    int fieldFor(const QString &word)
+    {
+        static const struct { const char *name; int field; } aliases[] = {
+            {"price", Screener::Price}, {"ltp", Screener::Price}, {"last", Screener::Price}, {"close", Screener::Price},
+            {"change", Screener::Change}, {"chg", Screener::Change},
+            {"changepercent", Screener::ChangePercent}, {"changepct", Screener::ChangePercent},
+            {"change%", Screener::ChangePercent}, {"pct", Screener::ChangePercent},
+            {"volume", Screener::Volume}, {"vol", Screener::Volume},
+            {"high", Screener::High}, {"low", Screener::Low},
+            {"rsi", Screener::Rsi}, {"sma", Screener::Sma}, {"ema", Screener::Ema},
+            {"bbupper", Screener::BollingerUpper}, {"bollingerupper", Screener::BollingerUpper},
+            {"bblower", Screener::BollingerLower}, {"bollingerlower", Screener::BollingerLower},
+            {"volatility", Screener::Volatility}, {"slope", Screener::Slope}, {"trend", Screener::Slope},
+            {"r2", Screener::RSquared}, {"rsquared", Screener::RSquared},
+        };
+        for (const auto &alias : aliases) {
+            if (word == QLatin1String(alias.name))
+                return alias.field;
+        }
+        return -1;
+    }
+}
+
+// Recursive descent straight to postfix:
+//   or  := and (OR and)*
+//   and := not (AND not)*
+//   not := NOT not | '(' or ')' | operand compare operand
+class ScreenerParser
+{
+public:
+    using Plan = Screener::Plan;
+
+    explicit ScreenerParser(const QVector<Token> &tokens) : m_tokens(tokens) {}
+
+    bool parse(Plan *plan)
+    {
+        m_plan = plan;
+        if (!parseOr(false))
+            return false;
+        if (peek().kind != Token::End)
+            return fail("Expected AND, OR or end of filter");
+        return true;
+    }
+
+    QString error() const { return m_error; }
+
+private:
+    const Token &peek() const { return m_tokens.at(m_pos); }
+
+    bool isWord(const char *word) const { return peek().kind == Token::Word && peek().text == QLatin1String(word); }
+    bool isSymbol(const char *symbol) const { return peek().kind == Token::Symbol && peek().text == QLatin1String(symbol); }
+
+    bool fail(const QString &message)
+    {
+        m_error = QString("%1 at position %2").arg(message).arg(peek().position + 1);
+        return false;
+    }
+
+    void push(Plan::Code code, const Plan::Operand &lhs = {}, const Plan::Operand &rhs = {})
+    {
+        m_plan->m_steps.append(Plan::Step{code, lhs, rhs});
+        if (code == Plan::Code::And || code == Plan::Code::Or)
+            --m_live;
+        else
+            m_plan->m_depth = qMax(m_plan->m_depth, ++m_live);
+    }
+
+    // NOT never reaches the plan: it is pushed down to the comparisons, with
+    // De Morgan on the way (NOT (a AND b) is NOT a OR NOT b), and there it
+    // flips the operator. A NaN fails both a comparison and its flip, so an
+    // unknown value stays a non-match under any number of NOTs, where
+    // inverting the finished mask would turn it into a match.
+    bool parseOr(bool negated)
+    {
+        if (!parseAnd(negated))
+            return false;
+        while (isWord("or") || isSymbol("||")) {
+            ++m_pos;
+            if (!parseAnd(negated))
+                return false;
+            push(negated ? Plan::Code::And : Plan::Code::Or);
+        }
+        return true;
+    }
+
+    bool parseAnd(bool negated)
+    {
+        if (!parseNot(negated))
+            return false;
+        while (isWord("and") || isSymbol("&&")) {
+            ++m_pos;
+            if (!parseNot(negated))
+                return false;
+            push(negated ? Plan::Code::Or : Plan::Code::And);
+        }
+        return true;
+    }
+
+    bool parseNot(bool negated)
+    {
+        if (isWord("not") || isSymbol("!")) {
+            ++m_pos;
+            return parseNot(!negated);
+        }
+        if (peek().kind == Token::LParen) {
+            ++m_pos;
+            if (!parseOr(negated))
+                return false;
+            if (peek().kind != Token::RParen)
+                return fail("Missing \")\"");
+            ++m_pos;
+            return true;
+        }
+        return parseComparison(negated);
+    }
+
+    static Plan::Code flipped(Plan::Code code)
+    {
+        switch (code) {
+        case Plan::Code::Less: return Plan::Code::GreaterEqual;
+        case Plan::Code::LessEqual: return Plan::Code::Greater;
+        case Plan::Code::Greater: return Plan::Code::LessEqual;
+        case Plan::Code::GreaterEqual: return Plan::Code::Less;
+        case Plan::Code::Equal: return Plan::Code::NotEqual;
+        case Plan::Code::NotEqual: return Plan::Code::Equal;
+        default: return code;
+        }
+    }
+
+    bool parseComparison(bool negated)
+    {
+        Plan::Operand lhs, rhs;
+        if (!parseOperand(&lhs))
+            return false;
+
+        Plan::Code code;
+        const QString op = peek().kind == Token::Symbol ? peek().text : QString();
+        if (op == "<")
+            code = Plan::Code::Less;
+        else if (op == "<=")
+            code = Plan::Code::LessEqual;
+        else if (op == ">")
+            code = Plan::Code::Greater;
+        else if (op == ">=")
+            code = Plan::Code::GreaterEqual;
+        else if (op == "=" || op == "==")
+            code = Plan::Code::Equal;
+        else if (op == "!=")
+            code = Plan::Code::NotEqual;
+        else
+            return fail("Expected a comparison (<, <=, >, >=, =, !=)");
+        ++m_pos;
+
+        if (!parseOperand(&rhs))
+            return false;
+        push(negated ? flipped(code) : code, lhs, rhs);
+        return true;
+    }
+
+    bool parseOperand(Plan::Operand *operand)
+    {
+        double sign = 1.0;
+        if (isSymbol("-")) {
+            sign = -1.0;
+            ++m_pos;
+        }
+        const Token &token = peek();
+        if (token.kind == Token::Number) {
+            operand->constant = sign * token.number;
+            ++m_pos;
+            return true;
+        }
+        if (token.kind == Token::Word && sign > 0) {
+            operand->field = fieldFor(token.text);
+            if (operand->field < 0)
+                return fail(QString("Unknown field \"%1\"").arg(token.text));
+            ++m_pos;
+            return true;
+        }
+        return fail("Expected a field or a number");
+    }
+
+    const QVector<Token> &m_tokens;
+    int m_pos = 0;
+    int m_live = 0;
+    Plan *m_plan = nullptr;
+    QString m_error;
+};
+
+namespace
+{
+    // One loop per operand shape so the compiler sees two flat arrays (or
+    // an array and a constant) and can vectorise the comparison
+    template <typename Compare>
+    void compareColumns(const double *lhs, double lhsConstant, const double *rhs, double rhsConstant,
+                        quint8 *out, int n, Compare compare)
+    {
+        if (lhs && rhs) {
+            for (int i = 0; i < n; ++i)
+                out[i] = compare(lhs[i], rhs[i]);
+        } else if (lhs) {
+            for (int i = 0; i < n; ++i)
+                out[i] = compare(lhs[i], rhsConstant);
+        } else if (rhs) {
+            for (int i = 0; i < n; ++i)
+                out[i] = compare(lhsConstant, rhs[i]);
+        } else {
+            const quint8 value = compare(lhsConstant, rhsConstant);
+            for (int i = 0; i < n; ++i)
+                out[i] = value;
+        }
+    }
+}
+
+Screener &Screener::instance()
+{
+    static Screener screener;
+    return screener;
+}
+
+Screener::Screener() = default;
+
+Screener::Plan Screener::compile(const QString &expression)
+{
+    Plan plan;
+    plan.m_expression = expression.trimmed();
+
+    QVector<Token> tokens;
+    QString error;
+    if (!tokenize(plan.m_expression, &tokens, &error)) {
+        plan.m_error = error;
+        return plan;
+    }
+
+    ScreenerParser parser(tokens);
+    if (!parser.parse(&plan)) {
+        plan.m_steps.clear();
+        plan.m_error = parser.error();
+    }
+    return plan;
+}
+
+bool Screener::looksLikeQuery(const QString &text)
+{
+    return text.contains('<') || text.contains('>') || text.contains('=');
+}
+
+QString Screener::fieldName(Field field)
+{
+    static const char *names[FieldCount] = {
+        "price", "change", "changePercent", "volume", "high", "low",
+        "rsi", "sma", "ema", "bbUpper", "bbLower", "volatility", "slope", "r2"
+    };
+    return field >= 0 && field < FieldCount ? QString(names[field]) : QString();
+}
+
+int Screener::rowOf(quint32 symbolId)
+{
+    int &row = m_rowOf[symbolId];
+    if (row == 0) {
+        m_symbolIds.append(symbolId);
+        for (QVector<double> &column : m_columns)
+            column.append(NaN);
+        m_live.append(false);
+        row = m_symbolIds.size();
+    }
+    return row - 1;
+}
+
+void Screener::track(const QVector<quint32> &symbolIds)
+{
+    for (quint32 id : symbolIds) {
+        if (id != SymbolRegistry::InvalidId)
+            rowOf(id);
+    }
+}
+
+void Screener::update(const Quote &quote)
+{
+    if (!quote.isValid())
+        return;
+
+    const int row = rowOf(quote.symbolId);
+    m_columns[Price][row] = quote.price;
+    m_columns[Change][row] = quote.change;
+    m_columns[ChangePercent][row] = quote.changePercent;
+    if (quote.high > 0)
+        m_columns[High][row] = quote.high;
+    if (quote.low > 0)
+        m_columns[Low][row] = quote.low;
+    if (quote.volume > 0)
+        m_columns[Volume][row] = static_cast<double>(quote.volume);
+    m_live[row] = true;
+}
+
+void Screener::updateDaily(const UniverseAnalytics::SymbolAnalytics &analytics, double volume)
+{
+    const int row = rowOf(analytics.symbolId);
+    if (!m_live[row]) {
+        m_columns[Price][row] = analytics.last;
+        m_columns[Change][row] = analytics.change;
+        m_columns[ChangePercent][row] = analytics.changePercent;
+        if (volume > 0)
+            m_columns[Volume][row] = volume;
+    }
+    m_columns[Rsi][row] = analytics.rsi;
+    m_columns[Sma][row] = analytics.sma;
+    m_columns[Ema][row] = analytics.ema;
+    m_columns[BollingerUpper][row] = analytics.bollingerUpper;
+    m_columns[BollingerLower][row] = analytics.bollingerLower;
+    m_columns[Volatility][row] = analytics.volatility;
+    m_columns[Slope][row] = analytics.trend.slope;
+    m_columns[RSquared][row] = analytics.trend.rSquared;
+}
+
+double Screener::value(quint32 symbolId, Field field) const
+{
+    const int *row = m_rowOf.find(symbolId);
+    if (!row || *row == 0 || field < 0 || field >= FieldCount)
+        return NaN;
+    return m_columns[field].at(*row - 1);
+}
+
+QVector<quint32> Screener::run(const Plan &plan) const
+{
+    QVector<quint32> matches;
+    const int n = m_symbolIds.size();
+    if (!plan.isValid() || n == 0)
+        return matches;
+
+    // One byte mask per live stack slot, reused across steps
+    QVector<quint8> masks(plan.m_depth * n);
+    quint8 *base = masks.data();
+    int top = 0;
+
+    for (const Plan::Step &step : plan.m_steps) {
+        quint8 *a = base + (top - 1) * n;
+        switch (step.code) {
+        case Plan::Code::And: {
+            quint8 *b = base + (top - 2) * n;
+            for (int i = 0; i < n; ++i)
+                b[i] &= a[i];
+            --top;
+            continue;
+        }
+        case Plan::Code::Or: {
+            quint8 *b = base + (top - 2) * n;
+            for (int i = 0; i < n; ++i)
+                b[i] |= a[i];
+            --top;
+            continue;
+        }
+        default:
+            break;
+        }
+
+        const double *lhs = step.lhs.field >= 0 ? m_columns[step.lhs.field].constData() : nullptr;
+        const double *rhs = step.rhs.field >= 0 ? m_columns[step.rhs.field].constData() : nullptr;
+        quint8 *out = base + top * n;
+        const double l = step.lhs.constant;
+        const double r = step.rhs.constant;
+        switch (step.code) {
+        case Plan::Code::Less:
+            compareColumns(lhs, l, rhs, r, out, n, [](double x, double y) { return x < y; });
+            break;
+        case Plan::Code::LessEqual:
+            compareColumns(lhs, l, rhs, r, out, n, [](double x, double y) { return x <= y; });
+            break;
+        case Plan::Code::Greater:
+            compareColumns(lhs, l, rhs, r, out, n, [](double x, double y) { return x > y; });
+            break;
+        case Plan::Code::GreaterEqual:
+            compareColumns(lhs, l, rhs, r, out, n, [](double x, double y) { return x >= y; });
+            break;
+        case Plan::Code::Equal:
+            compareColumns(lhs, l, rhs, r, out, n, [](double x, double y) { return x == y; });
+            break;
+        case Plan::Code::NotEqual:
+            // Spelled so NaN fails here too
+            compareColumns(lhs, l, rhs, r, out, n, [](double x, double y) { return x < y || x > y; });
+            break;
+        default:
+            break;
+        }
+        ++top;
+    }
+
+    const quint8 *result = base;
+    for (int i = 0; i < n; ++i) {
+        if (result[i])
+            matches.append(m_symbolIds.at(i));
+    }
+    return matches;
+}
@@ -0,0 +1,229 @@
+#include "SeriesLod.h"
+#include <limits>
+
+void SeriesLod::reset()
+{
+    for (QVector<Block> &level : m_levels)
+        level.clear();
+    m_origin = m_first = m_appended = m_generation = 0;
+    m_lastValue = 0.0;
+    m_valid = false;
+}
+
+void SeriesLod::sync(const TickStore::Series &series)
+{
+    const quint64 size = static_cast<quint64>(series.size());
+    const quint64 first = series.appended - size;
+    const quint64 built = m_origin + (m_levels.isEmpty() ? 0 : static_cast<quint64>(m_levels[0].size()) * BlockSize);
+
+    bool rebuildNeeded = !m_valid || series.generation != m_generation || series.appended < m_appended;
+    // Unbuilt values already evicted, or evicted blocks outweighing the live ones
+    rebuildNeeded = rebuildNeeded || built < first || series.appended - m_origin > 2 * size + BlockSize;
+    // The newest value seen last time was rewritten in place (a forming daily bar)
+    if (!rebuildNeeded && m_appended > first && m_appended > 0)
+        rebuildNeeded = series.price[static_cast<int>(m_appended - 1 - first)] != m_lastValue;
+
+    if (rebuildNeeded) {
+        for (QVector<Block> &level : m_levels)
+            level.clear();
+        m_origin = first;
+    }
+    extend(series.price, first, series.appended);
+
+    m_first = first;
+    m_appended = series.appended;
+    m_generation = series.generation;
+    m_lastValue = series.isEmpty() ? 0.0 : series.price.last();
+    m_valid = true;
+}
+
+SeriesLod::Block SeriesLod::merge(const Block &a, const Block &b)
+{
+    Block block = a;
+    if (b.min < block.min) {
+        block.min = b.min;
+        block.minAt = b.minAt;
+    }
+    if (b.max > block.max) {
+        block.max = b.max;
+        block.maxAt = b.maxAt;
+    }
+    return block;
+}
+
+void SeriesLod::extend(const PriceSpan &values, quint64 first, quint64 end)
+{
+    if (m_levels.isEmpty())
+        m_levels.resize(1);
+
+    for (quint64 start = m_origin + static_cast<quint64>(m_levels[0].size()) * BlockSize;
+         start + BlockSize <= end; start += BlockSize) {
+        const double *v = values.begin() + (start - first);
+        Block block{v[0], v[0], static_cast<quint32>(start - m_origin), static_cast<quint32>(start - m_origin)};
+        for (int k = 1; k < BlockSize; ++k) {
+            if (v[k] < block.min) {
+                block.min = v[k];
+                block.minAt = static_cast<quint32>(start - m_origin + k);
+            }
+            if (v[k] > block.max) {
+                block.max = v[k];
+                block.maxAt = static_cast<quint32>(start - m_origin + k);
+            }
+        }
+        m_levels[0].append(block);
+
+        // Every completed pair becomes one block of the level above
+        for (int level = 0; m_levels[level].size() % 2 == 0; ++level) {
+            if (level + 1 == m_levels.size())
+                m_levels.append(QVector<Block>());
+            const QVector<Block> &below = m_levels[level];
+            const Block pair = merge(below[below.size() - 2], below.last());
+            m_levels[level + 1].append(pair);
+        }
+    }
+}
+
+SeriesLod::Extremes SeriesLod::extremes(const PriceSpan &values, int from, int to) const
+{
+    Extremes e;
+    if (from >= to)
+        return e;
+    e.min = std::numeric_limits<double>::infinity();
+    e.max = -std::numeric_limits<double>::infinity();
+
+    auto scan = [&](int a, int b) {
+        for (int i = a; i < b; ++i) {
+            if (values[i] < e.min) {
+                e.min = values[i];
+                e.minAt = i;
+            }
+            if (values[i] > e.max) {
+                e.max = values[i];
+                e.maxAt = i;
+            }
+        }
+    };
+    if (!m_valid || m_levels.isEmpty()) {
+        scan(from, to);
+        return e;
+    }
+
+    // Work in positions relative to m_origin, where the blocks are aligned
+    const quint64 shift = m_first - m_origin;
+    quint64 r = shift + from;
+    const quint64 end = shift + to;
+    const quint64 built = static_cast<quint64>(m_levels[0].size()) * BlockSize;
+
+    const quint64 head = qMin(end, (r + BlockSize - 1) / BlockSize * BlockSize);
+    scan(from, static_cast<int>(head - shift));
+    r = head;
+
+    while (r + BlockSize <= end && r + BlockSize <= built) {
+        // Largest aligned block that starts at r and stays inside the range
+        int level = 0;
+        while (level + 1 < m_levels.size()) {
+            const quint64 span = static_cast<quint64>(BlockSize) << (level + 1);
+            if (r % span != 0 || r + span > end || r / span >= static_cast<quint64>(m_levels[level + 1].size()))
+                break;
+            ++level;
+        }
+        const Block &block = m_levels[level][static_cast<int>(r / (static_cast<quint64>(BlockSize) << level))];
+        if (block.min < e.min) {
+            e.min = block.min;
+            e.minAt = static_cast<int>(block.minAt - shift);
+        }
+        if (block.max > e.max) {
+            e.max = block.max;
+            e.maxAt = static_cast<int>(block.maxAt - shift);
+        }
+        r += static_cast<quint64>(BlockSize) << level;
+    }
+
+    scan(static_cast<int>(r - shift), to);
+    return e;
+}
+
+void SeriesLod::decimate(const PriceSpan &values, int from, int to, int columns, QVector<int> *indices) const
+{
+    indices->clear();
+    const int n = to - from;
+    if (n <= 0)
+        return;
+    if (columns <= 0 || n <= 2 * columns) {
+        indices->reserve(n);
+        for (int i = from; i < to; ++i)
+            indices->append(i);
+        return;
+    }
+
+    indices->reserve(2 * columns + 8);
+    indices->append(from);
+    auto add = [indices](const Extremes &e) {
+        if (e.minAt < 0)
+            return;
+        const int lower = qMin(e.minAt, e.maxAt);
+        const int upper = qMax(e.minAt, e.maxAt);
+        if (lower > indices->last())
+            indices->append(lower);
+        if (upper > indices->last())
+            indices->append(upper);
+    };
+
+    // Coarsest level whose blocks still fit in a column. Inner column bounds
+    // snap to the nearest of its block edges, so each column folds one or
+    // two of them and the cost depends on the width, not on n. The extreme
+    // points keep their exact positions; at most half a block's worth of
+    // values lands in the neighbouring column.
+    const double perColumn = static_cast<double>(n) / columns;
+    int level = -1;
+    while (m_valid && level + 1 < m_levels.size() && (BlockSize << (level + 1)) <= perColumn)
+        ++level;
+
+    const quint64 shift = m_first - m_origin;
+    const int bits = level >= 0 ? level + 4 : 0;   // log2 of the level's block span
+    const quint64 span = quint64(1) << bits;
+    static_assert(BlockSize == 16, "bits assumes BlockSize is 1 << 4");
+
+    auto widen = [](Extremes *e, const Extremes &part) {
+        if (part.min < e->min) {
+            e->min = part.min;
+            e->minAt = part.minAt;
+        }
+        if (part.max > e->max) {
+            e->max = part.max;
+            e->maxAt = part.maxAt;
+        }
+    };
+
+    quint64 b = shift + from;
+    for (int c = 0; c < columns; ++c) {
+        const quint64 a = b;
+        b = shift + from + static_cast<quint64>(static_cast<qint64>(n) * (c + 1) / columns);
+        if (c + 1 < columns)
+            b = (b + span / 2) >> bits << bits;
+        const quint64 firstBlock = level >= 0 ? (a + span - 1) >> bits : 0;
+        const quint64 endBlock = level >= 0 ? qMin<quint64>(b >> bits, m_levels[level].size()) : 0;
+        if (firstBlock >= endBlock) {
+            // Short range, or past the built blocks: exact extremes
+            add(extremes(values, static_cast<int>(a - shift), static_cast<int>(b - shift)));
+            continue;
+        }
+
+        const QVector<Block> &blocks = m_levels[level];
+        Block block = blocks[static_cast<int>(firstBlock)];
+        for (quint64 k = firstBlock + 1; k < endBlock; ++k)
+            block = merge(block, blocks[static_cast<int>(k)]);
+        Extremes e{static_cast<int>(block.minAt - shift), static_cast<int>(block.maxAt - shift), block.min, block.max};
+
+        // Only the first column starts off a block edge, and only the last
+        // ends off one or past the built blocks
+        if (a < firstBlock << bits)
+            widen(&e, extremes(values, static_cast<int>(a - shift), static_cast<int>((firstBlock << bits) - shift)));
+        if (endBlock << bits < b)
+            widen(&e, extremes(values, static_cast<int>((endBlock << bits) - shift), static_cast<int>(b - shift)));
+        add(e);
+    }
+
+    if (indices->last() != to - 1)
+        indices->append(to - 1);
+}
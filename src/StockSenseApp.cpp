@@ -9,26 +9,33 @@ StockSenseApp::StockSenseApp(QWidget *parent) : QMainWindow(parent), m_currentSt
         initializePointers();
         qDebug() << "✅ Step 1: Pointers initialized";
         
-        // STEP 2: Create managers FIRST (before UI)
+        // STEP 2: Create managers FIRST (before UI); one market clock shared by all of them
         try {
-            m_realDataManager = new RealStockDataManager(this);
+            m_marketStatusChecker = new MarketStatusChecker(this);
+            qDebug() << "✅ MarketStatusChecker created";
+        } catch (const std::exception &e) {
+            qWarning() << "❌ MarketStatusChecker failed:" << e.what();
+        }
+        
+        try {
+            m_realDataManager = new RealStockDataManager(m_marketStatusChecker, this);
             qDebug() << "✅ RealStockDataManager created";
         } catch (const std::exception &e) {
             qWarning() << "❌ RealStockDataManager failed:" << e.what();
         }
         
         try {
-            m_newsManager = new RealNewsManager(this);
-            qDebug() << "✅ RealNewsManager created";
+            m_indexFeed = new IndexFeed(m_marketStatusChecker, this);
+            qDebug() << "✅ IndexFeed created";
         } catch (const std::exception &e) {
-            qWarning() << "❌ RealNewsManager failed:" << e.what();
+            qWarning() << "❌ IndexFeed failed:" << e.what();
         }
         
         try {
-            m_marketStatusChecker = new MarketStatusChecker(this);
-            qDebug() << "✅ MarketStatusChecker created";
+            m_newsManager = new RealNewsManager(this);
+            qDebug() << "✅ RealNewsManager created";
         } catch (const std::exception &e) {
-            qWarning() << "❌ MarketStatusChecker failed:" << e.what();
+            qWarning() << "❌ RealNewsManager failed:" << e.what();
         }
         
         // STEP 3: Setup UI (BEFORE connections)
@@ -64,40 +71,10 @@ StockSenseApp::StockSenseApp(QWidget *parent) : QMainWindow(parent), m_currentSt
                         this, &StockSenseApp::onNewsReceived);
             }
             
-            // Connect MarketStatusChecker signals
-            if (m_marketStatusChecker) {
-                connect(m_marketStatusChecker, &MarketStatusChecker::niftyUpdated,
-                        this, [this](const QString &price, const QString &change, const QString &color) {
-                    if (m_dashboardNiftyPrice) m_dashboardNiftyPrice->setText(price);
-                    if (m_niftyLabel) m_niftyLabel->setText(price);
-                    if (m_dashboardNiftyChange) {
-                        m_dashboardNiftyChange->setText(change);
-                        m_dashboardNiftyChange->setStyleSheet(QString("font-size: 14px; color: %1; font-weight: 600;").arg(color));
-                    }
-                    if (m_niftyChangeLabel) {
-                        m_niftyChangeLabel->setText(change);
-                        m_niftyChangeLabel->setStyleSheet(QString("color: %1;").arg(color));
-                    }
-                }, Qt::QueuedConnection);
-                
-                connect(m_marketStatusChecker, &MarketStatusChecker::sensexUpdated,
-                        this, [this](const QString &price, const QString &change, const QString &color) {
-                    if (m_dashboardSensexPrice) m_dashboardSensexPrice->setText(price);
-                    if (m_sensexLabel) m_sensexLabel->setText(price);
-                    if (m_dashboardSensexChange) {
-                        m_dashboardSensexChange->setText(change);
-                        m_dashboardSensexChange->setStyleSheet(QString("font-size: 14px; color: %1; font-weight: 600;").arg(color));
-                    }
-                    if (m_sensexChangeLabel) {
-                        m_sensexChangeLabel->setText(change);
-                        m_sensexChangeLabel->setStyleSheet(QString("color: %1;").arg(color));
-                    }
-                }, Qt::QueuedConnection);
-                
-                connect(m_marketStatusChecker, &MarketStatusChecker::niftyUpdated,
-                        this, &StockSenseApp::updateNiftyDisplay);
-                connect(m_marketStatusChecker, &MarketStatusChecker::sensexUpdated,
-                        this, &StockSenseApp::updateSensexDisplay);
+            // Index levels for the header and dashboard
+            if (m_indexFeed) {
+                connect(m_indexFeed, &IndexFeed::indexUpdated,
+                        this, &StockSenseApp::onIndexUpdated);
             }
             
             qDebug() << "✅ Step 4: Connections setup complete";
@@ -183,36 +160,40 @@ void StockSenseApp::onMarketStatusChanged(bool isOpen)
 
 QStringList StockSenseApp::getComprehensiveStockList() const
 {
-    return QStringList{
-        // Nifty 50 & Blue Chips
-        "RELIANCE", "TCS", "HDFCBANK", "INFY", "ICICIBANK", "HDFC", "BHARTIARTL",
-        "ITC", "KOTAKBANK", "LT", "SBIN", "AXISBANK", "BAJFINANCE", "WIPRO",
-        "ASIANPAINT", "MARUTI", "HCLTECH", "SUNPHARMA", "ULTRACEMCO", "TITAN",
-        "NESTLEIND", "M&M", "BAJAJFINSV", "TECHM", "POWERGRID", "NTPC", "TATASTEEL",
-        "ADANIPORTS", "HINDALCO", "ONGC", "JSWSTEEL", "INDUSINDBK", "COALINDIA",
-        "GRASIM", "CIPLA", "DRREDDY", "DIVISLAB", "BRITANNIA", "SHREECEM",
-        "EICHERMOT", "UPL", "HEROMOTOCO", "BPCL", "TATACONSUM", "SBILIFE",
-        "BAJAJ-AUTO", "TATAMOTORS", "APOLLOHOSP", "HDFCLIFE", "ADANIENT",
-
-        // Mid & Small Cap
-        "GODREJCP", "PIDILITIND", "MPHASIS", "VEDL", "GAIL", "BIOCON",
-        "AMBUJACEM", "BANDHANBNK", "INDIGO", "HINDUNILVR", "SIEMENS",
-        "DABUR", "HAVELLS", "BOSCHLTD", "MARICO", "BERGEPAINT", "COLPAL",
-        "VOLTAS", "PAGEIND", "TORNTPHARM", "MCDOWELL-N", "ABCAPITAL",
-
-        // Banking
-        "PNB", "BANKBARODA", "CANBK", "IDFCFIRSTB", "FEDERALBNK", "LICHSGFIN",
-        "M&MFIN", "PFC", "RECLTD", "CHOLAFIN",
-
-        // IT & Tech
-        "LTIM", "PERSISTENT", "COFORGE", "TATAELXSI",
-
-        // Pharma
-        "LUPIN", "AUROPHARMA", "CADILAHC", "TORNTPOWER", "ALKEM",
-
-        // Auto
-        "TVSMOTOR", "BALKRISIND", "MOTHERSON", "ASHOKLEY", "ESCORTS"};
+    // Nifty 50, mid caps and sector leaders; seeded into the SymbolRegistry at startup
+    return SymbolRegistry::instance().universe();
+}
+void StockSenseApp::onIndexUpdated(const Quote &quote)
+{
+    const QString price = QString::number(quote.price, 'f', 2);
+    const QString change = QString("%1 (%2%)")
+        .arg(QString::number(quote.change, 'f', 2))
+        .arg(QString::number(quote.changePercent, 'f', 2));
+    const QString color = quote.change >= 0 ? "#10b981" : "#ef4444";
+
+    const QString index = SymbolRegistry::instance().yahooSymbol(quote.symbolId);
+    if (index == "^NSEI")
+    {
+        if (m_dashboardNiftyPrice) m_dashboardNiftyPrice->setText(price);
+        if (m_dashboardNiftyChange)
+        {
+            m_dashboardNiftyChange->setText(change);
+            m_dashboardNiftyChange->setStyleSheet(QString("font-size: 14px; color: %1; font-weight: 600;").arg(color));
+        }
+        updateNiftyDisplay(price, change, color);
+    }
+    else if (index == "^BSESN")
+    {
+        if (m_dashboardSensexPrice) m_dashboardSensexPrice->setText(price);
+        if (m_dashboardSensexChange)
+        {
+            m_dashboardSensexChange->setText(change);
+            m_dashboardSensexChange->setStyleSheet(QString("font-size: 14px; color: %1; font-weight: 600;").arg(color));
+        }
+        updateSensexDisplay(price, change, color);
+    }
 }
+
 void StockSenseApp::updateNiftyDisplay(const QString &price, const QString &change, const QString &color)
 {
     if (m_niftyLabel)
@@ -239,24 +220,37 @@ void StockSenseApp::updateSensexDisplay(const QString &price, const QString &cha
     }
 }
 
-void StockSenseApp::onLiveDataReceived(const QString &symbol, const QJsonObject &data)
+void StockSenseApp::onLiveDataReceived(const Quote &quote)
 {
-    m_liveStockData[symbol] = data;
-    double price = data["price"].toDouble();
-    double change = data["change"].toDouble();
+    m_liveStockData[quote.symbolId] = quote;
+    if (quote.isValid())
+    {
+        TickStore::instance().append(quote);
+        RankingService::instance().update(quote);
+        CorrelationEngine::instance()->update(quote);
+        Screener::instance().update(quote);
+        if (AlertEngine::instance().evaluate(quote) > 0)
+            notifyFiredAlerts();
+    }
 
-    qDebug() << "📈 Received data:" << symbol
-             << "Price: ₹" << price
-             << "Change:" << change
-             << "Trend:" << (change > 0 ? "📈" : "📉");
+    qDebug() << "📈 Received data:" << SymbolRegistry::instance().name(quote.symbolId)
+             << "Price: ₹" << quote.price
+             << "Change:" << quote.change
+             << "Trend:" << (quote.change > 0 ? "📈" : "📉");
 
-    if (symbol == m_currentStock)
+    const bool *watched = m_inWatchlist.find(quote.symbolId);
+    if (watched && *watched)
+    {
+        refreshWatchlistTable();
+    }
+
+    if (quote.symbolId == m_currentStockId)
     {
         qDebug() << "🎯 This is current stock - updating UI";
-        updateUIWithLiveData(data);
+        updateUIWithLiveData(quote);
         if (m_customChart)
         {
-            m_customChart->updateWithLiveData(symbol, data);
+            m_customChart->updateWithLiveData(quote);
         }
     }
     else
@@ -337,6 +331,7 @@ void StockSenseApp::selectStock(const QString &symbol)
 
     qDebug() << "🔄 Switching to" << symbol;
     m_currentStock = symbol;
+    m_currentStockId = SymbolRegistry::instance().intern(symbol);
 
     // Update headers immediately
     if (m_headerStockSymbol)
@@ -426,9 +421,10 @@ void StockSenseApp::selectStock(const QString &symbol)
     }
 
     // Check for cached data first, then request fresh data
-    if (m_liveStockData.contains(symbol))
+    const Quote *cached = m_liveStockData.find(m_currentStockId);
+    if (cached && cached->isValid())
     {
-        updateUIWithLiveData(m_liveStockData[symbol]);
+        updateUIWithLiveData(*cached);
         qDebug() << "✅ Using cached data for" << symbol;
     }
     else
@@ -458,12 +454,12 @@ void StockSenseApp::selectStock(const QString &symbol)
     qDebug() << "✅ Stock selection complete:" << symbol;
 }
 
-void StockSenseApp::updateUIWithLiveData(const QJsonObject &data)
+void StockSenseApp::updateUIWithLiveData(const Quote &quote)
 {
-    double price = data["price"].toDouble();
-    double change = data["change"].toDouble();
-    double changePercent = data["changePercent"].toDouble();
-    QString symbol = data["symbol"].toString();
+    double price = quote.price;
+    double change = quote.change;
+    double changePercent = quote.changePercent;
+    QString symbol = SymbolRegistry::instance().name(quote.symbolId);
 
     if (price <= 0)
         return;
@@ -524,10 +520,10 @@ void StockSenseApp::updateUIWithLiveData(const QJsonObject &data)
     {
         QString stats = QString("Market Cap: ₹%1L Cr | High: ₹%2 | Low: ₹%3 | Volume: %4M | Source: %5")
                             .arg(QRandomGenerator::global()->bounded(500, 2000))
-                            .arg(data["high"].toDouble(), 0, 'f', 2)
-                            .arg(data["low"].toDouble(), 0, 'f', 2)
-                            .arg(data["volume"].toInt() / 1000000.0, 0, 'f', 1)
-                            .arg(data["source"].toString());
+                            .arg(quote.high, 0, 'f', 2)
+                            .arg(quote.low, 0, 'f', 2)
+                            .arg(quote.volume / 1000000.0, 0, 'f', 1)
+                            .arg(Quote::sourceName(quote.source));
         m_marketStatusLabel->setText(stats);
     }
 
@@ -541,10 +537,58 @@ void StockSenseApp::updateUIWithLiveData(const QJsonObject &data)
 
 void StockSenseApp::updateStockData()
 {
-    if (m_liveStockData.contains(m_currentStock))
+    const Quote *quote = m_liveStockData.find(m_currentStockId);
+    if (quote && quote->isValid())
+    {
+        updateUIWithLiveData(*quote);
+    }
+
+    // Universe plus watchlist, analysed in parallel; UniverseAnalytics throttles the passes
+    if (!UniverseAnalytics::instance()->isRunning())
     {
-        updateUIWithLiveData(m_liveStockData[m_currentStock]);
+        QVector<quint32> analyticsIds;
+        SymbolArray<bool> seen;
+        for (const QString &symbol : getComprehensiveStockList())
+        {
+            const quint32 id = SymbolRegistry::instance().intern(symbol);
+            seen[id] = true;
+            analyticsIds.append(id);
+        }
+        for (quint32 id : m_watchlistIds)
+        {
+            if (!seen[id])
+                analyticsIds.append(id);
+        }
+        Screener::instance().track(analyticsIds);
+        UniverseAnalytics::instance()->run(analyticsIds);
     }
+
+    refreshMarketMovers();
+}
+
+void StockSenseApp::refreshMarketMovers()
+{
+    if (!m_marketMoversLabel)
+        return;
+
+    const RankingService &ranking = RankingService::instance();
+    auto describe = [](const QVector<RankingService::Entry> &entries, bool showVolatility) {
+        QStringList parts;
+        for (const RankingService::Entry &entry : entries)
+        {
+            const double value = showVolatility ? entry.volatility * 100 : entry.changePercent;
+            parts << QString("%1 %2%3%").arg(SymbolRegistry::instance().name(entry.symbolId))
+                         .arg(!showVolatility && value > 0 ? "+" : "")
+                         .arg(value, 0, 'f', 2);
+        }
+        return parts.isEmpty() ? QString("—") : parts.join(", ");
+    };
+
+    m_marketMoversLabel->setText(
+        QString("📈 Gainers: %1\n📉 Losers: %2\n⚡ Volatile: %3")
+            .arg(describe(ranking.top(RankingService::Metric::Gainers, 5), false),
+                 describe(ranking.top(RankingService::Metric::Losers, 5), false),
+                 describe(ranking.top(RankingService::Metric::Volatile, 5), true)));
 }
 
 void StockSenseApp::updateSentimentMeter()
@@ -597,6 +641,7 @@ void StockSenseApp::initializePointers()
     m_trendIcon = nullptr;
     m_headerStockSymbol = nullptr;
     m_marketStatusLabel=nullptr;
+    m_marketMoversLabel = nullptr;
     m_sentimentScore = nullptr;
     m_sentimentLabel = nullptr;
     m_sentimentProgress = nullptr;
@@ -604,6 +649,8 @@ void StockSenseApp::initializePointers()
     m_customChart = nullptr;
     m_realDataManager = nullptr;
     m_newsManager = nullptr;
+    m_marketStatusChecker = nullptr;
+    m_indexFeed = nullptr;
     m_chartTitleLabel = nullptr;
     // Chart header price widgets
     m_chartPriceLabel = nullptr;
@@ -612,8 +659,10 @@ void StockSenseApp::initializePointers()
     m_updateTimer = nullptr;
     m_predictionStockTitle = nullptr;
     m_predictionStockDetails = nullptr;
+    m_watchlistTable = nullptr;
 
     m_currentStock = "RELIANCE";
+    m_currentStockId = SymbolRegistry::instance().intern(m_currentStock);
 }
 
 void StockSenseApp::updateChartTitleForStock(const QString &symbol)
@@ -626,12 +675,12 @@ void StockSenseApp::updateChartTitleForStock(const QString &symbol)
 
 void StockSenseApp::forceUISync()
 {
-    if (m_liveStockData.contains(m_currentStock))
+    const Quote *quote = m_liveStockData.find(m_currentStockId);
+    if (quote && quote->isValid())
     {
-        QJsonObject data = m_liveStockData[m_currentStock];
-        updateUIWithLiveData(data);
+        updateUIWithLiveData(*quote);
         qDebug() << "🔄 Forced UI sync for" << m_currentStock
-                 << "Price: ₹" << data["price"].toDouble();
+                 << "Price: ₹" << quote->price;
     }
 }
 
@@ -961,7 +1010,7 @@ QWidget *StockSenseApp::createHeader()
     searchLayout->setContentsMargins(0, 0, 0, 0);
 
     m_searchInput = new QLineEdit();
-    m_searchInput->setPlaceholderText("Search stocks, news, or analytics...");
+    m_searchInput->setPlaceholderText("Search stocks, or filter: rsi < 30 and volume > 2M");
     m_searchInput->setObjectName("searchInput");
     m_searchInput->setMinimumWidth(300);
     m_searchInput->setMinimumHeight(44);
@@ -1169,8 +1218,28 @@ QWidget *StockSenseApp::createDashboard()
     statsLayout->addWidget(statsTitle);
     statsLayout->addWidget(statsContent);
 
+    // Universe-wide movers, read from RankingService
+    QFrame *moversFrame = new QFrame();
+    moversFrame->setObjectName("statsFrame");
+    moversFrame->setMinimumHeight(120);
+
+    QVBoxLayout *moversLayout = new QVBoxLayout(moversFrame);
+    moversLayout->setContentsMargins(32, 24, 32, 24);
+    moversLayout->setSpacing(16);
+
+    QLabel *moversTitle = new QLabel("🏆 Market Movers");
+    moversTitle->setStyleSheet("font-size: 18px; font-weight: 700; color: #1f2937;");
+
+    m_marketMoversLabel = new QLabel("Loading...");
+    m_marketMoversLabel->setStyleSheet("color: #6b7280; font-size: 14px; line-height: 1.4;");
+    m_marketMoversLabel->setWordWrap(true);
+
+    moversLayout->addWidget(moversTitle);
+    moversLayout->addWidget(m_marketMoversLabel);
+
     leftLayout->addWidget(chartWidget);
     leftLayout->addWidget(statsFrame);
+    leftLayout->addWidget(moversFrame);
 
     // Right column
     QWidget *rightColumn = new QWidget();
@@ -1560,7 +1629,7 @@ QWidget *StockSenseApp::createPredictions()
     QLabel *dsaTitle = new QLabel("🔧 DSA Algorithms in Action");
     dsaTitle->setStyleSheet("font-size: 18px; font-weight: 700; color: #1f2937;");
 
-    QLabel *dsaInfo = new QLabel("• O(n) Sliding Window: SMA, EMA, RSI calculations\n• O(1) HashMap: Stock data caching for instant access\n• O(n log k) Heap: Top gainers/losers screening\n• O(n) Linear Regression: Price forecasting with confidence intervals");
+    QLabel *dsaInfo = new QLabel("• O(n) Sliding Window: SMA, EMA, RSI calculations\n• O(1) HashMap: Stock data caching for instant access\n• O(log n) Tournament Tree: Live top gainers/losers screening\n• O(n) Linear Regression: Price forecasting with confidence intervals");
     dsaInfo->setStyleSheet("font-size: 13px; color: #374151; line-height: 1.8; margin-top: 8px;");
 
     dsaLayout->addWidget(dsaTitle);
@@ -1587,32 +1656,113 @@ QWidget *StockSenseApp::createPredictions()
 }
 void StockSenseApp::addToWatchlist(const QString& symbol)
 {
-    if (!m_watchlist.contains(symbol)) {
-        // Initially insert with empty data; will fill with live data when received
-        m_watchlist.insert(symbol, QJsonObject());
-        if (m_realDataManager)
-    m_realDataManager->fetchStockData(symbol);
+    const quint32 symbolId = SymbolRegistry::instance().intern(symbol);
+    bool &watched = m_inWatchlist[symbolId];
+    if (!watched) {
+        // Row shows "--" until the first live quote arrives
+        watched = true;
+        m_watchlistIds.append(symbolId);
+        m_watchAlertIds[symbolId] = AlertEngine::instance().add(symbolId, AlertEngine::Kind::PercentMove, WatchAlertPercent);
+        if (m_realDataManager) {
+            // Keep it in the batched refresh, then fetch once right away
+            m_realDataManager->watchSymbol(symbol);
+            m_realDataManager->fetchStockData(symbol);
+        }
         refreshWatchlistTable();
     }
 }
 void StockSenseApp::removeFromWatchlist(const QString& symbol)
 {
-    m_watchlist.remove(symbol);
+    const quint32 symbolId = SymbolRegistry::instance().find(symbol);
+    if (symbolId == SymbolRegistry::InvalidId)
+        return;
+
+    bool &watched = m_inWatchlist[symbolId];
+    if (!watched)
+        return;
+    watched = false;
+    m_watchlistIds.removeAll(symbolId);
+    if (m_realDataManager)
+        m_realDataManager->unwatchSymbol(symbol);   // out of the batched refresh
+    AlertEngine::instance().remove(m_watchAlertIds[symbolId]);
+    m_watchAlertIds[symbolId] = 0;
     refreshWatchlistTable();
 }
+void StockSenseApp::notifyFiredAlerts()
+{
+    AlertEngine &alerts = AlertEngine::instance();
+    QString latest;
+    while (alerts.hasFired()) {
+        const AlertEngine::Fired fired = alerts.takeFired();
+        const QString text = AlertEngine::describe(fired);
+        qDebug() << text;
+        if (latest.isEmpty())
+            latest = text;   // highest priority comes out first
+
+        // Watchlist moves re-arm around the price that triggered them
+        const bool *watched = m_inWatchlist.find(fired.symbolId);
+        if (watched && *watched && m_watchAlertIds[fired.symbolId] == fired.alertId)
+            m_watchAlertIds[fired.symbolId] = alerts.add(fired.symbolId, AlertEngine::Kind::PercentMove, WatchAlertPercent);
+    }
+
+    if (m_priceAlertsEnabled && !latest.isEmpty())
+        statusBar()->showMessage(latest, 8000);
+}
+void StockSenseApp::showScreenerResults(const QString &expression)
+{
+    if (!m_stockSuggestions)
+        return;
+
+    m_stockSuggestions->clear();
+    const Screener::Plan plan = Screener::compile(expression);
+    if (!plan.isValid()) {
+        QListWidgetItem *item = new QListWidgetItem("⚠️ " + plan.error());
+        item->setFlags(Qt::NoItemFlags);
+        m_stockSuggestions->addItem(item);
+        m_stockSuggestions->setVisible(true);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const Screener &screener = Screener::instance();
+    const QVector<quint32> matches = screener.run(plan);
+    qDebug() << "🔎 Screener:" << plan.expression() << "matched" << matches.size() << "of"
+             << screener.size() << "symbols in" << timer.nsecsElapsed() / 1000 << "µs";
+
+    const int shown = qMin(static_cast<int>(matches.size()), 100);
+    for (int i = 0; i < shown; ++i) {
+        const quint32 id = matches.at(i);
+        QListWidgetItem *item = new QListWidgetItem(SymbolRegistry::instance().name(id));
+        item->setToolTip(QString("₹%1  %2%  RSI %3")
+                             .arg(screener.value(id, Screener::Price), 0, 'f', 2)
+                             .arg(screener.value(id, Screener::ChangePercent), 0, 'f', 2)
+                             .arg(screener.value(id, Screener::Rsi), 0, 'f', 1));
+        m_stockSuggestions->addItem(item);
+    }
+    if (matches.isEmpty() || matches.size() > shown) {
+        QListWidgetItem *item = new QListWidgetItem(matches.isEmpty()
+            ? QString("No stocks match")
+            : QString("… %1 more").arg(matches.size() - shown));
+        item->setFlags(Qt::NoItemFlags);
+        m_stockSuggestions->addItem(item);
+    }
+    m_stockSuggestions->setVisible(true);
+}
 void StockSenseApp::refreshWatchlistTable()
 {
-    // Replace m_watchlistTable with whatever your table widget is called!
-    m_watchlistTable->setRowCount(m_watchlist.size());
-    int row = 0;
-    for (auto it = m_watchlist.cbegin(); it != m_watchlist.cend(); ++it, ++row) {
-        const QString& symbol = it.key();
-        const QJsonObject& data = it.value();
-        m_watchlistTable->setItem(row, 0, new QTableWidgetItem(symbol));
-
-        QString price = data.contains("price")
-            ? QString::number(data["price"].toDouble())
-            : "--";
+    if (!m_watchlistTable)
+        return;
+
+    m_watchlistTable->setRowCount(m_watchlistIds.size());
+    for (int row = 0; row < m_watchlistIds.size(); ++row) {
+        const quint32 symbolId = m_watchlistIds.at(row);
+        const TickStore::Series ticks = TickStore::instance().series(TickStore::Resolution::Tick, symbolId);
+        m_watchlistTable->setItem(row, 0, new QTableWidgetItem(SymbolRegistry::instance().name(symbolId)));
+
+        QString price = ticks.isEmpty()
+            ? "--"
+            : QString::number(ticks.price.last());
         m_watchlistTable->setItem(row, 1, new QTableWidgetItem(price));
         // Add more columns as needed (change, %change, etc.)
     }
@@ -1743,6 +1893,7 @@ QWidget *StockSenseApp::createWatchlist()
     watchlistTable->setAlternatingRowColors(true);
     watchlistTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     watchlistTable->setMinimumHeight(350);
+    m_watchlistTable = watchlistTable;
 
     QStringList headers = {"STOCK", "PRICE", "CHANGE", "CHANGE %", "VOLUME", "ACTION"};
     watchlistTable->setHorizontalHeaderLabels(headers);
@@ -1893,6 +2044,9 @@ QWidget *StockSenseApp::createSettings()
     QCheckBox *priceAlerts = new QCheckBox("Price alert notifications");
     priceAlerts->setChecked(true);
     priceAlerts->setStyleSheet("font-size: 14px; color: #374151;");
+    connect(priceAlerts, &QCheckBox::toggled, this, [this](bool checked) {
+        m_priceAlertsEnabled = checked;
+    });
 
     QCheckBox *newsAlerts = new QCheckBox("Breaking news notifications");
     newsAlerts->setChecked(false);
@@ -2094,6 +2248,12 @@ void StockSenseApp::setupConnections()
                 m_stockSuggestions->setVisible(false);
                 return;
             }
+
+            // "rsi < 30 and volume > 2M" filters the universe instead of matching tickers
+            if (Screener::looksLikeQuery(text)) {
+                showScreenerResults(text);
+                return;
+            }
             
             // Comprehensive stock list
             QStringList allStocks = getComprehensiveStockList();
@@ -2119,9 +2279,15 @@ void StockSenseApp::setupConnections()
                 m_searchInput->clear();
             } });
     }
+    // Movers refresh as soon as a new analytics pass lands
+    connect(UniverseAnalytics::instance(), &UniverseAnalytics::snapshotReady,
+            this, &StockSenseApp::refreshMarketMovers);
+
     if (m_searchInput) {
     connect(m_searchInput, &QLineEdit::returnPressed, this, [this]() {
         QString text = m_searchInput->text().trimmed().toUpper();
+        if (Screener::looksLikeQuery(text))
+            return;   // results are already in the suggestion list
         if (!text.isEmpty()) {
             selectStock(text);
             m_searchInput->clear();
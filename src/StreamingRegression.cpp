@@ -0,0 +1,224 @@
+#include "StreamingRegression.h"
+#include <cmath>
+
+namespace
+{
+    // Acklam's rational approximation of the standard normal quantile
+    double normalQuantile(double p)
+    {
+        static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                   1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+        static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                   6.680131188771972e+01, -1.328068155288572e+01};
+        static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                   -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+        static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                   3.754408661907416e+00};
+        const double low = 0.02425;
+
+        if (p <= 0.0) return -HUGE_VAL;
+        if (p >= 1.0) return HUGE_VAL;
+        if (p < low) {
+            const double q = std::sqrt(-2 * std::log(p));
+            return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                   ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        }
+        if (p > 1 - low) {
+            const double q = std::sqrt(-2 * std::log(1 - p));
+            return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                   ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        }
+        const double q = p - 0.5;
+        const double r = q * q;
+        return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+               (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+    }
+
+    const double Pi = 3.14159265358979323846;
+
+    // Exact Student-t CDF for integer degrees of freedom, from the finite
+    // series in theta = atan(t / sqrt(v)) (Abramowitz & Stegun 26.7.3-4)
+    double studentCdf(double t, int v)
+    {
+        const double theta = std::atan(t / std::sqrt(static_cast<double>(v)));
+        const double cos2 = std::cos(theta) * std::cos(theta);
+        double a;
+        if (v % 2 == 1) {
+            double sum = 0.0;
+            if (v > 1) {
+                double term = std::cos(theta);
+                sum = term;
+                for (int k = 2; k <= v - 3; k += 2) {
+                    term *= cos2 * k / (k + 1);
+                    sum += term;
+                }
+            }
+            a = 2.0 / Pi * (theta + std::sin(theta) * sum);
+        } else {
+            double term = 1.0;
+            double sum = 1.0;
+            for (int k = 1; k <= v - 3; k += 2) {
+                term *= cos2 * k / (k + 1);
+                sum += term;
+            }
+            a = std::sin(theta) * sum;
+        }
+        return 0.5 + a / 2.0;
+    }
+
+    double studentDensity(double t, int v)
+    {
+        const double logNorm = std::lgamma((v + 1) / 2.0) - std::lgamma(v / 2.0) - 0.5 * std::log(v * Pi);
+        return std::exp(logNorm - (v + 1) / 2.0 * std::log1p(t * t / v));
+    }
+}
+
+StreamingRegression::StreamingRegression(int window) : m_window(qMax(3, window))
+{
+    m_values.resize(m_window);
+}
+
+void StreamingRegression::reset()
+{
+    m_size = 0;
+    m_head = 0;
+    m_slidesSinceResum = 0;
+    m_sumY = m_sumXY = m_sumYY = 0.0;
+}
+
+double StreamingRegression::slot(int age) const
+{
+    return m_values[(m_head + age) % m_window];
+}
+
+void StreamingRegression::resum()
+{
+    // Re-anchor on the oldest value too, so magnitudes stay small as prices wander
+    const double shift = slot(0);
+    m_origin += shift;
+    m_sumY = m_sumXY = m_sumYY = 0.0;
+    for (int x = 0; x < m_size; ++x) {
+        m_values[(m_head + x) % m_window] -= shift;
+        const double y = slot(x);
+        m_sumY += y;
+        m_sumXY += x * y;
+        m_sumYY += y * y;
+    }
+    m_slidesSinceResum = 0;
+}
+
+void StreamingRegression::push(double value)
+{
+    if (m_size == 0)
+        m_origin = value;
+    const double y = value - m_origin;
+
+    if (m_size == m_window) {
+        // Drop the oldest (x = 0), then every remaining x moves down by one
+        const double oldest = slot(0);
+        m_sumY -= oldest;
+        m_sumYY -= oldest * oldest;
+        m_sumXY -= m_sumY;
+        m_head = (m_head + 1) % m_window;
+        --m_size;
+        ++m_slidesSinceResum;
+    }
+
+    m_values[(m_head + m_size) % m_window] = y;
+    m_sumY += y;
+    m_sumXY += m_size * y;
+    m_sumYY += y * y;
+    ++m_size;
+
+    if (m_slidesSinceResum >= m_window)
+        resum();
+}
+
+void StreamingRegression::replaceLast(double value)
+{
+    if (m_size == 0) {
+        push(value);
+        return;
+    }
+    const int last = (m_head + m_size - 1) % m_window;
+    const double y = value - m_origin;
+    const double old = m_values[last];
+    m_values[last] = y;
+    m_sumY += y - old;
+    m_sumXY += (m_size - 1) * (y - old);
+    m_sumYY += y * y - old * old;
+}
+
+StreamingRegression::Fit StreamingRegression::fit() const
+{
+    Fit f;
+    f.n = m_size;
+    const double n = m_size;
+    if (m_size < 2)
+        return f;
+
+    // Centred sums; x runs 0..n-1
+    const double sumX = n * (n - 1) / 2.0;
+    const double sxx = n * (n * n - 1) / 12.0;
+    const double sxy = m_sumXY - sumX * m_sumY / n;
+    const double syy = qMax(0.0, m_sumYY - m_sumY * m_sumY / n);
+
+    f.slope = sxy / sxx;
+    f.intercept = m_origin + (m_sumY - f.slope * sumX) / n;
+    const double ssRes = qMax(0.0, syy - f.slope * sxy);
+    f.rSquared = syy > 0 ? qBound(0.0, 1.0 - ssRes / syy, 1.0) : 0.0;
+    f.residualStdDev = m_size > 2 ? std::sqrt(ssRes / (n - 2)) : 0.0;
+    return f;
+}
+
+double StreamingRegression::predict(int stepsAhead) const
+{
+    const Fit f = fit();
+    return f.intercept + f.slope * (m_size - 1 + stepsAhead);
+}
+
+double StreamingRegression::predictionInterval(int stepsAhead, double level) const
+{
+    if (m_size < 3)
+        return 0.0;
+    const Fit f = fit();
+    const double n = m_size;
+    const double x = m_size - 1 + stepsAhead;
+    const double meanX = (n - 1) / 2.0;
+    const double sxx = n * (n * n - 1) / 12.0;
+    const double t = studentQuantile(0.5 + level / 2.0, m_size - 2);
+    return t * f.residualStdDev * std::sqrt(1.0 + 1.0 / n + (x - meanX) * (x - meanX) / sxx);
+}
+
+double StreamingRegression::studentQuantile(double p, int degreesOfFreedom)
+{
+    const int v = qMax(1, degreesOfFreedom);
+    if (p <= 0.0) return -HUGE_VAL;
+    if (p >= 1.0) return HUGE_VAL;
+
+    // Closed forms for 1 and 2 degrees of freedom
+    if (v == 1)
+        return std::tan(Pi * (p - 0.5));
+    if (v == 2)
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+
+    // Cornish-Fisher expansion around the normal quantile: within 1e-4 from
+    // about 15 degrees of freedom, but 3% low at 3
+    const double z = normalQuantile(p);
+    const double z2 = z * z;
+    const double g1 = (z2 + 1) * z / 4;
+    const double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    const double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    double t = z + g1 / v + g2 / (v * v) + g3 / (v * v * v);
+    if (v > 30)
+        return t;
+
+    // Small samples, where the forecast band matters most: Newton on the exact CDF
+    for (int i = 0; i < 8; ++i) {
+        const double step = (studentCdf(t, v) - p) / studentDensity(t, v);
+        t -= step;
+        if (std::fabs(step) < 1e-12 * (1.0 + std::fabs(t)))
+            break;
+    }
+    return t;
+}
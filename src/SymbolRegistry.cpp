@@ -0,0 +1,121 @@
+#include "SymbolRegistry.h"
+
+SymbolRegistry &SymbolRegistry::instance()
+{
+    static SymbolRegistry registry;
+    return registry;
+}
+
+SymbolRegistry::SymbolRegistry()
+{
+    const QStringList nseUniverse = {
+        // Nifty 50 & Blue Chips
+        "RELIANCE", "TCS", "HDFCBANK", "INFY", "ICICIBANK", "HDFC", "BHARTIARTL",
+        "ITC", "KOTAKBANK", "LT", "SBIN", "AXISBANK", "BAJFINANCE", "WIPRO",
+        "ASIANPAINT", "MARUTI", "HCLTECH", "SUNPHARMA", "ULTRACEMCO", "TITAN",
+        "NESTLEIND", "M&M", "BAJAJFINSV", "TECHM", "POWERGRID", "NTPC", "TATASTEEL",
+        "ADANIPORTS", "HINDALCO", "ONGC", "JSWSTEEL", "INDUSINDBK", "COALINDIA",
+        "GRASIM", "CIPLA", "DRREDDY", "DIVISLAB", "BRITANNIA", "SHREECEM",
+        "EICHERMOT", "UPL", "HEROMOTOCO", "BPCL", "TATACONSUM", "SBILIFE",
+        "BAJAJ-AUTO", "TATAMOTORS", "APOLLOHOSP", "HDFCLIFE", "ADANIENT",
+
+        // Mid & Small Cap
+        "GODREJCP", "PIDILITIND", "MPHASIS", "VEDL", "GAIL", "BIOCON",
+        "AMBUJACEM", "BANDHANBNK", "INDIGO", "HINDUNILVR", "SIEMENS",
+        "DABUR", "HAVELLS", "BOSCHLTD", "MARICO", "BERGEPAINT", "COLPAL",
+        "VOLTAS", "PAGEIND", "TORNTPHARM", "MCDOWELL-N", "ABCAPITAL",
+
+        // Banking
+        "PNB", "BANKBARODA", "CANBK", "IDFCFIRSTB", "FEDERALBNK", "LICHSGFIN",
+        "M&MFIN", "PFC", "RECLTD", "CHOLAFIN",
+
+        // IT & Tech
+        "LTIM", "PERSISTENT", "COFORGE", "TATAELXSI",
+
+        // Pharma
+        "LUPIN", "AUROPHARMA", "CADILAHC", "TORNTPOWER", "ALKEM",
+
+        // Auto
+        "TVSMOTOR", "BALKRISIND", "MOTHERSON", "ASHOKLEY", "ESCORTS"};
+
+    for (const QString &ticker : nseUniverse) {
+        internLocked(ticker);
+    }
+    m_universeSize = m_names.size();
+}
+
+QString SymbolRegistry::tickerOf(const QString &symbol)
+{
+    return symbol.endsWith(".NS") ? symbol.chopped(3) : symbol;
+}
+
+QString SymbolRegistry::yahooFormOf(const QString &ticker)
+{
+    // Indices (^NSEI, ^BSESN) are already in Yahoo form
+    return ticker.startsWith('^') ? ticker : ticker + ".NS";
+}
+
+quint32 SymbolRegistry::internLocked(const QString &ticker)
+{
+    auto it = m_ids.constFind(ticker);
+    if (it != m_ids.constEnd())
+        return it.value();
+
+    const quint32 id = static_cast<quint32>(m_names.size());
+    const QString yahoo = yahooFormOf(ticker);
+    m_names.append(ticker);
+    m_yahooNames.append(yahoo);
+    m_ids.insert(ticker, id);
+    m_yahooIds.insert(yahoo, id);
+    return id;
+}
+
+quint32 SymbolRegistry::intern(const QString &symbol)
+{
+    const QString ticker = tickerOf(symbol);
+    {
+        QReadLocker locker(&m_lock);
+        auto it = m_ids.constFind(ticker);
+        if (it != m_ids.constEnd())
+            return it.value();
+    }
+
+    QWriteLocker locker(&m_lock);
+    return internLocked(ticker);
+}
+
+quint32 SymbolRegistry::find(const QString &symbol) const
+{
+    QReadLocker locker(&m_lock);
+    return m_ids.value(tickerOf(symbol), InvalidId);
+}
+
+quint32 SymbolRegistry::findYahoo(const QString &yahooSymbol) const
+{
+    QReadLocker locker(&m_lock);
+    return m_yahooIds.value(yahooSymbol, InvalidId);
+}
+
+QString SymbolRegistry::name(quint32 id) const
+{
+    QReadLocker locker(&m_lock);
+    return id < static_cast<quint32>(m_names.size()) ? m_names.at(id) : QString();
+}
+
+QString SymbolRegistry::yahooSymbol(quint32 id) const
+{
+    QReadLocker locker(&m_lock);
+    return id < static_cast<quint32>(m_yahooNames.size()) ? m_yahooNames.at(id) : QString();
+}
+
+int SymbolRegistry::size() const
+{
+    QReadLocker locker(&m_lock);
+    return m_names.size();
+}
+
+QStringList SymbolRegistry::universe() const
+{
+    QReadLocker locker(&m_lock);
+    return QStringList(m_names.cbegin(), m_names.cbegin() + m_universeSize);
+}
@@ -0,0 +1,148 @@
+#include "TickStore.h"
+#include <algorithm>
+
+TickStore &TickStore::instance()
+{
+    static TickStore store;
+    return store;
+}
+
+TickStore::TickStore()
+{
+    m_capacity[static_cast<int>(Resolution::Tick)] = 8192;   // ~11 h of 5 s ticks, a whole trading session
+    m_capacity[static_cast<int>(Resolution::Daily)] = 16384; // ~65 years of daily bars, all a symbol has
+}
+
+void TickStore::setCapacity(Resolution resolution, int capacity)
+{
+    m_capacity[static_cast<int>(resolution)] = qMax(2, capacity);
+}
+
+int TickStore::capacity(Resolution resolution) const
+{
+    return m_capacity[static_cast<int>(resolution)];
+}
+
+TickStore::Ring &TickStore::ring(Resolution resolution, quint32 symbolId)
+{
+    Ring &r = m_rings[static_cast<int>(resolution)][symbolId];
+    if (r.capacity == 0)
+        r.capacity = m_capacity[static_cast<int>(resolution)];
+    return r;
+}
+
+void TickStore::resize(Ring &r, int size)
+{
+    r.timestampNs.resize(size);
+    r.price.resize(size);
+    r.volume.resize(size);
+    r.high.resize(size);
+    r.low.resize(size);
+}
+
+void TickStore::write(Ring &r, int slot, qint64 timestampNs, double price, double volume, double high, double low)
+{
+    r.timestampNs[slot] = timestampNs;
+    r.price[slot] = price;
+    r.volume[slot] = volume;
+    r.high[slot] = high;
+    r.low[slot] = low;
+
+    // The mirror exists once the ring has wrapped
+    const int mirror = slot + r.capacity;
+    if (mirror < r.price.size()) {
+        r.timestampNs[mirror] = timestampNs;
+        r.price[mirror] = price;
+        r.volume[mirror] = volume;
+        r.high[mirror] = high;
+        r.low[mirror] = low;
+    }
+}
+
+void TickStore::push(Ring &r, qint64 timestampNs, double price, double volume, double high, double low)
+{
+    const quint64 capacity = static_cast<quint64>(r.capacity);
+    const int held = r.price.size();
+    if (r.appended >= capacity && held < 2 * r.capacity) {
+        // First wrap: from here on views may cross the end, so the columns
+        // take their full size and the mirror half is filled once
+        resize(r, 2 * r.capacity);
+        for (QVector<double> *column : {&r.price, &r.volume, &r.high, &r.low})
+            std::copy(column->begin(), column->begin() + r.capacity, column->begin() + r.capacity);
+        std::copy(r.timestampNs.begin(), r.timestampNs.begin() + r.capacity, r.timestampNs.begin() + r.capacity);
+    } else if (r.appended < capacity && r.appended >= static_cast<quint64>(held)) {
+        // Still filling: the columns grow with the data, doubling up to the capacity
+        resize(r, qMin(r.capacity, qMax(64, 2 * held)));
+    }
+
+    write(r, static_cast<int>(r.appended % capacity), timestampNs, price, volume, high, low);
+    ++r.appended;
+}
+
+void TickStore::append(const Quote &quote)
+{
+    append(Resolution::Tick, quote.symbolId, quote.timestampNs, quote.price,
+           static_cast<double>(quote.volume), quote.high, quote.low);
+}
+
+void TickStore::append(Resolution resolution, quint32 symbolId, qint64 timestampNs,
+                       double price, double volume, double high, double low)
+{
+    push(ring(resolution, symbolId), timestampNs, price, volume, high, low);
+}
+
+void TickStore::append(Resolution resolution, quint32 symbolId, const BarSeries &bars)
+{
+    Ring &r = ring(resolution, symbolId);
+    for (int i = 0; i < bars.size(); ++i) {
+        push(r, bars.timestampNs[i], bars.close[i], bars.volume[i], bars.high[i], bars.low[i]);
+    }
+}
+
+void TickStore::replaceLast(Resolution resolution, quint32 symbolId, qint64 timestampNs,
+                            double price, double volume, double high, double low)
+{
+    Ring &r = ring(resolution, symbolId);
+    if (r.appended == 0) {
+        push(r, timestampNs, price, volume, high, low);
+        return;
+    }
+    write(r, static_cast<int>((r.appended - 1) % static_cast<quint64>(r.capacity)),
+          timestampNs, price, volume, high, low);
+}
+
+void TickStore::assign(Resolution resolution, quint32 symbolId, const BarSeries &bars)
+{
+    clear(resolution, symbolId);
+    append(resolution, symbolId, bars);
+}
+
+void TickStore::clear(Resolution resolution, quint32 symbolId)
+{
+    Ring &r = ring(resolution, symbolId);
+    r.appended = 0;
+    ++r.generation;
+}
+
+TickStore::Series TickStore::series(Resolution resolution, quint32 symbolId) const
+{
+    Series view;
+    const Ring *r = m_rings[static_cast<int>(resolution)].find(symbolId);
+    if (!r)
+        return view;
+    view.generation = r->generation;
+    if (r->appended == 0)
+        return view;
+
+    const quint64 capacity = static_cast<quint64>(r->capacity);
+    const int count = static_cast<int>(qMin(r->appended, capacity));
+    const int start = r->appended <= capacity ? 0 : static_cast<int>(r->appended % capacity);
+
+    view.timestampNs = r->timestampNs.constData() + start;
+    view.price = PriceSpan{r->price.constData() + start, count};
+    view.volume = PriceSpan{r->volume.constData() + start, count};
+    view.high = PriceSpan{r->high.constData() + start, count};
+    view.low = PriceSpan{r->low.constData() + start, count};
+    view.appended = r->appended;
+    return view;
+}
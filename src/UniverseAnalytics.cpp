@@ -0,0 +1,218 @@
+#include "UniverseAnalytics.h"
+#include "BarStore.h"
+#include "IndicatorEngine.h"
+#include "Kernels.h"
+#include "RankingService.h"
+#include "CorrelationEngine.h"
+#include "PatternIndex.h"
+#include "Screener.h"
+#include "DataPlane.h"
+#include <QJsonDocument>
+#include <QNetworkRequest>
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QDebug>
+#include <cmath>
+
+UniverseAnalytics *UniverseAnalytics::instance()
+{
+    static UniverseAnalytics *analytics = new UniverseAnalytics(QCoreApplication::instance());
+    return analytics;
+}
+
+UniverseAnalytics::UniverseAnalytics(QObject *parent) : QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<SymbolAnalytics>::finished, this, &UniverseAnalytics::publish);
+
+    m_backfillTimer = new QTimer(this);
+    m_backfillTimer->setInterval(BackfillIntervalMs);
+    connect(m_backfillTimer, &QTimer::timeout, this, &UniverseAnalytics::startBackfills);
+    qDebug() << "🧮 Numeric kernels:" << Kernels::isaName(Kernels::isa());
+}
+
+bool UniverseAnalytics::run(const QVector<quint32> &symbolIds)
+{
+    if (m_watcher.isRunning())
+        return false;
+    if (m_sinceLastRun.isValid() && m_sinceLastRun.elapsed() < m_minimumIntervalMs)
+        return false;
+
+    // TickStore is GUI-thread only, so each series is copied out before the pool sees it
+    QVector<Input> inputs;
+    inputs.reserve(symbolIds.size());
+    for (quint32 id : symbolIds) {
+        BarStore::instance().load(id);
+        const TickStore::Series daily = TickStore::instance().series(TickStore::Resolution::Daily, id);
+        if (daily.size() < MinimumBars) {
+            queueBackfill(id);
+            continue;
+        }
+        inputs.append(Input{id, QVector<double>(daily.price.begin(), daily.price.end()),
+                            QVector<qint64>(daily.timestampNs, daily.timestampNs + daily.size())});
+    }
+    if (inputs.isEmpty())
+        return false;
+
+    m_sinceLastRun.start();
+    m_passTimer.start();
+    m_watcher.setFuture(QtConcurrent::mapped(inputs, &UniverseAnalytics::analyze));
+
+    // Same snapshot for the correlation matrix and the pattern index; the
+    // close vectors are shared, not copied
+    QVector<CorrelationEngine::Input> correlationInputs;
+    QVector<PatternIndex::Input> patternInputs;
+    correlationInputs.reserve(inputs.size());
+    patternInputs.reserve(inputs.size());
+    for (const Input &input : inputs) {
+        correlationInputs.append(CorrelationEngine::Input{input.symbolId, input.closes, input.timestampNs});
+        patternInputs.append(PatternIndex::Input{input.symbolId, input.closes});
+    }
+    CorrelationEngine::instance()->rebuild(correlationInputs);
+    PatternIndex::instance()->rebuild(patternInputs);
+    return true;
+}
+
+void UniverseAnalytics::publish()
+{
+    const QList<SymbolAnalytics> results = m_watcher.future().results();
+
+    m_snapshot.clear();
+    m_snapshot.reserve(results.size());
+    m_rowOf.clear();
+    for (const SymbolAnalytics &row : results) {
+        m_snapshot.append(row);
+        m_rowOf[row.symbolId] = m_snapshot.size();
+        RankingService::instance().updateDaily(row.symbolId, row.last, row.change, row.changePercent, row.volatility);
+        const TickStore::Series daily = TickStore::instance().series(TickStore::Resolution::Daily, row.symbolId);
+        Screener::instance().updateDaily(row, daily.isEmpty() ? 0.0 : daily.volume.last());
+    }
+
+    qDebug() << "🧮 Universe analytics:" << m_snapshot.size() << "symbols in"
+             << m_passTimer.nsecsElapsed() / 1000 << "µs on"
+             << QThreadPool::globalInstance()->maxThreadCount() << "threads";
+    emit snapshotReady();
+}
+
+void UniverseAnalytics::queueBackfill(quint32 symbolId)
+{
+    bool &pending = m_backfillPending[symbolId];
+    if (pending || m_backfillTries[symbolId] >= BackfillAttempts)
+        return;
+    pending = true;
+    m_backfillQueue.enqueue(symbolId);
+    if (!m_backfillTimer->isActive()) {
+        startBackfills();
+        m_backfillTimer->start();
+    }
+}
+
+void UniverseAnalytics::startBackfills()
+{
+    // One request per tick, and never more than BackfillInFlight at once; the
+    // DataPlane's per-host limit still applies on top
+    if (m_backfillQueue.isEmpty()) {
+        m_backfillTimer->stop();
+        return;
+    }
+    if (m_backfillInFlight >= BackfillInFlight)
+        return;
+
+    const quint32 symbolId = m_backfillQueue.dequeue();
+    ++m_backfillTries[symbolId];
+    ++m_backfillInFlight;
+
+    // A year of daily bars, as the chart's longest timeframe draws from them
+    QNetworkRequest request(QString("https://query1.finance.yahoo.com/v8/finance/chart/%1?interval=1d&range=1y")
+                                .arg(SymbolRegistry::instance().yahooSymbol(symbolId)));
+    request.setHeader(QNetworkRequest::UserAgentHeader,
+                      "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
+
+    DataPlane::instance()->fetch(request, this,
+        [](const QByteArray &data) {
+            const QJsonDocument doc = QJsonDocument::fromJson(data);
+            return doc.isNull() ? BarSeries() : BarStore::parseYahooChart(doc.object());
+        },
+        [this, symbolId](const BarSeries &bars) {
+            finishBackfill(symbolId, bars.isEmpty() ? 0 : BarStore::instance().merge(symbolId, bars));
+        },
+        [this, symbolId](const QString &error) {
+            qWarning() << "⚠️ Backfill failed for" << SymbolRegistry::instance().name(symbolId) << ":" << error;
+            finishBackfill(symbolId, 0);
+        });
+}
+
+void UniverseAnalytics::finishBackfill(quint32 symbolId, int changed)
+{
+    --m_backfillInFlight;
+    m_backfillPending[symbolId] = false;   // a later pass may queue it again if it is still short
+    if (changed > 0)
+        ++m_backfilled;
+
+    if (m_backfillQueue.isEmpty() && m_backfillInFlight == 0 && m_backfilled > 0) {
+        qDebug() << "📥 Backfilled daily history for" << m_backfilled << "symbols";
+        m_backfilled = 0;
+        m_sinceLastRun.invalidate();   // let the next run() include them right away
+    }
+}
+
+const UniverseAnalytics::SymbolAnalytics *UniverseAnalytics::find(quint32 symbolId) const
+{
+    const int *row = m_rowOf.find(symbolId);
+    return (row && *row > 0) ? &m_snapshot[*row - 1] : nullptr;
+}
+
+UniverseAnalytics::SymbolAnalytics UniverseAnalytics::analyze(const Input &input)
+{
+    const PriceSpan prices{input.closes.constData(), static_cast<int>(input.closes.size())};
+    const IndicatorEngine engine = IndicatorEngine::compute(prices);
+
+    SymbolAnalytics row;
+    row.symbolId = input.symbolId;
+    row.bars = prices.size();
+    row.last = prices.last();
+    row.change = prices.last() - prices[prices.size() - 2];
+    row.changePercent = prices[prices.size() - 2] > 0 ? row.change / prices[prices.size() - 2] * 100 : 0.0;
+    row.sma = engine.sma();
+    row.ema = engine.ema();
+    row.rsi = engine.rsi();
+    row.bollingerUpper = engine.bollingerUpper();
+    row.bollingerLower = engine.bollingerLower();
+    row.volatility = volatility(prices);
+    row.trend = regression(prices);
+    return row;
+}
+
+double UniverseAnalytics::volatility(const PriceSpan &prices, int period)
+{
+    // Population standard deviation of the last `period` simple returns
+    if (period <= 0 || prices.size() < period + 1)
+        return 0.0;
+
+    const PriceSpan window = prices.tail(period + 1);
+    return std::sqrt(Kernels::returnMoments(window.begin(), window.size()).variance);
+}
+
+UniverseAnalytics::Regression UniverseAnalytics::regression(const PriceSpan &prices, int window)
+{
+    // Least squares of price on x = 0..n-1 over the last `window` closes.
+    // The x sums are closed-form; the y sums come from one vector pass.
+    Regression fit;
+    const int n = qMin(window, prices.size());
+    if (n < 2)
+        return fit;
+
+    const PriceSpan tail = prices.tail(n);
+    const Kernels::LinearSums sums = Kernels::linearSums(tail.begin(), n);
+    const double sumX = n * (n - 1) / 2.0;
+    const double sumXX = (n - 1.0) * n * (2.0 * n - 1.0) / 6.0;
+
+    fit.slope = (n * sums.sumXY - sumX * sums.sumY) / (n * sumXX - sumX * sumX);
+    fit.intercept = (sums.sumY - fit.slope * sumX) / n;
+
+    // SSres and SStot expanded in terms of the same sums
+    const double ssTotal = sums.sumYY - sums.sumY * sums.sumY / n;
+    const double ssRes = ssTotal - fit.slope * (sums.sumXY - sumX * sums.sumY / n);
+    fit.rSquared = ssTotal > 0 ? qBound(0.0, 1.0 - ssRes / ssTotal, 1.0) : 0.0;
+    return fit;
+}
@@ -7,6 +7,7 @@ int main(int argc, char *argv[])
 {
     try {
         QApplication app(argc, argv);
+        app.setApplicationName("StockSense");   // names the on-disk data directory
         
         qDebug() << "=== StockSense Application Starting ===";
         
@@ -0,0 +1,87 @@
+#ifndef PATTERNBRUTEFORCE_H
+#define PATTERNBRUTEFORCE_H
+
+#include "PatternIndex.h"
+#include <algorithm>
+#include <cmath>
+
+// The reference PatternIndex::search() has to agree with: banded DTW of
+// the z-normalised query against every window, no pruning, sorted by
+// distance (ties by symbol, then offset) and kept greedily unless a window
+// overlaps one already kept. Shared by test_pattern_index and
+// bench_pattern_index.
+namespace PatternBruteForce
+{
+    // False for a flat window, which has no shape to compare
+    inline bool zNormalise(const double *closes, int m, double *out)
+    {
+        double mean = 0.0, meanSq = 0.0;
+        for (int t = 0; t < m; ++t) {
+            mean += closes[t];
+            meanSq += closes[t] * closes[t];
+        }
+        mean /= m;
+        const double variance = meanSq / m - mean * mean;
+        if (variance <= 1e-12 * mean * mean)
+            return false;
+        const double sd = std::sqrt(variance);
+        for (int t = 0; t < m; ++t)
+            out[t] = (closes[t] - mean) / sd;
+        return true;
+    }
+
+    // Full (m + 1) x (m + 1) table inside a Sakoe-Chiba band
+    inline double bandedDtw(const double *a, const double *b, int m, int band, QVector<double> &cost)
+    {
+        cost.fill(INFINITY, (m + 1) * (m + 1));
+        cost[0] = 0.0;
+        for (int i = 1; i <= m; ++i) {
+            for (int j = qMax(1, i - band); j <= qMin(m, i + band); ++j) {
+                const double d = (a[i - 1] - b[j - 1]) * (a[i - 1] - b[j - 1]);
+                cost[i * (m + 1) + j] = d + std::min({cost[(i - 1) * (m + 1) + j], cost[i * (m + 1) + j - 1],
+                                                      cost[(i - 1) * (m + 1) + j - 1]});
+            }
+        }
+        return std::sqrt(cost[m * (m + 1) + m]);
+    }
+
+    inline QVector<PatternIndex::Match> search(const QVector<PatternIndex::Input> &inputs, const PriceSpan &query, int k,
+                                               quint32 querySymbolId, const PatternIndex::Config &config)
+    {
+        using Match = PatternIndex::Match;
+        const int m = config.length;
+        QVector<double> q(m), c(m), cost;
+        QVector<Match> picks;
+        if (!zNormalise(query.tail(m).begin(), m, q.data()))
+            return picks;
+
+        QVector<Match> all;
+        for (const PatternIndex::Input &input : inputs) {
+            const int n = input.closes.size();
+            for (int off = 0; off + m <= n; ++off) {
+                if (input.symbolId == querySymbolId && off + m > n - m)
+                    continue;
+                if (zNormalise(input.closes.constData() + off, m, c.data()))
+                    all.append(Match{input.symbolId, off, n - off - m, bandedDtw(q.constData(), c.constData(), m, config.band, cost)});
+            }
+        }
+        std::sort(all.begin(), all.end(), [](const Match &a, const Match &b) {
+            if (a.distance != b.distance)
+                return a.distance < b.distance;
+            return a.symbolId != b.symbolId ? a.symbolId < b.symbolId : a.offset < b.offset;
+        });
+
+        for (const Match &match : all) {
+            if (picks.size() == k)
+                break;
+            const bool clash = std::any_of(picks.begin(), picks.end(), [&](const Match &pick) {
+                return pick.symbolId == match.symbolId && std::abs(pick.offset - match.offset) < m;
+            });
+            if (!clash)
+                picks.append(match);
+        }
+        return picks;
+    }
+}
+
+#endif // PATTERNBRUTEFORCE_H
@@ -0,0 +1,72 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QVector>
+#include <random>
+
+// The tests are plain executables run by ctest. A failed CHECK prints the
+// expression and where it failed; finish() turns the failure count into
+// the exit code.
+namespace TestSupport
+{
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool check(bool ok, const char *expression, const char *file, int line)
+    {
+        if (!ok) {
+            qWarning() << "❌" << file << ":" << line << "CHECK failed:" << expression;
+            ++failures();
+        }
+        return ok;
+    }
+
+    inline int finish(const char *name)
+    {
+        if (failures() == 0) {
+            qDebug() << "✅" << name << "passed";
+            return 0;
+        }
+        qWarning() << "❌" << name << ":" << failures() << "failed checks";
+        return 1;
+    }
+
+    // Fastest of `runs` timed calls, in nanoseconds; used by the benchmarks
+    template <typename Fn>
+    qint64 bestOf(int runs, Fn &&fn)
+    {
+        qint64 best = -1;
+        for (int run = 0; run < runs; ++run) {
+            QElapsedTimer timer;
+            timer.start();
+            fn();
+            const qint64 elapsed = timer.nsecsElapsed();
+            if (best < 0 || elapsed < best) best = elapsed;
+        }
+        return best;
+    }
+
+    // Geometric random walk around start; every run is reproducible from its seed
+    inline QVector<double> randomWalk(quint32 seed, int length, double start = 1500.0, double volatility = 0.01)
+    {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0.0, volatility);
+        QVector<double> prices;
+        prices.reserve(length);
+        double price = start;
+        for (int i = 0; i < length; ++i) {
+            price *= 1.0 + step(rng);
+            prices.append(price);
+        }
+        return prices;
+    }
+}
+
+#define CHECK(expression) TestSupport::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#endif // TESTSUPPORT_H
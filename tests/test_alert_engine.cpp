@@ -0,0 +1,164 @@
+#include "AlertEngine.h"
+#include "TestSupport.h"
+#include <map>
+
+// AlertEngine against a scan of every alert on each quote: random quote
+// streams on a few symbols with alerts added and removed as they run, on
+// prices and levels rounded to the tick so quotes land exactly on levels.
+// The alerts fired per quote must match. Then takeFired() order: highest
+// priority first, oldest first within a priority.
+
+namespace {
+
+using Kind = AlertEngine::Kind;
+
+// What each alert is waiting for, tracked the slow way
+struct Oracle {
+    quint32 id;
+    quint32 symbolId;
+    Kind kind;
+    double level;
+    double reference = 0.0;   // PercentMove
+    bool active = true;
+    bool placed = false;      // the symbol had a price when it was added, or has had one since
+    bool armed = false;       // cross alerts: on the near side of the level
+};
+
+void place(Oracle &alert, double price)
+{
+    alert.placed = true;
+    alert.reference = price;
+    alert.armed = alert.kind == Kind::CrossAbove ? price < alert.level : price > alert.level;
+}
+
+// Whether the alert fires on this price; updates its state either way
+bool fires(Oracle &alert, double price)
+{
+    switch (alert.kind) {
+    case Kind::Above:
+        return price >= alert.level;
+    case Kind::Below:
+        return price <= alert.level;
+    case Kind::CrossAbove:
+        if (alert.armed && price >= alert.level) {
+            alert.armed = false;
+            return true;
+        }
+        alert.armed = alert.armed || price < alert.level;
+        return false;
+    case Kind::CrossBelow:
+        if (alert.armed && price <= alert.level) {
+            alert.armed = false;
+            return true;
+        }
+        alert.armed = alert.armed || price > alert.level;
+        return false;
+    case Kind::PercentMove:
+        return price >= alert.reference * (1.0 + alert.level / 100.0)
+               || price <= alert.reference * (1.0 - alert.level / 100.0);
+    }
+    return false;
+}
+
+double tick(double price)
+{
+    return std::round(price * 4.0) / 4.0;
+}
+
+} // namespace
+
+int main()
+{
+    constexpr int Symbols = 5;
+    AlertEngine &engine = AlertEngine::instance();
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    QVector<Oracle> alerts;
+    QVector<double> price(Symbols, 100.0);
+    QVector<bool> quoted(Symbols, false);
+    int mismatches = 0;
+    qint64 totalFired = 0;
+
+    for (int step = 0; step < 100000; ++step) {
+        if (uniform(rng) < 0.05) {
+            Oracle alert{0, static_cast<quint32>(rng() % Symbols) + 1, static_cast<Kind>(rng() % 5), 0.0};
+            alert.level = alert.kind == Kind::PercentMove ? 0.5 + uniform(rng) * 3.0 : tick(90.0 + uniform(rng) * 20.0);
+            alert.id = engine.add(alert.symbolId, alert.kind, alert.level);
+            if (quoted[alert.symbolId - 1])
+                place(alert, price[alert.symbolId - 1]);
+            alerts.append(alert);
+        }
+        if (uniform(rng) < 0.01 && !alerts.isEmpty()) {
+            Oracle &alert = alerts[static_cast<int>(rng() % alerts.size())];
+            CHECK(engine.remove(alert.id) == alert.active);
+            alert.active = false;
+        }
+
+        const int s = static_cast<int>(rng() % Symbols);
+        price[s] = qBound(50.0, tick(price[s] * (1.0 + (uniform(rng) - 0.5) * 0.02)), 150.0);
+        quoted[s] = true;
+        Quote quote;
+        quote.symbolId = static_cast<quint32>(s) + 1;
+        quote.price = price[s];
+        quote.timestampNs = step;
+
+        std::map<quint32, int> expected;
+        for (Oracle &alert : alerts) {
+            if (alert.symbolId != quote.symbolId || !alert.active)
+                continue;
+            if (!alert.placed) {
+                // First quote for the symbol: levels are set from it, only plain thresholds can fire on it
+                place(alert, quote.price);
+                if (alert.kind != Kind::Above && alert.kind != Kind::Below)
+                    continue;
+            }
+            if (fires(alert, quote.price)) {
+                ++expected[alert.id];
+                if (alert.kind != Kind::CrossAbove && alert.kind != Kind::CrossBelow)
+                    alert.active = false;
+            }
+        }
+
+        const int fired = engine.evaluate(quote);
+        std::map<quint32, int> got;
+        while (engine.hasFired()) {
+            const AlertEngine::Fired hit = engine.takeFired();
+            ++got[hit.alertId];
+            CHECK(hit.symbolId == quote.symbolId && hit.price == quote.price && hit.timestampNs == step);
+        }
+        if (got != expected || fired != static_cast<int>(expected.size())) {
+            if (++mismatches <= 5)
+                qWarning() << "   step" << step << "price" << quote.price << "fired" << fired << "expected" << expected.size();
+        }
+        totalFired += fired;
+    }
+    CHECK(mismatches == 0);
+    CHECK(totalFired > 1000);   // the stream exercised firing, not just quiet ticks
+
+    int active = 0;
+    for (const Oracle &alert : alerts)
+        active += alert.active ? 1 : 0;
+    CHECK(engine.activeCount() == active);
+
+    // takeFired(): priority first, then firing order
+    const quint32 symbol = 100;
+    Quote quote;
+    quote.symbolId = symbol;
+    quote.price = 100.0;
+    engine.evaluate(quote);
+    const quint32 lowFirst = engine.add(symbol, Kind::Above, 101.0, AlertEngine::Priority::Low);
+    const quint32 high = engine.add(symbol, Kind::Above, 102.0, AlertEngine::Priority::High);
+    const quint32 normal = engine.add(symbol, Kind::Above, 103.0, AlertEngine::Priority::Normal);
+    const quint32 lowLast = engine.add(symbol, Kind::Above, 104.0, AlertEngine::Priority::Low);
+    for (double level : {101.0, 102.0, 103.0, 104.0}) {
+        quote.price = level;
+        CHECK(engine.evaluate(quote) == 1);
+    }
+    QVector<quint32> order;
+    while (engine.hasFired())
+        order.append(engine.takeFired().alertId);
+    CHECK(order == QVector<quint32>({high, normal, lowFirst, lowLast}));
+
+    return TestSupport::finish("test_alert_engine");
+}
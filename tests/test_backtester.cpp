@@ -0,0 +1,109 @@
+#include "Backtester.h"
+#include "TestSupport.h"
+#include <cmath>
+
+// Backtester::run() on a hand-worked series with a scripted strategy, with
+// and without a warm-up, and sweep() against one run() per grid point.
+
+namespace {
+
+// Holds script[i] into the bar after bar i, whatever the indicators say
+class ScriptedStrategy : public Strategy
+{
+public:
+    explicit ScriptedStrategy(const QVector<int> &script) : m_script(script) {}
+    int onBar(const IndicatorEngine &engine, double) override { return m_script[static_cast<int>(engine.count()) - 1]; }
+
+private:
+    QVector<int> m_script;
+};
+
+bool near(double a, double b)
+{
+    return std::abs(a - b) < 1e-12;
+}
+
+bool sameResult(const Backtester::Result &a, const Backtester::Result &b)
+{
+    return a.totalReturn == b.totalReturn && a.maxDrawdown == b.maxDrawdown && a.trades == b.trades
+           && a.winners == b.winners && a.exposure == b.exposure && a.bars == b.bars;
+}
+
+} // namespace
+
+int main()
+{
+    // +10%, -10%, flat, +10%, -20%, then anything: long for two bars, flat,
+    // short for two bars, flat. 1% per position change.
+    const QVector<double> closes{100.0, 110.0, 99.0, 99.0, 108.9, 87.12, 90.0};
+    const PriceSpan span{closes.constData(), static_cast<int>(closes.size())};
+    ScriptedStrategy strategy({1, 1, 0, -1, -1, 0, 0});
+    Backtester::Costs costs;
+    costs.perTrade = 0.01;
+
+    // Equity: 0.99 entry, x1.1, x0.9, 0.99 exit (a loser), 0.99 entry,
+    // x0.9 short, x1.2 short, 0.99 exit (a winner against 0.970299).
+    // Trough is after the first short bar: 0.9 * 0.99^2 * 0.9 of the 1.089 peak.
+    QVector<int> signals;
+    Backtester::Result result = Backtester::run(span, strategy, IndicatorEngine::Config(), costs, 0, &signals);
+    CHECK(near(result.totalReturn, 0.99 * 1.1 * 0.9 * 0.99 * 0.99 * 0.9 * 1.2 * 0.99 - 1.0));
+    CHECK(near(result.maxDrawdown, 1.0 - 0.9 * 0.99 * 0.99 * 0.9));
+    CHECK(result.trades == 2);
+    CHECK(result.winners == 1);
+    CHECK(result.bars == 7);
+    CHECK(near(result.exposure, 4.0 / 6.0));
+    CHECK(signals == QVector<int>({1, 0, -1, -1, 0, 1, 0}));
+
+    // Scored from bar 3: the long never happens, the short is the only trade
+    result = Backtester::run(span, strategy, IndicatorEngine::Config(), costs, 3, &signals);
+    CHECK(near(result.totalReturn, 0.99 * 0.9 * 1.2 * 0.99 - 1.0));
+    CHECK(near(result.maxDrawdown, 1.0 - 0.99 * 0.9));
+    CHECK(result.trades == 1);
+    CHECK(result.winners == 1);
+    CHECK(result.bars == 4);
+    CHECK(near(result.exposure, 2.0 / 3.0));
+    CHECK(signals == QVector<int>({0, 0, 0, -1, 0, 1, 0}));
+
+    // No costs, always long: buy and hold, never a closed trade
+    ScriptedStrategy hold({1, 1, 1, 1, 1, 1, 1});
+    result = Backtester::run(span, hold, IndicatorEngine::Config(), Backtester::Costs{0.0});
+    CHECK(near(result.totalReturn, 90.0 / 100.0 - 1.0));
+    CHECK(result.trades == 0);
+    CHECK(near(result.exposure, 1.0));
+
+    // sweep(): symbol-major, grid order, each slot equal to its own run()
+    QVector<Backtester::History> histories;
+    for (quint32 id = 1; id <= 3; ++id)
+        histories.append(Backtester::History{id, TestSupport::randomWalk(18 + id, 400, 1000.0, 0.02)});
+    const Backtester::Grid grid = Backtester::defaultGrid();
+    const QVector<Backtester::SweepResult> swept = Backtester::sweep(histories, grid, Backtester::Costs());
+    CHECK(swept.size() == histories.size() * grid.size());
+
+    int slot = 0;
+    for (const Backtester::History &history : histories) {
+        for (int sma : grid.smaWindows)
+            for (int rsi : grid.rsiWindows)
+                for (double oversold : grid.oversold)
+                    for (double overbought : grid.overbought) {
+                        if (slot >= swept.size())
+                            break;
+                        const Backtester::SweepResult &got = swept[slot++];
+                        SmaRsiStrategy::Params params;
+                        params.smaWindow = sma;
+                        params.rsiWindow = rsi;
+                        params.oversold = oversold;
+                        params.overbought = overbought;
+                        SmaRsiStrategy single(params);
+                        const Backtester::Result expected =
+                            Backtester::run(PriceSpan{history.closes.constData(), static_cast<int>(history.closes.size())},
+                                            single, single.indicatorConfig(), Backtester::Costs());
+                        const bool same = got.symbolId == history.symbolId && got.params.smaWindow == sma
+                                          && got.params.rsiWindow == rsi && got.params.oversold == oversold
+                                          && got.params.overbought == overbought && sameResult(got.result, expected);
+                        if (!CHECK(same))
+                            qWarning() << "   symbol" << history.symbolId << "sma" << sma << "rsi" << rsi;
+                    }
+    }
+
+    return TestSupport::finish("test_backtester");
+}
@@ -0,0 +1,81 @@
+#include "CorrelationEngine.h"
+#include "TestSupport.h"
+#include <cmath>
+
+// CorrelationEngine::compute() aligns series on trading day: a symbol with
+// a missing bar still lines up with the others, and a symbol whose newest
+// bar is not in the current session is left out of the matrix.
+
+namespace {
+
+constexpr qint64 DayNs = 86400LL * 1000000000LL;
+constexpr qint64 FirstDay = 20000;   // 2024-10-04
+constexpr qint64 CloseNs = 10 * 3600LL * 1000000000LL;   // 15:30 IST
+
+CorrelationEngine::Input series(quint32 id, const QVector<double> &closes, const QVector<qint64> &days)
+{
+    CorrelationEngine::Input input;
+    input.symbolId = id;
+    for (int i = 0; i < days.size(); ++i) {
+        input.closes.append(closes[days[i] - FirstDay]);
+        input.timestampNs.append(days[i] * DayNs + CloseNs);
+    }
+    return input;
+}
+
+double correlation(const CorrelationEngine::Matrix &m, int a, int b)
+{
+    const int n = m.size();
+    const double w = m.window;
+    const double varA = w * m.cross[a * n + a] - m.sums[a] * m.sums[a];
+    const double varB = w * m.cross[b * n + b] - m.sums[b] * m.sums[b];
+    return (w * m.cross[a * n + b] - m.sums[a] * m.sums[b]) / std::sqrt(varA * varB);
+}
+
+int rowOf(const CorrelationEngine::Matrix &m, quint32 id)
+{
+    return m.symbolIds.indexOf(id);
+}
+
+} // namespace
+
+int main()
+{
+    constexpr int Days = 120;
+    const QVector<double> walk = TestSupport::randomWalk(19, Days);
+    const QVector<double> other = TestSupport::randomWalk(20, Days);
+
+    QVector<qint64> all;
+    for (int d = 0; d < Days; ++d)
+        all.append(FirstDay + d);
+    QVector<qint64> gapped = all;
+    gapped.remove(Days / 2);   // one halted day
+    const QVector<qint64> stale = all.mid(0, Days - 1);   // stopped a session early
+
+    const QVector<CorrelationEngine::Input> inputs{
+        series(1, walk, all),
+        series(2, walk, gapped),
+        series(3, other, all),
+        series(4, walk, stale),
+    };
+    const CorrelationEngine::Matrix m = CorrelationEngine::compute(inputs);
+
+    CHECK(m.window == Days - 1);
+    CHECK(rowOf(m, 4) < 0);
+    const int a = rowOf(m, 1), b = rowOf(m, 2), c = rowOf(m, 3);
+    CHECK(a >= 0 && b >= 0 && c >= 0);
+    if (a >= 0 && b >= 0 && c >= 0) {
+        // The gap costs one day's return, not a shift of half the series
+        CHECK(correlation(m, a, b) > 0.95);
+        CHECK(std::abs(correlation(m, a, c)) < 0.5);
+        CHECK(m.base[a] == walk[Days - 2] && m.base[b] == walk[Days - 2]);
+        CHECK(std::abs(m.last[a] - std::log(walk[Days - 1] / walk[Days - 2])) < 1e-15);
+    }
+
+    // Without timestamps a series cannot be placed on the calendar
+    CorrelationEngine::Input bare = series(5, walk, all);
+    bare.timestampNs.clear();
+    CHECK(rowOf(CorrelationEngine::compute({inputs[0], inputs[2], bare}), 5) < 0);
+
+    return TestSupport::finish("test_correlation_engine");
+}
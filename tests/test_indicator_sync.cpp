@@ -0,0 +1,262 @@
+#include "IndicatorSync.h"
+#include "TestSupport.h"
+#include <cmath>
+
+// RollingExtrema::assign(), a PivotDetector replay from replayStart() and
+// IndicatorSync::load() each against a push() replay of the same closes,
+// then fed the same push()/replaceLast() sequence; and sync() following a
+// TickStore series through appends, rewrites, eviction and reloads.
+// Prices sit on a coarse grid, so ties (flat extremes, flat pivots) occur.
+
+namespace
+{
+    bool near(double a, double b)
+    {
+        return std::fabs(a - b) <= 1e-9 * qMax(1.0, std::fabs(b));
+    }
+
+    // Indicators, range and pivots bit for bit; the trend line to rounding,
+    // since its sums re-anchor at different points when fewer values were pushed
+    bool same(const IndicatorSync &a, const IndicatorSync &b)
+    {
+        const IndicatorEngine &x = a.engine();
+        const IndicatorEngine &y = b.engine();
+        if (x.count() != y.count() || x.last() != y.last() || x.sma() != y.sma() || x.ema() != y.ema() ||
+            x.rsi() != y.rsi() || x.bollingerMean() != y.bollingerMean() || x.stdDev() != y.stdDev())
+            return false;
+
+        if (a.range().count() != b.range().count())
+            return false;
+        if (!a.range().isEmpty() && (a.range().min() != b.range().min() || a.range().max() != b.range().max()))
+            return false;
+
+        if (a.pivots().support() != b.pivots().support() || a.pivots().resistance() != b.pivots().resistance())
+            return false;
+
+        const StreamingRegression::Fit p = a.trend().fit();
+        const StreamingRegression::Fit q = b.trend().fit();
+        return a.trend().size() == b.trend().size() && p.n == q.n && near(p.slope, q.slope) &&
+               near(p.intercept, q.intercept) && near(p.residualStdDev, q.residualStdDev) &&
+               near(a.trend().predict(3), b.trend().predict(3));
+    }
+
+    QVector<double> gridWalk(quint32 seed, int length)
+    {
+        QVector<double> prices = TestSupport::randomWalk(seed, length, 100.0, 0.01);
+        for (double &price : prices)
+            price = std::round(price * 2.0) / 2.0;
+        return prices;
+    }
+
+    // Rewrites more and less extreme than the value they replace, and new values
+    template <typename Fn>
+    void afterwards(quint32 seed, double last, Fn &&apply)
+    {
+        std::mt19937 rng(seed * 7919u + 3u);
+        for (int step = 0; step < 60; ++step) {
+            const double price = last + 0.5 * (static_cast<int>(rng() % 9) - 4);
+            const bool rewrite = rng() % 2 == 0;
+            if (!rewrite)
+                last = price;
+            if (!apply(rewrite, price))
+                return;
+        }
+    }
+
+    void checkRange(int window, quint32 seed, int length)
+    {
+        const QVector<double> prices = gridWalk(seed, length);
+        RollingExtrema assigned(window);
+        assigned.assign(prices.constData(), prices.size());
+        RollingExtrema replayed(window);
+        for (double price : prices)
+            replayed.push(price);
+
+        auto same = [&]() {
+            return assigned.count() == replayed.count() && assigned.isEmpty() == replayed.isEmpty() &&
+                   (assigned.isEmpty() || (assigned.min() == replayed.min() && assigned.max() == replayed.max()));
+        };
+        if (!CHECK(same())) {
+            qWarning() << "   seed" << seed << "length" << length << "window" << window;
+            return;
+        }
+        afterwards(seed, prices.isEmpty() ? 100.0 : prices.last(), [&](bool rewrite, double price) {
+            if (rewrite) {
+                assigned.replaceLast(price);
+                replayed.replaceLast(price);
+            } else {
+                assigned.push(price);
+                replayed.push(price);
+            }
+            if (CHECK(same()))
+                return true;
+            qWarning() << "   seed" << seed << "length" << length << "window" << window << "after assign";
+            return false;
+        });
+    }
+
+    void checkPivots(int strength, int keep, quint32 seed, int length)
+    {
+        const QVector<double> prices = gridWalk(seed, length);
+        PivotDetector resumed(strength, keep);
+        for (int i = resumed.replayStart(prices.constData(), prices.size()); i < prices.size(); ++i)
+            resumed.push(prices[i]);
+        PivotDetector replayed(strength, keep);
+        for (double price : prices)
+            replayed.push(price);
+
+        auto same = [&]() {
+            return resumed.support() == replayed.support() && resumed.resistance() == replayed.resistance();
+        };
+        if (!CHECK(same())) {
+            qWarning() << "   seed" << seed << "length" << length << "strength" << strength;
+            return;
+        }
+        afterwards(seed, prices.isEmpty() ? 100.0 : prices.last(), [&](bool rewrite, double price) {
+            if (rewrite) {
+                resumed.replaceLast(price);
+                replayed.replaceLast(price);
+            } else {
+                resumed.push(price);
+                replayed.push(price);
+            }
+            if (CHECK(same()))
+                return true;
+            qWarning() << "   seed" << seed << "length" << length << "strength" << strength << "after replay";
+            return false;
+        });
+    }
+
+    void checkLoad(const IndicatorSync::Config &config, quint32 seed, int length)
+    {
+        const QVector<double> prices = gridWalk(seed, length);
+
+        IndicatorSync loaded(config);
+        loaded.load(PriceSpan{prices.constData(), prices.size()});
+        IndicatorSync replayed(config);
+        for (double price : prices)
+            replayed.push(price);
+        if (!CHECK(same(loaded, replayed))) {
+            qWarning() << "   seed" << seed << "length" << length << "range window" << config.rangeWindow;
+            return;
+        }
+
+        afterwards(seed, prices.isEmpty() ? 100.0 : prices.last(), [&](bool rewrite, double price) {
+            if (rewrite) {
+                loaded.replaceLast(price);
+                replayed.replaceLast(price);
+            } else {
+                loaded.push(price);
+                replayed.push(price);
+            }
+            if (CHECK(same(loaded, replayed)))
+                return true;
+            qWarning() << "   seed" << seed << "length" << length << "after load";
+            return false;
+        });
+    }
+
+    void checkSync(quint32 seed)
+    {
+        const int capacity = 100;   // the columns grow 64 -> 100, then gain their mirror at the first wrap
+        const quint32 symbolId = seed;
+        TickStore &store = TickStore::instance();
+        store.setCapacity(TickStore::Resolution::Tick, capacity);
+
+        IndicatorSync::Config config;
+        config.rangeWindow = capacity;
+        IndicatorSync sync(config);
+
+        // Every value of the current generation, so a reference can replay them all
+        QVector<double> history;
+        std::mt19937 rng(seed);
+        double price = 100.0;
+        qint64 timestampNs = 0;
+        for (int step = 0; step < 600; ++step) {
+            const int op = static_cast<int>(rng() % 10);
+            if (op == 0 && step % 150 == 149) {
+                // Reload: a new generation with different closes
+                BarSeries bars;
+                history = gridWalk(seed * 31u + static_cast<quint32>(step), 40);
+                for (double close : history)
+                    bars.append(++timestampNs, close, 0.0, close, close);
+                store.assign(TickStore::Resolution::Tick, symbolId, bars);
+                price = history.last();
+            } else if (op < 3 && !history.isEmpty()) {
+                price += 0.5 * (static_cast<int>(rng() % 5) - 2);
+                store.replaceLast(TickStore::Resolution::Tick, symbolId, timestampNs, price, 0.0, price, price);
+                history.last() = price;
+            } else {
+                for (int k = 1 + static_cast<int>(rng() % 3); k > 0; --k) {
+                    price += 0.5 * (static_cast<int>(rng() % 5) - 2);
+                    store.append(TickStore::Resolution::Tick, symbolId, ++timestampNs, price, 0.0, price, price);
+                    history.append(price);
+                }
+            }
+
+            const TickStore::Series series = store.series(TickStore::Resolution::Tick, symbolId);
+            sync.sync(series);
+
+            IndicatorSync reference(config);
+            for (double value : history)
+                reference.push(value);
+            if (!CHECK(same(sync, reference))) {
+                qWarning() << "   seed" << seed << "step" << step << "held" << series.size();
+                return;
+            }
+
+            // The range covers exactly what the ring still holds
+            double low = series.price[0], high = series.price[0];
+            for (int i = 1; i < series.size(); ++i) {
+                low = qMin(low, series.price[i]);
+                high = qMax(high, series.price[i]);
+            }
+            if (!CHECK(sync.range().min() == low && sync.range().max() == high)) {
+                qWarning() << "   seed" << seed << "step" << step << "range";
+                return;
+            }
+        }
+    }
+}
+
+int main()
+{
+    for (quint32 seed = 1; seed <= 8; ++seed) {
+        for (int length : {0, 1, 2, 3, 7, 8, 9, 64, 300}) {
+            for (int window : {1, 2, 8, 64})
+                checkRange(window, seed, length);
+        }
+        // Every length, so some end on a push that confirmed a pivot and dropped an old level
+        for (int length = 0; length <= 120; ++length) {
+            checkPivots(1, 3, seed, length);
+            checkPivots(2, 1, seed, length);
+        }
+    }
+
+    QVector<IndicatorSync::Config> configs;
+    configs.append(IndicatorSync::Config());
+    IndicatorSync::Config wide;
+    wide.rangeWindow = 64;
+    wide.trendWindow = 7;
+    wide.pivotStrength = 2;
+    wide.pivotLevels = 2;
+    configs.append(wide);
+    IndicatorSync::Config narrow;
+    narrow.rangeWindow = 1;
+    narrow.trendWindow = 3;
+    narrow.indicators.smaWindow = narrow.indicators.bollingerWindow = 5;
+    configs.append(narrow);
+
+    for (const IndicatorSync::Config &config : configs) {
+        for (quint32 seed = 1; seed <= 8; ++seed) {
+            for (int length : {0, 1, 2, 5, 19, 20, 21, 63, 64, 65, 300}) {
+                checkLoad(config, seed, length);
+            }
+        }
+    }
+
+    for (quint32 seed = 1; seed <= 6; ++seed)
+        checkSync(seed);
+
+    return TestSupport::finish("test_indicator_sync");
+}
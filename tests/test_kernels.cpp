@@ -0,0 +1,77 @@
+#include "Kernels.h"
+#include "TestSupport.h"
+#include <cmath>
+
+// Every vector path against the scalar reference, on lengths around the
+// SIMD widths and on a long series. Sums may differ in rounding only;
+// min/max and returns must match exactly.
+
+namespace
+{
+    bool near(double a, double b, double tolerance = 1e-9)
+    {
+        return std::fabs(a - b) <= tolerance * qMax(1.0, std::fabs(b));
+    }
+}
+
+int main()
+{
+    const int window = 20;
+    for (int n : {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 1000, 100001}) {
+        const QVector<double> prices = TestSupport::randomWalk(static_cast<quint32>(n), n, 100.0);
+        const double *p = prices.constData();
+        QVector<double> returns(n), ema(n), rolling(qMax(1, n - window + 1));
+
+        Kernels::setIsa(Kernels::Isa::Scalar);
+        const double sum = Kernels::sum(p, n);
+        const double dot = Kernels::dot(p, p, n);
+        double low, high;
+        Kernels::minMax(p, n, &low, &high);
+        const Kernels::Moments moments = Kernels::moments(p, n);
+        const Kernels::Moments returnMoments = Kernels::returnMoments(p, n);
+        const Kernels::LinearSums sums = Kernels::linearSums(p, n);
+        Kernels::returns(p, n, returns.data());
+        Kernels::emaScan(p, n, 2.0 / 13, p[0], ema.data());
+
+        for (Kernels::Isa isa : {Kernels::Isa::Sse2, Kernels::Isa::Avx2}) {
+            if (isa > Kernels::bestIsa()) continue;
+            Kernels::setIsa(isa);
+            QVector<double> vectorReturns(n), vectorEma(n);
+
+            double vectorLow, vectorHigh;
+            Kernels::minMax(p, n, &vectorLow, &vectorHigh);
+            const Kernels::Moments m = Kernels::moments(p, n);
+            const Kernels::Moments rm = Kernels::returnMoments(p, n);
+            const Kernels::LinearSums s = Kernels::linearSums(p, n);
+            Kernels::returns(p, n, vectorReturns.data());
+            Kernels::emaScan(p, n, 2.0 / 13, p[0], vectorEma.data());
+
+            CHECK(near(Kernels::sum(p, n), sum));
+            CHECK(near(Kernels::dot(p, p, n), dot));
+            CHECK(vectorLow == low && vectorHigh == high);
+            CHECK(near(m.mean, moments.mean) && near(m.variance, moments.variance, 1e-7));
+            CHECK(near(rm.mean, returnMoments.mean, 1e-7) && std::fabs(rm.variance - returnMoments.variance) < 1e-15);
+            CHECK(near(s.sumY, sums.sumY) && near(s.sumXY, sums.sumXY) && near(s.sumYY, sums.sumYY));
+            bool returnsEqual = true;
+            bool emaNear = true;
+            for (int i = 0; i < n - 1; ++i) returnsEqual = returnsEqual && vectorReturns[i] == returns[i];
+            for (int i = 0; i < n; ++i) emaNear = emaNear && near(vectorEma[i], ema[i]);
+            CHECK(returnsEqual);
+            CHECK(emaNear);
+        }
+
+        // Sliding variance against a fresh two-pass moment per window
+        if (n >= window) {
+            Kernels::rollingVariance(p, n, window, rolling.data());
+            bool rollingNear = true;
+            for (int i = 0; i + window <= n; i += 97) {
+                const Kernels::Moments direct = Kernels::moments(p + i, window);
+                // The sliding update drifts with the price level, not the window's variance
+                const double tolerance = 1e-9 * direct.variance + 1e-12 * direct.mean * direct.mean;
+                rollingNear = rollingNear && std::fabs(direct.variance - rolling[i]) <= tolerance;
+            }
+            CHECK(rollingNear);
+        }
+    }
+    return TestSupport::finish("test_kernels");
+}
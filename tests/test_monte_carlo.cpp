@@ -0,0 +1,99 @@
+#include "MonteCarloForecaster.h"
+#include "Kernels.h"
+#include "TestSupport.h"
+#include <QThreadPool>
+#include <cmath>
+
+// Philox known-answer vectors, reproducible bands for a seed whatever the
+// thread count, and GBM percentiles against their closed form.
+
+namespace
+{
+    bool sameBands(const QVector<MonteCarloForecaster::Band> &a, const QVector<MonteCarloForecaster::Band> &b)
+    {
+        if (a.size() != b.size()) return false;
+        for (int i = 0; i < a.size(); ++i) {
+            if (a[i].p5 != b[i].p5 || a[i].p25 != b[i].p25 || a[i].p50 != b[i].p50 ||
+                a[i].p75 != b[i].p75 || a[i].p95 != b[i].p95)
+                return false;
+        }
+        return true;
+    }
+
+    void checkPhilox(quint32 key0, quint32 key1, const quint32 counter[4], const quint32 expected[4])
+    {
+        const Philox4x32 rng{{key0, key1}};
+        quint32 out[4];
+        rng.generate(counter, out);
+        CHECK(out[0] == expected[0] && out[1] == expected[1] && out[2] == expected[2] && out[3] == expected[3]);
+    }
+}
+
+int main()
+{
+    // Random123 known-answer tests for philox4x32-10
+    const quint32 zero[4] = {0, 0, 0, 0};
+    const quint32 zeroOut[4] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    checkPhilox(0, 0, zero, zeroOut);
+    const quint32 ones[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const quint32 onesOut[4] = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+    checkPhilox(0xffffffff, 0xffffffff, ones, onesOut);
+    const quint32 pi[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const quint32 piOut[4] = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+    checkPhilox(0xa4093822, 0x299f31d0, pi, piOut);
+
+    const QVector<double> history = TestSupport::randomWalk(17, 120, 1000.0, 0.015);
+    const PriceSpan span{history.constData(), static_cast<int>(history.size())};
+    MonteCarloForecaster::Config config;
+    config.paths = 20000;
+
+    // Same seed, same bands, on one thread or all of them
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int threads = pool->maxThreadCount();
+    const QVector<MonteCarloForecaster::Band> bands = MonteCarloForecaster::simulate(span, config);
+    pool->setMaxThreadCount(1);
+    const QVector<MonteCarloForecaster::Band> serial = MonteCarloForecaster::simulate(span, config);
+    pool->setMaxThreadCount(threads);
+    CHECK(bands.size() == config.steps);
+    CHECK(sameBands(bands, serial));
+    CHECK(sameBands(bands, MonteCarloForecaster::simulate(span, config)));
+
+    MonteCarloForecaster::Config reseeded = config;
+    reseeded.seed ^= 1;
+    CHECK(!sameBands(bands, MonteCarloForecaster::simulate(span, reseeded)));
+
+    // GBM: the log price at step t is normal(drift t, sigma^2 t). Allow the
+    // sampling error plus a couple of histogram bins.
+    const PriceSpan window = span.tail(config.lookback + 1);
+    const Kernels::Moments moments = Kernels::returnMoments(window.begin(), window.size());
+    const double sigma = std::sqrt(moments.variance);
+    const double drift = moments.mean - moments.variance / 2.0;
+    const double z[] = {-1.6448536, -0.6744898, 0.0, 0.6744898, 1.6448536};
+    for (int step = 0; step < bands.size(); ++step) {
+        const double t = step + 1;
+        const MonteCarloForecaster::Band &band = bands[step];
+        const double got[] = {band.p5, band.p25, band.p50, band.p75, band.p95};
+        bool ordered = true;
+        bool near = true;
+        for (int i = 0; i < 5; ++i) {
+            if (i > 0) ordered = ordered && got[i - 1] <= got[i];
+            const double expected = drift * t + z[i] * sigma * std::sqrt(t);
+            near = near && std::fabs(std::log(got[i] / span.last()) - expected) <= 0.05 * sigma * std::sqrt(t);
+        }
+        if (!CHECK(ordered && near)) {
+            qWarning() << "   step" << t;
+            break;
+        }
+    }
+
+    // Bootstrap runs and is reproducible too
+    MonteCarloForecaster::Config bootstrap = config;
+    bootstrap.model = MonteCarloForecaster::Model::Bootstrap;
+    const QVector<MonteCarloForecaster::Band> resampled = MonteCarloForecaster::simulate(span, bootstrap);
+    CHECK(resampled.size() == config.steps && sameBands(resampled, MonteCarloForecaster::simulate(span, bootstrap)));
+
+    // Too little history for a single return
+    CHECK(MonteCarloForecaster::simulate(span.tail(2), config).isEmpty());
+
+    return TestSupport::finish("test_monte_carlo");
+}
@@ -0,0 +1,70 @@
+#include "PatternIndex.h"
+#include "TestSupport.h"
+#include "PatternBruteForce.h"
+#include <algorithm>
+#include <cmath>
+
+// PatternIndex::search() against PatternBruteForce on small universes;
+// ranks 1..K have to agree. The query is a wave that recurs in other
+// series, so many overlapping windows compete for the same ranks.
+
+namespace {
+
+using Match = PatternIndex::Match;
+
+const double TwoPi = 6.283185307179586;
+
+} // namespace
+
+int main()
+{
+    const PatternIndex::Config configs[] = {{30, 6, 3}, {20, 5, 0}, {24, 8, 5}};
+    std::mt19937 rng(20);
+
+    for (const PatternIndex::Config &config : configs) {
+        for (int round = 0; round < 6; ++round) {
+            const int symbols = 12;
+            const int bars = 300;
+            QVector<PatternIndex::Input> inputs;
+            for (int s = 0; s < symbols; ++s)
+                inputs.append(PatternIndex::Input{static_cast<quint32>(s), TestSupport::randomWalk(rng(), bars, 100.0 + s)});
+
+            // A wave with a period of a third of a window, at the end of
+            // symbol 0 and in stretches of symbols 1..3 with rising noise:
+            // the best windows sit a period apart and overlap each other,
+            // so which ones survive depends on the order they are taken in
+            const int period = config.length / 3;
+            std::uniform_real_distribution<double> noise(-1.0, 1.0);
+            const auto plant = [&](QVector<double> &closes, int from, int to, double amplitude) {
+                for (int t = from; t < to; ++t) {
+                    const double wave = std::sin(TwoPi * t / period);
+                    closes[t] = 100.0 * (1.0 + 0.05 * wave + amplitude * noise(rng));
+                }
+            };
+            plant(inputs[0].closes, bars - config.length, bars, 0.002);
+            for (int s = 1; s <= 3; ++s) {
+                const int from = static_cast<int>(rng() % (bars / 2));
+                plant(inputs[s].closes, from, from + bars / 3, 0.001 * s * (round + 1));
+            }
+
+            const PatternIndex::Index index = PatternIndex::build(inputs, config);
+            for (quint32 querySymbol = 0; querySymbol < 3; ++querySymbol) {
+                const PriceSpan query{inputs[querySymbol].closes.constData(), bars};
+                for (int k : {1, 2, 3, 5, 8}) {
+                    const QVector<Match> found = PatternIndex::search(index, query, k, querySymbol);
+                    const QVector<Match> expected = PatternBruteForce::search(inputs, query, k, querySymbol, config);
+                    bool same = found.size() == expected.size();
+                    for (int i = 0; same && i < found.size(); ++i) {
+                        same = found[i].symbolId == expected[i].symbolId && found[i].offset == expected[i].offset
+                               && found[i].barsAgo == expected[i].barsAgo
+                               && std::abs(found[i].distance - expected[i].distance) < 1e-9;
+                    }
+                    if (!CHECK(same))
+                        qWarning() << "   length" << config.length << "round" << round << "query" << querySymbol << "k" << k;
+                }
+            }
+        }
+    }
+
+    return TestSupport::finish("test_pattern_index");
+}
@@ -0,0 +1,52 @@
+#include "RankingService.h"
+#include "TestSupport.h"
+#include <algorithm>
+
+// RankingTree::top() against a full sort after random sets and removals;
+// ties rank the lower symbol id first.
+
+int main()
+{
+    constexpr int Symbols = 5000;
+    std::mt19937 rng(14);
+    std::uniform_real_distribution<double> uniform(-10.0, 10.0);
+
+    RankingTree tree;
+    QVector<double> keys(Symbols, 0.0);
+    QVector<bool> present(Symbols, false);
+
+    for (int step = 0; step < 100000; ++step) {
+        const int id = static_cast<int>(rng() % Symbols);
+        if (step % 97 == 0) {
+            tree.remove(static_cast<quint32>(id));
+            present[id] = false;
+        } else {
+            const double key = std::round(uniform(rng) * 100) / 100;   // rounded, so ties happen
+            tree.set(static_cast<quint32>(id), key);
+            keys[id] = key;
+            present[id] = true;
+        }
+
+        if (step % 2500 != 0) continue;
+        QVector<int> expected;
+        for (int i = 0; i < Symbols; ++i) {
+            if (present[i]) expected.append(i);
+        }
+        std::sort(expected.begin(), expected.end(), [&](int a, int b) {
+            return keys[a] > keys[b] || (keys[a] == keys[b] && a < b);
+        });
+        const QVector<quint32> top = tree.top(10);
+        bool same = top.size() == qMin(10, expected.size());
+        for (int i = 0; same && i < top.size(); ++i) same = static_cast<int>(top[i]) == expected[i];
+        if (!CHECK(same)) qWarning() << "   step" << step;
+    }
+
+    // Fewer entries than asked for
+    RankingTree small;
+    small.set(3, 1.0);
+    small.set(1, 2.0);
+    const QVector<quint32> top = small.top(5);
+    CHECK(top.size() == 2 && top[0] == 1 && top[1] == 3);
+
+    return TestSupport::finish("test_ranking");
+}
@@ -0,0 +1,48 @@
+#include "Screener.h"
+#include "TestSupport.h"
+
+// Screener plans against hand-worked rows. A row whose value is not known
+// (NaN) must never match a comparison on it, however many NOTs and
+// parentheses sit on top.
+
+namespace {
+
+QVector<quint32> run(const char *expression)
+{
+    const Screener::Plan plan = Screener::compile(QString(expression));
+    if (!CHECK(plan.isValid()))
+        qWarning() << "   " << expression << plan.error();
+    return Screener::instance().run(plan);
+}
+
+} // namespace
+
+int main()
+{
+    // Symbols 1..3 have live prices; symbol 4 has none, and no row has an RSI yet
+    Screener &screener = Screener::instance();
+    screener.track({1, 2, 3, 4});
+    for (quint32 id = 1; id <= 3; ++id) {
+        Quote quote;
+        quote.symbolId = id;
+        quote.price = 10.0 * id;
+        quote.volume = 1000;
+        screener.update(quote);
+    }
+
+    CHECK(run("price > 15") == QVector<quint32>({2, 3}));
+    CHECK(run("NOT price > 15") == QVector<quint32>({1}));
+    CHECK(run("!(price > 15)") == QVector<quint32>({1}));
+    CHECK(run("NOT NOT price > 15") == QVector<quint32>({2, 3}));
+    CHECK(run("NOT price = 20") == QVector<quint32>({1, 3}));
+    CHECK(run("NOT price != 20") == QVector<quint32>({2}));
+    CHECK(run("NOT (price < 15 OR price > 25)") == QVector<quint32>({2}));
+
+    // Unknown on one side: NOT (false AND unknown) is true, NOT (true AND unknown) is unknown
+    CHECK(run("NOT rsi < 30").isEmpty());
+    CHECK(run("NOT (price > 15 AND rsi < 30)") == QVector<quint32>({1}));
+    CHECK(run("NOT (price > 15 OR rsi < 30)") == QVector<quint32>({}));
+    CHECK(run("NOT (NOT price > 15 AND NOT rsi >= 30)") == QVector<quint32>({2, 3}));
+
+    return TestSupport::finish("test_screener");
+}
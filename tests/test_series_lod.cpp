@@ -0,0 +1,170 @@
+#include "SeriesLod.h"
+#include "TestSupport.h"
+#include <limits>
+
+// extremes() and decimate() against a linear scan while the synced series
+// grows, slides out of a fixed-capacity ring (a few values at a time and
+// more than it holds at once), has its newest value rewritten in place and
+// is reloaded under a new generation.
+
+namespace
+{
+    // A TickStore-like view: the newest `capacity` of everything appended,
+    // copied behind a NaN guard band so reads of evicted values show up
+    struct Ring {
+        QVector<double> all;
+        QVector<double> held;
+        int capacity = 0;
+        quint64 generation = 1;
+
+        TickStore::Series series()
+        {
+            constexpr int Guard = 64;
+            const int size = qMin(capacity, all.size());
+            held = QVector<double>(Guard, std::numeric_limits<double>::quiet_NaN());
+            for (int i = all.size() - size; i < all.size(); ++i)
+                held.append(all[i]);
+
+            TickStore::Series s;
+            s.price = PriceSpan{held.constData() + Guard, size};
+            s.appended = static_cast<quint64>(all.size());
+            s.generation = generation;
+            return s;
+        }
+    };
+
+    bool checkExtremes(const SeriesLod &lod, const PriceSpan &values, int from, int to)
+    {
+        double low = std::numeric_limits<double>::infinity();
+        double high = -std::numeric_limits<double>::infinity();
+        for (int i = from; i < to; ++i) {
+            low = qMin(low, values[i]);
+            high = qMax(high, values[i]);
+        }
+        const SeriesLod::Extremes e = lod.extremes(values, from, to);
+        return e.min == low && e.max == high && e.minAt >= from && e.minAt < to && e.maxAt >= from &&
+               e.maxAt < to && values[e.minAt] == low && values[e.maxAt] == high;
+    }
+
+    bool checkDecimate(const SeriesLod &lod, const PriceSpan &values, int from, int to, int columns)
+    {
+        QVector<int> indices;
+        lod.decimate(values, from, to, columns, &indices);
+        const int n = to - from;
+        if (n <= 2 * columns)
+            return indices.size() == n && indices.first() == from && indices.last() == to - 1;
+
+        // Both ends, strictly increasing, about two points per column
+        if (indices.first() != from || indices.last() != to - 1 || indices.size() > 2 * columns + 6)
+            return false;
+        for (int k = 1; k < indices.size(); ++k) {
+            if (indices[k] <= indices[k - 1])
+                return false;
+        }
+
+        // No column loses its extremes: column bounds snap to blocks by up to
+        // half a column, so each column's min and max are met by a drawn point
+        // at most two columns away
+        auto bound = [&](int c) { return from + static_cast<int>(static_cast<qint64>(n) * qBound(0, c, columns) / columns); };
+        for (int c = 0; c < columns; ++c) {
+            double low = std::numeric_limits<double>::infinity();
+            double high = -std::numeric_limits<double>::infinity();
+            for (int i = bound(c); i < bound(c + 1); ++i) {
+                low = qMin(low, values[i]);
+                high = qMax(high, values[i]);
+            }
+            double drawnLow = std::numeric_limits<double>::infinity();
+            double drawnHigh = -std::numeric_limits<double>::infinity();
+            for (int i : indices) {
+                if (i >= bound(c - 2) && i < bound(c + 3)) {
+                    drawnLow = qMin(drawnLow, values[i]);
+                    drawnHigh = qMax(drawnHigh, values[i]);
+                }
+            }
+            if (drawnLow > low || drawnHigh < high)
+                return false;
+        }
+        return true;
+    }
+
+    void run(quint32 seed, int capacity)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> step(-5, 5);
+        Ring ring;
+        ring.capacity = capacity;
+        SeriesLod lod;
+        double price = 1000.0;
+
+        for (int round = 0; round < 80; ++round) {
+            const char *what = "append";
+            const int op = static_cast<int>(rng() % 10);
+            if (op == 0) {
+                // More than the ring holds at once
+                for (int k = capacity + static_cast<int>(rng() % 500); k > 0; --k)
+                    ring.all.append(price += step(rng));
+                what = "bulk append";
+            } else if (op <= 2 && !ring.all.isEmpty()) {
+                // The newest value rewritten in place, above or below what it was
+                ring.all.last() += (rng() % 2 == 0 ? 1 : -1) * (1 + static_cast<int>(rng() % 40));
+                what = "rewrite";
+            } else if (op == 3 && round % 20 == 19) {
+                ring.all.clear();
+                ++ring.generation;
+                for (int k = 1 + static_cast<int>(rng() % 300); k > 0; --k)
+                    ring.all.append(price += step(rng));
+                what = "reload";
+            } else {
+                for (int k = static_cast<int>(rng() % 200); k > 0; --k)
+                    ring.all.append(price += step(rng));
+            }
+
+            const TickStore::Series series = ring.series();
+            lod.sync(series);
+            const int size = series.size();
+            if (size == 0)
+                continue;
+
+            for (int q = 0; q < 25; ++q) {
+                const int from = static_cast<int>(rng() % size);
+                const int to = from + 1 + static_cast<int>(rng() % (size - from));
+                if (!CHECK(checkExtremes(lod, series.price, from, to))) {
+                    qWarning() << "   seed" << seed << "capacity" << capacity << "round" << round << what
+                               << "extremes over" << from << to;
+                    return;
+                }
+            }
+            if (!CHECK(checkExtremes(lod, series.price, 0, size))) {
+                qWarning() << "   seed" << seed << "capacity" << capacity << "round" << round << what << "whole series";
+                return;
+            }
+
+            for (int columns : {1, 7, 64, 400}) {
+                const int from = static_cast<int>(rng() % size);
+                for (int start : {0, from}) {
+                    if (!CHECK(checkDecimate(lod, series.price, start, size, columns))) {
+                        qWarning() << "   seed" << seed << "capacity" << capacity << "round" << round << what
+                                   << "decimate from" << start << "columns" << columns;
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    for (quint32 seed = 1; seed <= 6; ++seed) {
+        for (int capacity : {1, 15, 16, 17, 100, 1000, 3000, 100000}) {
+            run(seed, capacity);
+        }
+    }
+
+    // An empty range has no extremes
+    SeriesLod lod;
+    const QVector<double> values{3.0, 1.0, 2.0};
+    CHECK(lod.extremes(PriceSpan{values.constData(), values.size()}, 1, 1).minAt == -1);
+
+    return TestSupport::finish("test_series_lod");
+}
@@ -0,0 +1,78 @@
+#include "StreamingRegression.h"
+#include "TestSupport.h"
+#include <cmath>
+
+// Student-t quantiles against table values, and the streaming fit against
+// a direct least-squares fit after slides and in-place rewrites.
+
+namespace
+{
+    bool near(double a, double b, double tolerance)
+    {
+        return std::fabs(a - b) <= tolerance * qMax(1.0, std::fabs(b));
+    }
+
+    StreamingRegression::Fit directFit(const QVector<double> &y)
+    {
+        const int n = y.size();
+        double meanX = (n - 1) / 2.0, meanY = 0.0;
+        for (double v : y) meanY += v;
+        meanY /= n;
+        double sxx = 0.0, sxy = 0.0, syy = 0.0;
+        for (int i = 0; i < n; ++i) {
+            sxx += (i - meanX) * (i - meanX);
+            sxy += (i - meanX) * (y[i] - meanY);
+            syy += (y[i] - meanY) * (y[i] - meanY);
+        }
+        StreamingRegression::Fit fit;
+        fit.n = n;
+        fit.slope = sxy / sxx;
+        fit.intercept = meanY - fit.slope * meanX;
+        const double ssRes = qMax(0.0, syy - fit.slope * sxy);
+        fit.rSquared = syy > 0 ? 1.0 - ssRes / syy : 0.0;
+        fit.residualStdDev = n > 2 ? std::sqrt(ssRes / (n - 2)) : 0.0;
+        return fit;
+    }
+}
+
+int main()
+{
+    struct Quantile { double p; int df; double t; };
+    const Quantile table[] = {
+        {0.975, 1, 12.7062}, {0.975, 2, 4.3027}, {0.975, 3, 3.1824}, {0.975, 4, 2.7764},
+        {0.975, 5, 2.5706}, {0.975, 10, 2.2281}, {0.975, 18, 2.1009}, {0.975, 30, 2.0423},
+        {0.975, 60, 2.0003}, {0.95, 1, 6.3138}, {0.95, 3, 2.3534}, {0.95, 8, 1.8595},
+        {0.995, 2, 9.9248}, {0.995, 5, 4.0321}, {0.025, 3, -3.1824},
+    };
+    for (const Quantile &q : table) {
+        const double t = StreamingRegression::studentQuantile(q.p, q.df);
+        if (!CHECK(near(t, q.t, 5e-5)))
+            qWarning() << "   p" << q.p << "df" << q.df << "got" << t << "expected" << q.t;
+    }
+
+    for (int window : {3, 5, 20, 64}) {
+        StreamingRegression regression(window);
+        const QVector<double> prices = TestSupport::randomWalk(static_cast<quint32>(window), 1000);
+        QVector<double> tail;
+        for (int i = 0; i < prices.size(); ++i) {
+            regression.push(prices[i] * 1.01);
+            regression.replaceLast(prices[i]);
+            tail.append(prices[i]);
+            if (tail.size() > window) tail.removeFirst();
+            if (tail.size() < 3 || i % 37 != 0) continue;
+
+            const StreamingRegression::Fit expected = directFit(tail);
+            const StreamingRegression::Fit fit = regression.fit();
+            const bool same = fit.n == expected.n && near(fit.slope, expected.slope, 1e-6) &&
+                              near(fit.intercept, expected.intercept, 1e-9) &&
+                              std::fabs(fit.rSquared - expected.rSquared) < 1e-6 &&
+                              near(fit.residualStdDev, expected.residualStdDev, 1e-5);
+            if (!CHECK(same)) {
+                qWarning() << "   window" << window << "bar" << i;
+                break;
+            }
+        }
+    }
+
+    return TestSupport::finish("test_streaming_regression");
+}